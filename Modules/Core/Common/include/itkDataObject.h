@@ -544,6 +544,17 @@ public:
   Graft(const DataObject *)
   {}
 
+  /** Return the number of bytes of the bulk data of the requested region,
+   * as allocated when the data object is generated. Used to estimate the
+   * memory footprint of a pipeline update before it is executed. The
+   * default implementation returns zero, as for DataObject's that do not
+   * support Regions. \sa PipelineMemoryPlanner */
+  virtual SizeValueType
+  GetRequestedRegionSizeInBytes() const
+  {
+    return 0;
+  }
+
 protected:
   DataObject();
   ~DataObject() override;
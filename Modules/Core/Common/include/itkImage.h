@@ -328,6 +328,10 @@ public:
   unsigned int
   GetNumberOfComponentsPerPixel() const override;
 
+  /** Return the number of bytes of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedRegionSizeInBytes() const override;
+
   /** Returns (image1 == image2).
    * \note `operator==` and `operator!=` are defined as function templates
    * (rather than as non-templates), just to allow template instantiation of
@@ -144,6 +144,14 @@ Image<TPixel, VImageDimension>::GetNumberOfComponentsPerPixel() const
 }
 
 
+template <typename TPixel, unsigned int VImageDimension>
+auto
+Image<TPixel, VImageDimension>::GetRequestedRegionSizeInBytes() const -> SizeValueType
+{
+  return this->GetRequestedRegion().GetNumberOfPixels() * sizeof(PixelType);
+}
+
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 Image<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -132,6 +132,22 @@ struct ImageAlgorithm
                        const OutputImageType *                     outputImage,
                        const TransformType *                       transform);
 
+  /**
+   * \brief Visits a region of images as spans of pixels that are
+   * contiguous in the buffers of all the images.
+   *
+   * The function is called as function(numberOfPixels, pointers...) for
+   * each span, with the pointers to the first pixel of the span in the
+   * buffer of each image. A span is a line of the region, or several
+   * consecutive lines, planes, etc. when the region extends over the whole
+   * buffered region of all the images in the lower dimensions. The images
+   * must store their pixels in a single array, as itk::Image does, and
+   * buffer the region.
+   */
+  template <typename TRegion, typename TFunction, typename... TImages>
+  static void
+  ForEachContiguousSpan(const TRegion & region, TFunction && function, TImages *... images);
+
 private:
   /** This is an optimized method which requires the input and
    * output images to be the same, and the pixel being POD (Plain Old
@@ -167,6 +167,53 @@ ImageAlgorithm::DispatchedCopy(const InputImageType *                       inIm
 }
 
 
+template <typename TRegion, typename TFunction, typename... TImages>
+void
+ImageAlgorithm::ForEachContiguousSpan(const TRegion & region, TFunction && function, TImages *... images)
+{
+  constexpr unsigned int ImageDimension = TRegion::ImageDimension;
+
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The spans extend over the lower dimensions in which the region is the
+  // whole buffered region of all the images.
+  SizeValueType numberOfPixels = 1;
+  unsigned int  movingDirection = 0;
+  do
+  {
+    numberOfPixels *= region.GetSize(movingDirection);
+    ++movingDirection;
+  } while (movingDirection < ImageDimension &&
+           ((region.GetSize(movingDirection - 1) == images->GetBufferedRegion().GetSize(movingDirection - 1)) && ...));
+
+  typename TRegion::IndexType index = region.GetIndex();
+  for (;;)
+  {
+    function(numberOfPixels, (images->GetBufferPointer() + images->ComputeOffset(index))...);
+
+    // Move to the first index of the next span.
+    unsigned int dimension = movingDirection;
+    for (;;)
+    {
+      if (dimension == ImageDimension)
+      {
+        return;
+      }
+      ++index[dimension];
+      if (static_cast<SizeValueType>(index[dimension] - region.GetIndex(dimension)) < region.GetSize(dimension))
+      {
+        break;
+      }
+      index[dimension] = region.GetIndex(dimension);
+      ++dimension;
+    }
+  }
+}
+
+
 template <typename InputImageType, typename OutputImageType>
 typename OutputImageType::RegionType
 ImageAlgorithm::EnlargeRegionOverBox(const typename InputImageType::RegionType & inputRegion,
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ *
+ * \brief Abstract allocator of the pixel buffers of images.
+ *
+ * An ImportImageContainer allocates its buffer with its allocator, when one
+ * is set with ImportImageContainer::SetAllocator(), or else with the global
+ * default allocator, when one is set with SetGlobalDefaultAllocator(). It
+ * allocates its buffer with new[] when there is no allocator at all, which
+ * is the default. Allocators are only used for element types that are
+ * trivially default constructible and destructible, as they allocate raw
+ * bytes.
+ *
+ * Allocators are called concurrently, by containers allocated in different
+ * threads, so Allocate() and Deallocate() must be thread safe.
+ *
+ * \sa PooledImageBufferAllocator
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageBufferAllocator);
+
+  /** The alignment, in bytes, of the buffers returned by Allocate(). */
+  static constexpr SizeValueType Alignment = 64;
+
+  /** Allocates a buffer of the given number of bytes, aligned on Alignment
+   * bytes. When zeroInitialize is true, all the bytes of the buffer are zero.
+   * Throws a MemoryAllocationError when the buffer cannot be allocated. */
+  virtual void *
+  Allocate(SizeValueType numberOfBytes, bool zeroInitialize) = 0;
+
+  /** Releases a buffer returned by Allocate() for the same number of bytes. */
+  virtual void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) = 0;
+
+  /** Set/Get the allocator used by the containers that have no allocator of
+   * their own. It is null by default, so that buffers are allocated with new[]. */
+  static void
+  SetGlobalDefaultAllocator(ImageBufferAllocator * allocator);
+  static Pointer
+  GetGlobalDefaultAllocator();
+
+protected:
+  ImageBufferAllocator() = default;
+  ~ImageBufferAllocator() override = default;
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
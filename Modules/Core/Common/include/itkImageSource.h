@@ -226,6 +226,39 @@ public:
   ProcessObject::DataObjectPointer
   MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
 
+  /** \brief Support for the fusion of pixel-wise filters.
+   *
+   * A pixel-wise filter may be able to compute any part of its output
+   * directly into a buffer provided by the caller, without allocating its
+   * output image. A downstream filter that has Fusion enabled (see
+   * ImageToImageFilter::SetFusion()) then does not update this source, but
+   * calls UpdateFusedInputs() and asks for the pixels it needs with
+   * GenerateFusedPixels(), one scanline at a time.
+   *
+   * CanGenerateFusedPixels() returns whether this source supports it. The
+   * default implementation returns false. */
+  virtual bool
+  CanGenerateFusedPixels() const
+  {
+    return false;
+  }
+
+  /** Bring up to date the inputs read by GenerateFusedPixels(). Called
+   * instead of updating the output of this source. */
+  virtual void
+  UpdateFusedInputs()
+  {}
+
+  /** Compute the output pixels of the specified region, and write them to
+   * the buffer, in the order in which they would be stored in the output
+   * image. The region must be within the requested region of the output.
+   * May be called concurrently from multiple threads. */
+  virtual void
+  GenerateFusedPixels(const OutputImageRegionType & itkNotUsed(region), OutputImagePixelType * itkNotUsed(buffer))
+  {
+    itkExceptionMacro("GenerateFusedPixels is not supported by " << this->GetNameOfClass());
+  }
+
 protected:
   ImageSource();
   ~ImageSource() override = default;
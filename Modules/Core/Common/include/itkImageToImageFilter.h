@@ -216,6 +216,28 @@ public:
   using ImageToImageFilterCommon::SetGlobalDefaultCoordinateTolerance;
   using ImageToImageFilterCommon::GetGlobalDefaultCoordinateTolerance;
 
+  /** Set/Get whether this filter fuses with the source of its input.
+   *
+   * When Fusion is on, the filter supports it (see SupportsFusedInput()),
+   * and its only input is produced by a pixel-wise filter that can
+   * generate fused pixels (see ImageSource::CanGenerateFusedPixels()),
+   * then that source is not executed and its output image is not
+   * allocated. Instead, its pixels are computed on the fly, one scanline
+   * at a time, while this filter runs. When the source has Fusion on as
+   * well, a whole chain of pixel-wise filters runs as a single pass,
+   * without intermediate images.
+   *
+   * The output of the fused source is not updated, so other consumers of
+   * that output will execute it separately. Off by default. */
+  itkSetMacro(Fusion, bool);
+  itkGetConstMacro(Fusion, bool);
+  itkBooleanMacro(Fusion);
+
+  /** Updates the input, as this filter would before its own execution.
+   * \sa ImageSource::UpdateFusedInputs() */
+  void
+  UpdateFusedInputs() override;
+
 
 protected:
   ImageToImageFilter();
@@ -365,6 +387,30 @@ protected:
   using Superclass::PushBackInput;
   using Superclass::PushFrontInput;
 
+  /** Whether this filter is able to read its input pixels from a fused
+   * source (see SetFusion()). Filters that support it read their input
+   * through GetFusedInputSource() when that is not null, rather than
+   * through the input image buffer. The default implementation returns
+   * false. */
+  virtual bool
+  SupportsFusedInput() const
+  {
+    return false;
+  }
+
+  /** The source whose pixels are computed on the fly during the current
+   * update, or nullptr when the input image is read from its buffer. */
+  ImageSource<TInputImage> *
+  GetFusedInputSource() const
+  {
+    return m_FusedInputSource;
+  }
+
+  /** Fuses with the source of the input when possible, and otherwise
+   * updates the inputs as usual. */
+  void
+  UpdateInputs() override;
+
 private:
   /**
    *  Tolerances for checking whether input images are defined to
@@ -372,6 +418,9 @@ private:
    */
   double m_CoordinateTolerance{};
   double m_DirectionTolerance{};
+
+  bool                       m_Fusion{ false };
+  ImageSource<TInputImage> * m_FusedInputSource{ nullptr };
 };
 } // end namespace itk
 
@@ -140,6 +140,39 @@ ImageToImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
   Superclass::PrintSelf(os, indent);
   os << indent << "CoordinateTolerance: " << this->m_CoordinateTolerance << std::endl;
   os << indent << "DirectionTolerance: " << this->m_DirectionTolerance << std::endl;
+  os << indent << "Fusion: " << (m_Fusion ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+ImageToImageFilter<TInputImage, TOutputImage>::UpdateInputs()
+{
+  m_FusedInputSource = nullptr;
+
+  if (m_Fusion && this->SupportsFusedInput() && this->GetNumberOfInputs() == 1)
+  {
+    const InputImageType * input = this->GetInput();
+    auto *                 source =
+      input ? dynamic_cast<ImageSource<TInputImage> *>(input->GetSource().GetPointer()) : nullptr;
+
+    if (source != nullptr && source->CanGenerateFusedPixels())
+    {
+      m_FusedInputSource = source;
+      source->UpdateFusedInputs();
+      return;
+    }
+  }
+
+  Superclass::UpdateInputs();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+ImageToImageFilter<TInputImage, TOutputImage>::UpdateFusedInputs()
+{
+  this->UpdateInputs();
 }
 
 
@@ -18,7 +18,7 @@
 #ifndef itkImportImageContainer_h
 #define itkImportImageContainer_h
 
-#include "itkObject.h"
+#include "itkImageBufferAllocator.h"
 #include "itkObjectFactory.h"
 #include <utility>
 
@@ -31,6 +31,11 @@ namespace itk
  * conforms to the ImageContainerInterface. This is a full-fledged Object,
  * so there is modification time, debug, and reference count information.
  *
+ * The buffer is allocated by the ImageBufferAllocator of the container, or
+ * else by the global default one, when the element type is trivially
+ * default constructible and destructible. It is allocated with new[]
+ * otherwise, and when there is no allocator.
+ *
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
@@ -159,6 +164,13 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the allocator of the buffers of this container. When it is
+   * null, the default, the global default allocator of ImageBufferAllocator
+   * is used. It applies to the buffers allocated after it is set.
+   * \sa ImageBufferAllocator::SetGlobalDefaultAllocator() */
+  itkSetObjectMacro(Allocator, ImageBufferAllocator);
+  itkGetModifiableObjectMacro(Allocator, ImageBufferAllocator);
+
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -210,6 +222,14 @@ private:
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  ImageBufferAllocator::Pointer m_Allocator{};
+
+  // The allocator of m_ImportPointer, or null when it was allocated by new[].
+  ImageBufferAllocator::Pointer m_BufferAllocator{};
+
+  // The allocator of the elements last returned by AllocateElements().
+  mutable ImageBufferAllocator::Pointer m_AllocatedElementsAllocator{};
 };
 } // end namespace itk
 
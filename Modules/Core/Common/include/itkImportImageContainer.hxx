@@ -29,6 +29,7 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <type_traits>
 
 namespace itk
 {
@@ -53,13 +54,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseValueInitialization);
+      TElement *                          temp = this->AllocateElements(size, UseValueInitialization);
+      const ImageBufferAllocator::Pointer tempAllocator = std::move(m_AllocatedElementsAllocator);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocator = tempAllocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -74,6 +77,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   else
   {
     m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    m_BufferAllocator = std::move(m_AllocatedElementsAllocator);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -94,12 +98,14 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
     if (m_Size < m_Capacity)
     {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      TElement *                          temp = this->AllocateElements(size, false);
+      const ImageBufferAllocator::Pointer tempAllocator = std::move(m_AllocatedElementsAllocator);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocator = tempAllocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -155,6 +161,20 @@ TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
                                                                      bool              UseValueInitialization) const
 {
+  m_AllocatedElementsAllocator = nullptr;
+  if constexpr (std::is_trivially_default_constructible_v<TElement> && std::is_trivially_destructible_v<TElement> &&
+                alignof(TElement) <= ImageBufferAllocator::Alignment)
+  {
+    ImageBufferAllocator::Pointer allocator =
+      m_Allocator ? m_Allocator : ImageBufferAllocator::GetGlobalDefaultAllocator();
+    if (allocator)
+    {
+      auto * const data = static_cast<TElement *>(allocator->Allocate(size * sizeof(TElement), UseValueInitialization));
+      m_AllocatedElementsAllocator = std::move(allocator);
+      return data;
+    }
+  }
+
   TElement * data;
 
   try
@@ -188,8 +208,16 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_BufferAllocator)
+    {
+      m_BufferAllocator->Deallocate(m_ImportPointer, m_Capacity * sizeof(TElement));
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_BufferAllocator = nullptr;
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -205,6 +233,7 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  itkPrintSelfObjectMacro(Allocator);
 }
 } // end namespace itk
 
@@ -55,7 +55,7 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs()
 
   // if told to run in place and the types support it,
   // additionally the buffered and requested regions of the input and
-  // output must match.
+  // output must match. A fused input has no buffer of its own to reuse.
   bool rMatch = true;
   if (inputPtr != nullptr &&
       static_cast<unsigned int>(InputImageDimension) == static_cast<unsigned int>(OutputImageDimension))
@@ -76,7 +76,8 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs()
   {
     rMatch = false;
   }
-  if (inputPtr != nullptr && this->GetInPlace() && this->CanRunInPlace() && rMatch)
+  if (inputPtr != nullptr && this->GetInPlace() && this->CanRunInPlace() && rMatch &&
+      this->GetFusedInputSource() == nullptr)
   {
     // Graft this first input to the output.  Later, we'll need to
     // remove the input's hold on the bulk data.
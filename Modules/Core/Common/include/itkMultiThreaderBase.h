@@ -35,6 +35,7 @@
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
 #include "itkSingletonMacro.h"
+#include "itkPipelineProfiler.h"
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -346,15 +347,18 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
-        ImageRegion<VDimension> region;
-        for (unsigned int d = 0; d < VDimension; ++d)
-        {
-          region.SetIndex(d, index[d]);
-          region.SetSize(d, size[d]);
-        }
-        funcP(region);
-      },
+      PipelineProfiler::ProfileChunks(filter,
+                                      VDimension,
+                                      1,
+                                      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+                                        ImageRegion<VDimension> region;
+                                        for (unsigned int d = 0; d < VDimension; ++d)
+                                        {
+                                          region.SetIndex(d, index[d]);
+                                          region.SetSize(d, size[d]);
+                                        }
+                                        funcP(region);
+                                      }),
       filter);
   }
 
@@ -394,21 +398,25 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
-          ImageRegion<VDimension> restrictedRequestedRegion;
-          restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
-          restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
-          for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
-          {
-            if (dimension != restrictedDirection)
+        PipelineProfiler::ProfileChunks(
+          filter,
+          SplitDimension,
+          requestedRegion.GetSize(restrictedDirection),
+          [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+            ImageRegion<VDimension> restrictedRequestedRegion;
+            restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
+            restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
+            for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
             {
-              restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
-              restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
-              ++splitDimension;
+              if (dimension != restrictedDirection)
+              {
+                restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
+                restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
+                ++splitDimension;
+              }
             }
-          }
-          funcP(restrictedRequestedRegion);
-        },
+            funcP(restrictedRequestedRegion);
+          }),
         filter);
     }
   }
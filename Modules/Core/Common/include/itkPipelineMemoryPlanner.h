@@ -0,0 +1,75 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineMemoryPlanner_h
+#define itkPipelineMemoryPlanner_h
+
+#include "itkDataObject.h"
+#include <functional>
+
+namespace itk
+{
+/** \class PipelineMemoryPlanner
+ *
+ * \brief Estimates the memory of a pipeline update, to stream it within a memory budget.
+ *
+ * The memory footprint of updating a data object is estimated before the
+ * pipeline is executed: its requested region is propagated up the pipeline,
+ * as it is by DataObject::PropagateRequestedRegion(), so that each filter
+ * enlarges the requested regions of its inputs in
+ * GenerateInputRequestedRegion(). The footprint is then the sum of the
+ * requested regions, in bytes, of the outputs of all the filters that are to
+ * be executed, as given by DataObject::GetRequestedRegionSizeInBytes().
+ * Data objects that are up to date are not counted, as their bulk data is
+ * already allocated. The estimate is an upper bound of the memory that the
+ * update allocates, as filters that run in place reuse the buffer of their
+ * input.
+ *
+ * The streaming filters use the estimate to choose their number of stream
+ * divisions, as the smallest one whose pieces are within the memory budget.
+ *
+ * \sa StreamingImageFilter, ImageFileWriter
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineMemoryPlanner
+{
+public:
+  /** Propagates the requested region of the data object up the pipeline, and
+   * returns the estimated number of bytes that updating it allocates. */
+  static SizeValueType
+  EstimateUpdateSizeInBytes(DataObject * data);
+
+  /** Returns the smallest number of divisions, from one to the maximum number
+   * of divisions, for which the estimated size of a piece is within the
+   * memory budget. The estimate for a number of divisions is computed by the
+   * given function, which is called for a few numbers of divisions only, as
+   * the estimate is expected to decrease about in proportion to the number of
+   * divisions. When no number of divisions is within the budget, the one of
+   * the smallest estimate is returned. The estimated size of a piece for the
+   * returned number of divisions is stored in estimatedSizeInBytes. */
+  static unsigned int
+  ComputeNumberOfDivisions(SizeValueType                                     memoryBudget,
+                           unsigned int                                      maximumNumberOfDivisions,
+                           const std::function<SizeValueType(unsigned int)> & estimateSizeInBytes,
+                           SizeValueType &                                   estimatedSizeInBytes);
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineProfiler_h
+#define itkPipelineProfiler_h
+
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+#include "ITKCommonExport.h"
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+struct PipelineProfilerGlobals;
+class ProcessObject;
+
+/** \class PipelineProfiler
+ *
+ * \brief Records the execution of the filters of all pipelines, and exports it as a Chrome trace.
+ *
+ * Unlike TimeProbesCollectorBase and MemoryProbesCollectorBase, whose probes
+ * are placed by hand around the code to measure, the profiler is a global
+ * opt-in: once it is enabled, each execution of GenerateData() by
+ * ProcessObject::UpdateOutputData() is recorded as a filter event, with its
+ * wall time and the bytes of the requested regions of its outputs, and each
+ * chunk of a region processed by MultiThreaderBase::ParallelizeImageRegion()
+ * is recorded as a chunk event, with the thread that processed it and its
+ * number of pixels.
+ *
+ * The events are exported by WriteChromeTrace() in the trace event format
+ * of Chrome, to be viewed in chrome://tracing or https://ui.perfetto.dev,
+ * which shows which filters dominate a pipeline, and how evenly the chunks
+ * of a filter are balanced among the threads. Report() prints a summary of
+ * the filter events.
+ *
+ \code
+ itk::PipelineProfiler::SetEnabled(true);
+ writer->Update();
+ itk::PipelineProfiler::WriteChromeTrace("pipeline.json");
+ \endcode
+ *
+ * When the profiler is disabled, which is the default, the overhead is that
+ * of checking an atomic flag per filter execution and per parallelized region.
+ *
+ * \sa TimeProbesCollectorBase, MemoryProbesCollectorBase
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineProfiler
+{
+public:
+  /** An interval of the execution of a filter, or of a chunk of a region
+   * processed by one of its threads. The times are in microseconds, from
+   * when the profiler was enabled or cleared. */
+  struct Event
+  {
+    std::string   Name;
+    std::string   Category;
+    double        StartTime;
+    double        Duration;
+    unsigned int  ThreadIndex;
+    SizeValueType NumberOfPixels;
+    SizeValueType NumberOfBytes;
+  };
+
+  using ThreadingFunctorType = std::function<void(const IndexValueType index[], const SizeValueType size[])>;
+
+  /** Set/Get whether the executions of the filters are recorded. Enabling the
+   * profiler clears the events recorded before. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  static void
+  EnabledOn()
+  {
+    SetEnabled(true);
+  }
+  static void
+  EnabledOff()
+  {
+    SetEnabled(false);
+  }
+
+  /** Discards the events recorded so far. */
+  static void
+  Clear();
+
+  /** Returns the events recorded so far, in the order in which they ended. */
+  static std::vector<Event>
+  GetEvents();
+
+  /** Writes the events in the JSON trace event format of Chrome. Throws an
+   * ExceptionObject when the file cannot be written. */
+  static void
+  WriteChromeTrace(std::ostream & os);
+  static void
+  WriteChromeTrace(const std::string & fileName);
+
+  /** Prints the number of executions, the total and mean wall time, and the
+   * total bytes of the outputs of each filter. */
+  static void
+  Report(std::ostream & os = std::cout);
+
+  /** Records the execution of a filter from its construction to its
+   * destruction, when the profiler is enabled. Used by ProcessObject. */
+  class ITKCommon_EXPORT FilterScope
+  {
+  public:
+    explicit FilterScope(ProcessObject * filter);
+    ~FilterScope();
+
+    FilterScope(const FilterScope &) = delete;
+    FilterScope &
+    operator=(const FilterScope &) = delete;
+
+  private:
+    ProcessObject * m_Filter;
+    double          m_StartTime{ -1.0 };
+  };
+
+  /** Returns the function, which records each call to it as a chunk of the
+   * filter, when the profiler is enabled. Used by MultiThreaderBase. */
+  static ThreadingFunctorType
+  ProfileChunks(const ProcessObject * filter,
+                unsigned int          dimension,
+                SizeValueType         numberOfPixelsPerIndex,
+                ThreadingFunctorType  funcP);
+
+private:
+  static void
+  RecordEvent(Event event);
+
+  static double
+  GetTime();
+
+  itkGetGlobalDeclarationMacro(PipelineProfilerGlobals, PimplGlobals);
+  static PipelineProfilerGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
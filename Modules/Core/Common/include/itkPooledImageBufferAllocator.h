@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPooledImageBufferAllocator_h
+#define itkPooledImageBufferAllocator_h
+
+#include "itkImageBufferAllocator.h"
+#include "itkObjectFactory.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class PooledImageBufferAllocator
+ *
+ * \brief Image buffer allocator that keeps released buffers for reuse.
+ *
+ * Iterative pipelines, such as the levels of a registration, the iterations
+ * of a level set, or a batch of cases, allocate and release buffers of the
+ * same sizes over and over. Each fresh buffer costs the page faults of its
+ * first touch, and the zeroing of its pages by the system. This allocator
+ * keeps the released buffers in a pool, and hands them out again to the
+ * allocations of the same size, so that their pages are already mapped.
+ *
+ * The sizes are rounded up to buckets: to whole pages for small buffers,
+ * and to one of eight sizes per power of two above, so that a bucket wastes
+ * less than an eighth of its buffer. Buffers of the same bucket are
+ * interchangeable. The pool keeps at most MaximumPooledSizeInBytes bytes of
+ * released buffers; the buffers released beyond that are freed. When an
+ * allocation fails, the pool is freed before trying again.
+ *
+ * When UseHugePages is on (the default), the buffers of at least
+ * HugePageSize bytes are aligned on huge pages, and advised to be backed by
+ * transparent huge pages (MADV_HUGEPAGE), on Linux, to reduce the number of
+ * page faults and TLB misses.
+ *
+ * When UseParallelFirstTouch is on, the pages of fresh buffers are touched,
+ * and zero-initialized buffers are zeroed, in parallel by the threads of a
+ * MultiThreaderBase, each touching a contiguous part of the buffer. As the
+ * system places a page on the NUMA node of the thread that first touches
+ * it, the buffer is then spread over the nodes as the image is split over
+ * the threads by the filters. It is off by default.
+ *
+ * The statistics of the allocator tell how many allocations reused a pooled
+ * buffer, to tune MaximumPooledSizeInBytes.
+ *
+ * \code
+ * auto allocator = itk::PooledImageBufferAllocator::New();
+ * itk::ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+ * \endcode
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PooledImageBufferAllocator : public ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PooledImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = PooledImageBufferAllocator;
+  using Superclass = ImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PooledImageBufferAllocator);
+
+  /** The size of the huge pages of the buffers, when UseHugePages is on. */
+  static constexpr SizeValueType HugePageSize = SizeValueType{ 1 } << 21;
+
+  void *
+  Allocate(SizeValueType numberOfBytes, bool zeroInitialize) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+  /** Returns the size of the bucket of the buffers of the given number of bytes. */
+  static SizeValueType
+  ComputeBucketSize(SizeValueType numberOfBytes);
+
+  /** Set/Get the maximum number of bytes of the released buffers kept in
+   * the pool. Defaults to 1 GiB. */
+  itkSetMacro(MaximumPooledSizeInBytes, SizeValueType);
+  itkGetConstMacro(MaximumPooledSizeInBytes, SizeValueType);
+
+  /** Set/Get whether large buffers are backed by huge pages. On by default. */
+  itkSetMacro(UseHugePages, bool);
+  itkGetConstMacro(UseHugePages, bool);
+  itkBooleanMacro(UseHugePages);
+
+  /** Set/Get whether the pages of the buffers are first touched in parallel.
+   * Off by default. */
+  itkSetMacro(UseParallelFirstTouch, bool);
+  itkGetConstMacro(UseParallelFirstTouch, bool);
+  itkBooleanMacro(UseParallelFirstTouch);
+
+  /** Frees the released buffers kept in the pool. */
+  void
+  ReleasePooledBuffers();
+
+  /** The number of allocations, and the number of them that reused a buffer
+   * of the pool, since the allocator was created or its statistics reset. */
+  SizeValueType
+  GetNumberOfAllocations() const;
+  SizeValueType
+  GetNumberOfReusedAllocations() const;
+
+  /** The fraction of the allocations that reused a buffer of the pool. */
+  double
+  GetReuseRate() const;
+
+  /** The number of bytes of the released buffers kept in the pool. */
+  SizeValueType
+  GetPooledSizeInBytes() const;
+
+  /** The number of bytes of the buffers allocated and not yet released. */
+  SizeValueType
+  GetAllocatedSizeInBytes() const;
+
+  /** Resets the number of allocations and reused allocations. */
+  void
+  ResetStatistics();
+
+protected:
+  PooledImageBufferAllocator() = default;
+  ~PooledImageBufferAllocator() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  SizeValueType m_MaximumPooledSizeInBytes{ SizeValueType{ 1 } << 30 };
+  bool          m_UseHugePages{ true };
+  bool          m_UseParallelFirstTouch{ false };
+
+  mutable std::mutex                           m_Mutex{};
+  std::map<SizeValueType, std::vector<void *>> m_PooledBuffers{};
+  SizeValueType                                m_PooledSizeInBytes{ 0 };
+  SizeValueType                                m_AllocatedSizeInBytes{ 0 };
+  SizeValueType                                m_NumberOfAllocations{ 0 };
+  SizeValueType                                m_NumberOfReusedAllocations{ 0 };
+};
+} // end namespace itk
+
+#endif
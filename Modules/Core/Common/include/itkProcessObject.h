@@ -840,6 +840,16 @@ protected:
   virtual void
   GenerateOutputInformation();
 
+  /** Bring the inputs up to date before GenerateData() is called. This
+   * method is called by UpdateOutputData(). The default implementation
+   * calls UpdateOutputData() on each input. A filter that computes its
+   * input on the fly, instead of reading it from the input's buffer, may
+   * override this method.
+   *
+   * \sa ImageToImageFilter::SetFusion() */
+  virtual void
+  UpdateInputs();
+
   /** This method causes the filter to generate its output. */
   virtual void
   GenerateData()
@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSpanFunctorTraits_h
+#define itkSpanFunctorTraits_h
+
+#include "itkImage.h"
+#include <tuple>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class HasEvaluateSpan
+ *
+ * \brief Tells whether a pixel-wise functor also evaluates spans of pixels.
+ *
+ * A functor of N inputs evaluates spans of contiguous pixels when it has a
+ * member function
+ * \code
+ * void EvaluateSpan(const TInput1 * input1, ..., const TInputN * inputN,
+ *                   TOutput * output, SizeValueType numberOfPixels) const;
+ * \endcode
+ * which sets output[i] to the result of operator() on input1[i], ...,
+ * inputN[i]. The output may be one of the inputs, when a filter runs in
+ * place. A simple loop over the indices, free of the bookkeeping of the
+ * image iterators, lets the compiler vectorize the operation.
+ *
+ * The functor filters (UnaryFunctorImageFilter, BinaryGeneratorImageFilter
+ * and TernaryFunctorImageFilter) call EvaluateSpan() instead of operator()
+ * when the functor has it and the images are itk::Image.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TFunctor, typename TOutput, typename TInputTuple, typename = void>
+struct HasEvaluateSpan : std::false_type
+{};
+
+/// \cond HIDE_SPECIALIZATION_DOCUMENTATION
+template <typename TFunctor, typename TOutput, typename... TInputs>
+struct HasEvaluateSpan<TFunctor,
+                       TOutput,
+                       std::tuple<TInputs...>,
+                       std::void_t<decltype(std::declval<const TFunctor &>().EvaluateSpan(
+                         std::declval<const TInputs *>()...,
+                         std::declval<TOutput *>(),
+                         SizeValueType{}))>> : std::true_type
+{};
+/// \endcond
+} // end namespace Functor
+
+/** Tells whether the image type stores its pixels as a single array of its
+ * pixel type, as itk::Image does, so that spans of its pixels are arrays. */
+template <typename TImage>
+constexpr bool IsContiguousPixelImage =
+  std::is_same_v<TImage, Image<typename TImage::PixelType, TImage::ImageDimension>>;
+
+/** Tells whether the functor filters may evaluate the functor on spans of
+ * pixels of the output image and input images. */
+template <typename TFunctor, typename TOutputImage, typename... TInputImages>
+constexpr bool CanEvaluateFunctorOnSpans =
+  Functor::HasEvaluateSpan<TFunctor,
+                           typename TOutputImage::PixelType,
+                           std::tuple<typename TInputImages::PixelType...>>::value &&
+  IsContiguousPixelImage<TOutputImage> && (IsContiguousPixelImage<TInputImages> && ...) &&
+  ((TInputImages::ImageDimension == TOutputImage::ImageDimension) && ...);
+} // end namespace itk
+
+#endif
@@ -270,6 +270,10 @@ public:
   void
   SetPixelContainer(PixelContainer * container);
 
+  /** Return the number of bytes of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedRegionSizeInBytes() const override;
+
   /** Return the Pixel Accessor object */
   AccessorType
   GetPixelAccessor()
@@ -85,6 +85,13 @@ SpecialCoordinatesImage<TPixel, VImageDimension>::SetPixelContainer(PixelContain
   }
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+auto
+SpecialCoordinatesImage<TPixel, VImageDimension>::GetRequestedRegionSizeInBytes() const -> SizeValueType
+{
+  return this->GetRequestedRegion().GetNumberOfPixels() * sizeof(PixelType);
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 SpecialCoordinatesImage<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -36,6 +36,16 @@ namespace itk
  * This filter will produce the entire output as one image, but the upstream
  * filters will do their processing in pieces.
  *
+ * Alternatively, a memory budget may be set, for the number of pieces to be
+ * chosen automatically: the memory that the upstream pipeline allocates to
+ * generate a piece is estimated by PipelineMemoryPlanner, from the input
+ * requested regions of the filters, and the output is divided into the
+ * smallest number of pieces that keeps the estimate within the budget. When
+ * the region splitter cannot divide the output finely enough, an
+ * ImageRegionSplitterMultidimensional is used instead.
+ *
+ * \sa PipelineMemoryPlanner
+ *
  * \ingroup ITKSystemObjects
  * \ingroup DataProcessing
  * \ingroup ITKCommon
@@ -86,6 +96,13 @@ public:
    * will be executed this many times. */
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum number of bytes that the upstream pipeline is to
+   * allocate to generate a piece of the output. When it is not zero, the
+   * number of pieces is chosen to stay within it, and NumberOfStreamDivisions
+   * is ignored. The output image itself is not included. Defaults to zero. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
   /** Get/Set the helper class for dividing the input into chunks. */
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
@@ -115,8 +132,16 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Returns the number of pieces within the memory budget, and the splitter
+   * with which to divide the output region into them. */
+  unsigned int
+  PlanNumberOfStreamDivisions(InputImageType *              inputPtr,
+                              const OutputImageRegionType & outputRegion,
+                              RegionSplitterPointer &       regionSplitter);
+
   unsigned int          m_NumberOfStreamDivisions{};
   RegionSplitterPointer m_RegionSplitter{};
+  SizeValueType         m_MemoryBudget{ 0 };
 };
 } // end namespace itk
 
@@ -20,6 +20,10 @@
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkPipelineMemoryPlanner.h"
+
+#include <limits>
 
 namespace itk
 {
@@ -46,6 +50,7 @@ StreamingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
 
   itkPrintSelfObjectMacro(RegionSplitter);
 }
@@ -148,12 +153,17 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
 
   /**
    * Determine of number of pieces to divide the input.  This will be the
-   * minimum of what the user specified via SetNumberOfStreamDivisions()
-   * and what the Splitter thinks is a reasonable value.
+   * minimum of what the user specified via SetNumberOfStreamDivisions(),
+   * or what keeps the pipeline within the memory budget, and what the
+   * Splitter thinks is a reasonable value.
    */
-  unsigned int       numDivisions = m_NumberOfStreamDivisions;
-  const unsigned int numDivisionsFromSplitter =
-    m_RegionSplitter->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+  RegionSplitterPointer regionSplitter = m_RegionSplitter;
+  unsigned int          numDivisions = m_NumberOfStreamDivisions;
+  if (m_MemoryBudget > 0)
+  {
+    numDivisions = this->PlanNumberOfStreamDivisions(inputPtr, outputRegion, regionSplitter);
+  }
+  const unsigned int numDivisionsFromSplitter = regionSplitter->GetNumberOfSplits(outputRegion, numDivisions);
   if (numDivisionsFromSplitter < numDivisions)
   {
     numDivisions = numDivisionsFromSplitter;
@@ -167,7 +177,7 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
   for (; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
     InputImageRegionType streamRegion = outputRegion;
-    m_RegionSplitter->GetSplit(piece, numDivisions, streamRegion);
+    regionSplitter->GetSplit(piece, numDivisions, streamRegion);
 
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
@@ -214,6 +224,70 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
   // Mark that we are no longer updating the data in this filter
   this->m_Updating = false;
 }
+
+/**
+ *
+ */
+template <typename TInputImage, typename TOutputImage>
+unsigned int
+StreamingImageFilter<TInputImage, TOutputImage>::PlanNumberOfStreamDivisions(InputImageType *              inputPtr,
+                                                                             const OutputImageRegionType & outputRegion,
+                                                                             RegionSplitterPointer & regionSplitter)
+{
+  // The largest number of pieces to consider, which keeps the splitters'
+  // arithmetic within the range of unsigned int.
+  const auto numberOfPixels = static_cast<unsigned int>(std::min<SizeValueType>(
+    outputRegion.GetNumberOfPixels(), std::numeric_limits<unsigned int>::max() / 2));
+
+  const auto plan = [this, inputPtr, &outputRegion, numberOfPixels](const SplitterType * splitter,
+                                                                    SizeValueType &      estimatedSizeInBytes) {
+    // The size of the largest piece is estimated.
+    const auto estimateSizeInBytes = [inputPtr, &outputRegion, splitter](unsigned int numberOfDivisions) {
+      InputImageRegionType largestStreamRegion;
+      numberOfDivisions = splitter->GetNumberOfSplits(outputRegion, numberOfDivisions);
+      for (unsigned int piece = 0; piece < numberOfDivisions; ++piece)
+      {
+        InputImageRegionType streamRegion = outputRegion;
+        splitter->GetSplit(piece, numberOfDivisions, streamRegion);
+        if (streamRegion.GetNumberOfPixels() > largestStreamRegion.GetNumberOfPixels())
+        {
+          largestStreamRegion = streamRegion;
+        }
+      }
+      inputPtr->SetRequestedRegion(largestStreamRegion);
+      return PipelineMemoryPlanner::EstimateUpdateSizeInBytes(inputPtr);
+    };
+    return PipelineMemoryPlanner::ComputeNumberOfDivisions(m_MemoryBudget,
+                                                           splitter->GetNumberOfSplits(outputRegion, numberOfPixels),
+                                                           estimateSizeInBytes,
+                                                           estimatedSizeInBytes);
+  };
+
+  SizeValueType estimatedSizeInBytes = 0;
+  unsigned int  numDivisions = plan(regionSplitter, estimatedSizeInBytes);
+  if (estimatedSizeInBytes > m_MemoryBudget)
+  {
+    // The splitter may not divide the region finely enough, as when the
+    // slowest dimension is exhausted, so try splitting along all dimensions.
+    RegionSplitterPointer multidimensionalSplitter = ImageRegionSplitterMultidimensional::New().GetPointer();
+    SizeValueType         multidimensionalSizeInBytes = 0;
+    const unsigned int    multidimensionalDivisions = plan(multidimensionalSplitter, multidimensionalSizeInBytes);
+    if (multidimensionalSizeInBytes < estimatedSizeInBytes)
+    {
+      regionSplitter = multidimensionalSplitter;
+      numDivisions = multidimensionalDivisions;
+      estimatedSizeInBytes = multidimensionalSizeInBytes;
+    }
+  }
+  if (estimatedSizeInBytes > m_MemoryBudget)
+  {
+    itkWarningMacro("The upstream pipeline is estimated to allocate " << estimatedSizeInBytes
+                                                                      << " bytes per piece, over the memory budget of "
+                                                                      << m_MemoryBudget << " bytes.");
+  }
+  itkDebugMacro("Streaming in " << numDivisions << " pieces of an estimated " << estimatedSizeInBytes << " bytes.");
+  return numDivisions;
+}
 } // end namespace itk
 
 #endif
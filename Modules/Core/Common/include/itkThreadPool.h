@@ -21,8 +21,10 @@
 #include "itkConfigure.h"
 #include "itkIntTypes.h"
 
+#include <atomic>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <future>
 #include <condition_variable>
 #include <thread>
@@ -43,6 +45,13 @@ namespace itk
  * Initially the thread pool is started with GlobalDefaultNumberOfThreads.
  * The jobs are submitted via AddWork method.
  *
+ * By default all jobs go through one queue shared by every thread. When
+ * work stealing is enabled (see SetUseWorkStealing), each pool thread owns
+ * a queue instead: jobs submitted from outside the pool are distributed
+ * round-robin over these queues, jobs submitted from a pool thread go to
+ * that thread's own queue, and idle threads steal from the others. This
+ * avoids contention on a single lock when many small jobs are submitted.
+ *
  * This implementation heavily borrows from:
  * https://github.com/progschj/ThreadPool
  *
@@ -92,14 +101,17 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
       [function, arguments...]() -> return_type { return function(arguments...); });
 
     std::future<return_type> res = task->get_future();
-    {
-      const std::lock_guard<std::mutex> lockGuard(this->GetMutex());
-      m_WorkQueue.emplace_back([task]() { (*task)(); });
-    }
-    m_Condition.notify_one();
+    this->PushTask([task]() { (*task)(); });
     return res;
   }
 
+  /** Execute one queued job on the calling thread, if there is any.
+   * Returns false when no job was available. A thread waiting for the
+   * completion of jobs can use this to make progress instead of blocking,
+   * which keeps nested parallelism from deadlocking the pool. */
+  bool
+  RunPendingTask();
+
   /** Can call this method if we want to add extra threads to the pool. */
   void
   AddThreads(ThreadIdType count);
@@ -124,6 +136,13 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
   static void
   SetDoNotWaitForThreads(bool doNotWaitForThreads);
 
+  /** Set/Get whether jobs are scheduled on per-thread queues with work
+   * stealing, instead of one shared queue. Off by default. */
+  static bool
+  GetUseWorkStealing();
+  static void
+  SetUseWorkStealing(bool useWorkStealing);
+
 protected:
   /** We need access to the mutex in AddWork, and the variable is only
    * visible in the .cxx file, so this method returns it. */
@@ -132,6 +151,15 @@ protected:
 
   ThreadPool();
 
+  /** Queue a job, either on the shared queue or on a per-thread queue. */
+  void
+  PushTask(std::function<void()> && task);
+
+  /** Take a job from the calling thread's own queue, or steal one from
+   * another thread's queue. Does not look at the shared queue. */
+  bool
+  PopOrStealTask(std::function<void()> & task);
+
   /** Stop the pool and release threads. To be called by the destructor and atfork. */
   void
   CleanUp();
@@ -156,6 +184,30 @@ private:
    * AddWork signals it to resume a (random) thread. */
   std::condition_variable m_Condition;
 
+  /** A job queue owned by one pool thread, used with work stealing. */
+  struct WorkerQueue
+  {
+    std::mutex                        m_Mutex;
+    std::deque<std::function<void()>> m_Tasks; // guarded by m_Mutex
+  };
+
+  /** One queue per pool thread (ITK_MAX_THREADS of them, allocated once so
+   * that adding threads never moves a queue another thread is using). */
+  std::unique_ptr<WorkerQueue[]> m_WorkerQueues;
+
+  /** Number of jobs held in m_WorkerQueues. Signed, because a job may be
+   * popped before its submitter has counted it. */
+  std::atomic<std::ptrdiff_t> m_NumberOfQueuedWorkerTasks{ 0 };
+
+  /** Number of threads waiting on m_Condition. */
+  std::atomic<int> m_NumberOfSleepingThreads{ 0 };
+
+  /** Number of pool threads, readable without locking the mutex. */
+  std::atomic<ThreadIdType> m_NumberOfWorkers{ 0 };
+
+  /** Round-robin counter used to pick the queue for external submissions. */
+  std::atomic<ThreadIdType> m_NextWorkerQueue{ 0 };
+
   /** Vector to hold all thread handles.
    * Thread handles are used to delete (join) the threads. */
   std::vector<std::thread> m_Threads; // guarded by m_PimplGlobals->m_Mutex
@@ -168,7 +220,7 @@ private:
 
   /** The continuously running thread function */
   static void
-  ThreadExecute();
+  ThreadExecute(ThreadIdType workerIndex);
 };
 
 } // namespace itk
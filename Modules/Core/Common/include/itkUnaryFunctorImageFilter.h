@@ -36,6 +36,11 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When the functor has an EvaluateSpan() member function (see
+ * Functor::HasEvaluateSpan), and the input and output are itk::Image of
+ * the same dimension, the functor is evaluated on spans of contiguous
+ * pixels rather than pixel by pixel, which the compiler may vectorize.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
  *
@@ -108,6 +113,14 @@ public:
     }
   }
 
+  /** UnaryFunctorImageFilter can compute its output pixels on the fly for a
+   * downstream filter, when its input and output have the same dimension.
+   * \sa ImageToImageFilter::SetFusion() */
+  bool
+  CanGenerateFusedPixels() const override;
+  void
+  GenerateFusedPixels(const OutputImageRegionType & region, OutputImagePixelType * buffer) override;
+
 protected:
   UnaryFunctorImageFilter();
   ~UnaryFunctorImageFilter() override = default;
@@ -136,6 +149,15 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** The input may be computed on the fly by a fused source, when the input
+   * and output have the same dimension. */
+  bool
+  SupportsFusedInput() const override
+  {
+    return static_cast<unsigned int>(Superclass::InputImageDimension) ==
+           static_cast<unsigned int>(Superclass::OutputImageDimension);
+  }
+
 private:
   FunctorType m_Functor{};
 };
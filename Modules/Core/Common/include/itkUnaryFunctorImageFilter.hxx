@@ -18,8 +18,11 @@
 #ifndef itkUnaryFunctorImageFilter_hxx
 #define itkUnaryFunctorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
+#include "itkSpanFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
+#include <vector>
 
 namespace itk
 {
@@ -86,6 +89,57 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (ImageSource<TInputImage> * fusedSource = this->GetFusedInputSource())
+  {
+    // The input pixels are computed on the fly, one scanline at a time.
+    std::vector<InputImagePixelType> inputLine(outputRegionForThread.GetSize(0));
+    ImageScanlineIterator            outputIt(outputPtr, outputRegionForThread);
+    auto                             lineSize = OutputImageRegionType::SizeType::Filled(1);
+    lineSize[0] = outputRegionForThread.GetSize(0);
+
+    while (!outputIt.IsAtEnd())
+    {
+      InputImageRegionType inputLineRegion;
+      this->CallCopyOutputRegionToInputRegion(inputLineRegion, OutputImageRegionType(outputIt.GetIndex(), lineSize));
+      fusedSource->GenerateFusedPixels(inputLineRegion, inputLine.data());
+
+      if constexpr (Functor::HasEvaluateSpan<FunctorType, OutputImagePixelType, std::tuple<InputImagePixelType>>::value &&
+                    IsContiguousPixelImage<TOutputImage>)
+      {
+        m_Functor.EvaluateSpan(inputLine.data(),
+                               outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(outputIt.GetIndex()),
+                               lineSize[0]);
+      }
+      else
+      {
+        for (const InputImagePixelType & inputPixel : inputLine)
+        {
+          outputIt.Set(m_Functor(inputPixel));
+          ++outputIt;
+        }
+      }
+      outputIt.NextLine();
+      progress.Completed(outputRegionForThread.GetSize()[0]);
+    }
+    return;
+  }
+
+  if constexpr (CanEvaluateFunctorOnSpans<FunctorType, TOutputImage, TInputImage>)
+  {
+    if (inputRegionForThread == outputRegionForThread)
+    {
+      ImageAlgorithm::ForEachContiguousSpan(
+        outputRegionForThread,
+        [this, &progress](SizeValueType numberOfPixels, const InputImagePixelType * input, OutputImagePixelType * output) {
+          m_Functor.EvaluateSpan(input, output, numberOfPixels);
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr,
+        outputPtr);
+      return;
+    }
+  }
+
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
@@ -102,6 +156,67 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+bool
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::CanGenerateFusedPixels() const
+{
+  return this->SupportsFusedInput() && this->GetNumberOfInputs() == 1 && this->GetInput() != nullptr;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateFusedPixels(
+  const OutputImageRegionType & region,
+  OutputImagePixelType *        buffer)
+{
+  InputImageRegionType inputRegion;
+  this->CallCopyOutputRegionToInputRegion(inputRegion, region);
+
+  if (ImageSource<TInputImage> * fusedSource = this->GetFusedInputSource())
+  {
+    std::vector<InputImagePixelType> inputPixels(inputRegion.GetNumberOfPixels());
+    fusedSource->GenerateFusedPixels(inputRegion, inputPixels.data());
+    if constexpr (Functor::HasEvaluateSpan<FunctorType, OutputImagePixelType, std::tuple<InputImagePixelType>>::value)
+    {
+      m_Functor.EvaluateSpan(inputPixels.data(), buffer, inputPixels.size());
+    }
+    else
+    {
+      for (const InputImagePixelType & inputPixel : inputPixels)
+      {
+        *buffer++ = m_Functor(inputPixel);
+      }
+    }
+    return;
+  }
+
+  if constexpr (Functor::HasEvaluateSpan<FunctorType, OutputImagePixelType, std::tuple<InputImagePixelType>>::value &&
+                IsContiguousPixelImage<TInputImage>)
+  {
+    ImageAlgorithm::ForEachContiguousSpan(
+      inputRegion,
+      [this, &buffer](SizeValueType numberOfPixels, const InputImagePixelType * input) {
+        m_Functor.EvaluateSpan(input, buffer, numberOfPixels);
+        buffer += numberOfPixels;
+      },
+      this->GetInput());
+    return;
+  }
+
+  ImageScanlineConstIterator inputIt(this->GetInput(), inputRegion);
+  while (!inputIt.IsAtEnd())
+  {
+    while (!inputIt.IsAtEndOfLine())
+    {
+      *buffer++ = m_Functor(inputIt.Get());
+      ++inputIt;
+    }
+    inputIt.NextLine();
+  }
+}
 } // end namespace itk
 
 #endif
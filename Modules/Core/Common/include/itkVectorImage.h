@@ -374,6 +374,10 @@ public:
   void
   SetNumberOfComponentsPerPixel(unsigned int n) override;
 
+  /** Return the number of bytes of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedRegionSizeInBytes() const override;
+
 protected:
   VectorImage() = default;
   void
@@ -151,6 +151,14 @@ VectorImage<TPixel, VImageDimension>::SetNumberOfComponentsPerPixel(unsigned int
   this->SetVectorLength(static_cast<VectorLengthType>(n));
 }
 
+//----------------------------------------------------------------------------
+template <typename TPixel, unsigned int VImageDimension>
+auto
+VectorImage<TPixel, VImageDimension>::GetRequestedRegionSizeInBytes() const -> SizeValueType
+{
+  return this->GetRequestedRegion().GetNumberOfPixels() * m_VectorLength * sizeof(InternalPixelType);
+}
+
 /**
  *
  */
@@ -0,0 +1,55 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include <mutex>
+
+namespace itk
+{
+struct ImageBufferAllocatorGlobals
+{
+  ImageBufferAllocatorGlobals() = default;
+
+  std::mutex                    m_Mutex;
+  ImageBufferAllocator::Pointer m_DefaultAllocator;
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+
+void
+ImageBufferAllocator::SetGlobalDefaultAllocator(ImageBufferAllocator * allocator)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_DefaultAllocator = allocator;
+}
+
+
+auto
+ImageBufferAllocator::GetGlobalDefaultAllocator() -> Pointer
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_DefaultAllocator;
+}
+
+} // end namespace itk
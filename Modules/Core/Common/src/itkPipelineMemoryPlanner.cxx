@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineMemoryPlanner.h"
+#include "itkProcessObject.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+
+namespace itk
+{
+namespace
+{
+// Whether the source of the data object is to be executed to update it, as
+// decided by DataObject::PropagateRequestedRegion().
+bool
+IsToBeGenerated(DataObject & data)
+{
+  return data.GetUpdateMTime() < data.GetPipelineMTime() || data.GetDataReleased() ||
+         data.RequestedRegionIsOutsideOfTheBufferedRegion();
+}
+} // namespace
+
+
+SizeValueType
+PipelineMemoryPlanner::EstimateUpdateSizeInBytes(DataObject * data)
+{
+  data->PropagateRequestedRegion();
+
+  SizeValueType                       sizeInBytes = 0;
+  std::unordered_set<ProcessObject *> visitedSources;
+  std::vector<DataObject *>           dataToVisit{ data };
+  while (!dataToVisit.empty())
+  {
+    DataObject * const current = dataToVisit.back();
+    dataToVisit.pop_back();
+
+    ProcessObject * const source = current->GetSource();
+    if (source == nullptr || !IsToBeGenerated(*current) || !visitedSources.insert(source).second)
+    {
+      continue;
+    }
+    // The source allocates all of its outputs when it is executed.
+    for (const auto & output : source->GetOutputs())
+    {
+      if (output)
+      {
+        sizeInBytes += output->GetRequestedRegionSizeInBytes();
+      }
+    }
+    for (const auto & input : source->GetInputs())
+    {
+      if (input)
+      {
+        dataToVisit.push_back(input);
+      }
+    }
+  }
+  return sizeInBytes;
+}
+
+
+unsigned int
+PipelineMemoryPlanner::ComputeNumberOfDivisions(SizeValueType                                      memoryBudget,
+                                                unsigned int                                       maximumNumberOfDivisions,
+                                                const std::function<SizeValueType(unsigned int)> & estimateSizeInBytes,
+                                                SizeValueType &                                    estimatedSizeInBytes)
+{
+  memoryBudget = std::max<SizeValueType>(memoryBudget, 1);
+  maximumNumberOfDivisions = std::max(maximumNumberOfDivisions, 1u);
+
+  unsigned int  numberOfDivisions = 1;
+  SizeValueType sizeInBytes = estimateSizeInBytes(numberOfDivisions);
+  unsigned int  smallestNumberOfDivisions = numberOfDivisions;
+  SizeValueType smallestSizeInBytes = sizeInBytes;
+  unsigned int  largestNumberOfDivisionsOverBudget = 0;
+  while (sizeInBytes > memoryBudget && numberOfDivisions < maximumNumberOfDivisions)
+  {
+    largestNumberOfDivisionsOverBudget = numberOfDivisions;
+    // Guess the number of divisions by which the pieces fit, assuming that
+    // the size of a piece is inversely proportional to the number of divisions.
+    const double guess =
+      std::ceil(numberOfDivisions * (static_cast<double>(sizeInBytes) / static_cast<double>(memoryBudget)));
+    numberOfDivisions = static_cast<unsigned int>(
+      std::min<double>(maximumNumberOfDivisions, std::max<double>(numberOfDivisions + 1.0, guess)));
+    sizeInBytes = estimateSizeInBytes(numberOfDivisions);
+    if (sizeInBytes < smallestSizeInBytes)
+    {
+      smallestNumberOfDivisions = numberOfDivisions;
+      smallestSizeInBytes = sizeInBytes;
+    }
+  }
+
+  if (sizeInBytes > memoryBudget)
+  {
+    // The pipeline cannot be streamed within the budget, for example because
+    // one of its filters requires its whole input.
+    estimatedSizeInBytes = smallestSizeInBytes;
+    return smallestNumberOfDivisions;
+  }
+
+  // The guess may have overshot: search for the smallest number of divisions
+  // within the budget, above the largest one known to be over it.
+  while (numberOfDivisions - largestNumberOfDivisionsOverBudget > 1)
+  {
+    const unsigned int middle =
+      largestNumberOfDivisionsOverBudget + (numberOfDivisions - largestNumberOfDivisionsOverBudget) / 2;
+    const SizeValueType middleSizeInBytes = estimateSizeInBytes(middle);
+    if (middleSizeInBytes > memoryBudget)
+    {
+      largestNumberOfDivisionsOverBudget = middle;
+    }
+    else
+    {
+      numberOfDivisions = middle;
+      sizeInBytes = middleSizeInBytes;
+    }
+  }
+  estimatedSizeInBytes = sizeInBytes;
+  return numberOfDivisions;
+}
+
+} // end namespace itk
@@ -0,0 +1,310 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace itk
+{
+struct PipelineProfilerGlobals
+{
+  PipelineProfilerGlobals() = default;
+
+  std::atomic<bool> m_Enabled{ false };
+
+  // The time from which the times of the events are measured.
+  std::atomic<std::chrono::steady_clock::rep> m_Origin{ std::chrono::steady_clock::now().time_since_epoch().count() };
+
+  // The events, and the indices of the threads that recorded them, in the
+  // order in which the threads recorded their first event.
+  std::mutex                                        m_Mutex;
+  std::vector<PipelineProfiler::Event>              m_Events;
+  std::unordered_map<std::thread::id, unsigned int> m_ThreadIndices;
+};
+
+itkGetGlobalSimpleMacro(PipelineProfiler, PipelineProfilerGlobals, PimplGlobals);
+
+PipelineProfilerGlobals * PipelineProfiler::m_PimplGlobals;
+
+namespace
+{
+// Writes the string as a JSON string.
+void
+WriteJSONString(std::ostream & os, const std::string & str)
+{
+  os << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+         << std::setfill(' ');
+    }
+    else
+    {
+      os << c;
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+
+void
+PipelineProfiler::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if (enabled && !m_PimplGlobals->m_Enabled)
+  {
+    Clear();
+  }
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+
+bool
+PipelineProfiler::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+
+void
+PipelineProfiler::Clear()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Events.clear();
+  m_PimplGlobals->m_ThreadIndices.clear();
+  m_PimplGlobals->m_Origin = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+
+std::vector<PipelineProfiler::Event>
+PipelineProfiler::GetEvents()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Events;
+}
+
+
+void
+PipelineProfiler::WriteChromeTrace(std::ostream & os)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::vector<Event> events = GetEvents();
+  unsigned int             numberOfThreads = 0;
+  for (const Event & event : events)
+  {
+    numberOfThreads = std::max(numberOfThreads, event.ThreadIndex + 1);
+  }
+
+  const auto previousFlags = os.flags();
+  const auto previousPrecision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    os << (first ? "\n" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread
+       << R"(,"args":{"name":"Thread )" << thread << "\"}}";
+    first = false;
+  }
+  for (const Event & event : events)
+  {
+    os << (first ? "\n" : ",\n") << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << R"(,"ph":"X","ts":)" << event.StartTime << ",\"dur\":" << event.Duration
+       << ",\"pid\":1,\"tid\":" << event.ThreadIndex << R"(,"args":{"pixels":)" << event.NumberOfPixels
+       << ",\"bytes\":" << event.NumberOfBytes << "}}";
+    first = false;
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.flags(previousFlags);
+  os.precision(previousPrecision);
+}
+
+
+void
+PipelineProfiler::WriteChromeTrace(const std::string & fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for writing the trace.");
+  }
+  WriteChromeTrace(file);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot write the trace to " << fileName << '.');
+  }
+}
+
+
+void
+PipelineProfiler::Report(std::ostream & os)
+{
+  struct FilterSummary
+  {
+    SizeValueType NumberOfExecutions{ 0 };
+    double        TotalTime{ 0.0 };
+    SizeValueType NumberOfBytes{ 0 };
+  };
+  std::map<std::string, FilterSummary> summaries;
+  for (const Event & event : GetEvents())
+  {
+    if (event.Category == "filter")
+    {
+      FilterSummary & summary = summaries[event.Name];
+      ++summary.NumberOfExecutions;
+      summary.TotalTime += event.Duration;
+      summary.NumberOfBytes += event.NumberOfBytes;
+    }
+  }
+  if (summaries.empty())
+  {
+    os << "No filter executions have been recorded" << std::endl;
+    return;
+  }
+
+  // The filters that take the most time first.
+  std::vector<std::pair<std::string, FilterSummary>> sortedSummaries(summaries.cbegin(), summaries.cend());
+  std::stable_sort(sortedSummaries.begin(), sortedSummaries.end(), [](const auto & a, const auto & b) {
+    return a.second.TotalTime > b.second.TotalTime;
+  });
+
+  const auto previousFlags = os.flags();
+  const auto previousPrecision = os.precision();
+  os << std::left << std::setw(40) << "Filter" << std::right << std::setw(12) << "Executions" << std::setw(16)
+     << "Total (s)" << std::setw(16) << "Mean (s)" << std::setw(18) << "Bytes" << std::endl;
+  os << std::fixed << std::setprecision(6);
+  for (const auto & [name, summary] : sortedSummaries)
+  {
+    os << std::left << std::setw(40) << name << std::right << std::setw(12) << summary.NumberOfExecutions
+       << std::setw(16) << summary.TotalTime * 1e-6 << std::setw(16)
+       << summary.TotalTime * 1e-6 / static_cast<double>(summary.NumberOfExecutions) << std::setw(18)
+       << summary.NumberOfBytes << std::endl;
+  }
+  os.flags(previousFlags);
+  os.precision(previousPrecision);
+}
+
+
+PipelineProfiler::FilterScope::FilterScope(ProcessObject * filter)
+  : m_Filter(filter)
+{
+  if (PipelineProfiler::GetEnabled())
+  {
+    m_StartTime = PipelineProfiler::GetTime();
+  }
+}
+
+
+PipelineProfiler::FilterScope::~FilterScope()
+{
+  if (m_StartTime < 0.0)
+  {
+    return;
+  }
+  try
+  {
+    const double  endTime = PipelineProfiler::GetTime();
+    SizeValueType numberOfBytes = 0;
+    for (const auto & output : m_Filter->GetOutputs())
+    {
+      if (output)
+      {
+        numberOfBytes += output->GetRequestedRegionSizeInBytes();
+      }
+    }
+    PipelineProfiler::RecordEvent(
+      { m_Filter->GetNameOfClass(), "filter", m_StartTime, endTime - m_StartTime, 0, 0, numberOfBytes });
+  }
+  catch (...)
+  {
+    // Profiling must not interfere with the execution of the pipeline.
+  }
+}
+
+
+PipelineProfiler::ThreadingFunctorType
+PipelineProfiler::ProfileChunks(const ProcessObject * filter,
+                                unsigned int          dimension,
+                                SizeValueType         numberOfPixelsPerIndex,
+                                ThreadingFunctorType  funcP)
+{
+  if (!GetEnabled())
+  {
+    return funcP;
+  }
+  std::string name = filter ? filter->GetNameOfClass() : "ParallelizeImageRegion";
+  return [name = std::move(name), dimension, numberOfPixelsPerIndex, funcP = std::move(funcP)](
+           const IndexValueType index[], const SizeValueType size[]) {
+    const double startTime = GetTime();
+    funcP(index, size);
+    const double  endTime = GetTime();
+    SizeValueType numberOfPixels = numberOfPixelsPerIndex;
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      numberOfPixels *= size[d];
+    }
+    RecordEvent({ name, "chunk", startTime, endTime - startTime, 0, numberOfPixels, 0 });
+  };
+}
+
+
+void
+PipelineProfiler::RecordEvent(Event event)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  const auto threadIndex = static_cast<unsigned int>(m_PimplGlobals->m_ThreadIndices.size());
+  event.ThreadIndex = m_PimplGlobals->m_ThreadIndices.emplace(std::this_thread::get_id(), threadIndex).first->second;
+  m_PimplGlobals->m_Events.push_back(std::move(event));
+}
+
+
+double
+PipelineProfiler::GetTime()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::chrono::steady_clock::duration sinceOrigin =
+    std::chrono::steady_clock::now().time_since_epoch() -
+    std::chrono::steady_clock::duration(m_PimplGlobals->m_Origin.load());
+  return std::chrono::duration<double, std::micro>(sinceOrigin).count();
+}
+
+} // end namespace itk
@@ -74,6 +74,32 @@ public:
 private:
   std::exception_ptr m_FirstCaughtException;
 };
+
+// Waits until the future is ready. With work stealing, the waiting thread
+// runs queued jobs meanwhile, so nested parallel sections cannot deadlock
+// the pool by having every pool thread wait for jobs nobody executes.
+template <typename TFuture>
+void
+WaitForFuture(ThreadPool & threadPool, TFuture & future, ProcessObject * filter)
+{
+  const bool         helpWhileWaiting = ThreadPool::GetUseWorkStealing();
+  std::future_status status;
+  do
+  {
+    if (helpWhileWaiting && threadPool.RunPendingTask())
+    {
+      status = future.wait_for(std::chrono::milliseconds(0));
+    }
+    else
+    {
+      status = future.wait_for(threadCompletionPollingInterval);
+      if (filter && status == std::future_status::timeout)
+      {
+        filter->IncrementProgress(0);
+      }
+    }
+  } while (status != std::future_status::ready);
+}
 } // namespace
 
 
@@ -145,7 +171,10 @@ PoolMultiThreader::SingleMethodExecute()
   // so now it waits for each of the other work units to finish
   for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
   {
-    exceptionHandler.TryAndCatch([this, threadLoop] { m_ThreadInfoArray[threadLoop].Future.get(); });
+    exceptionHandler.TryAndCatch([this, threadLoop] {
+      WaitForFuture(*m_ThreadPool, m_ThreadInfoArray[threadLoop].Future, nullptr);
+      m_ThreadInfoArray[threadLoop].Future.get();
+    });
   }
 
   exceptionHandler.RethrowFirstCaughtException();
@@ -199,15 +228,7 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
     for (SizeValueType i = 1; i < workUnit; ++i)
     {
       exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-        std::future_status status;
-        do
-        {
-          status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter && status == std::future_status::timeout)
-          {
-            filter->IncrementProgress(0);
-          }
-        } while (status != std::future_status::ready);
+        WaitForFuture(*m_ThreadPool, m_ThreadInfoArray[i].Future, filter);
         reporter.CompletedPixel();
       });
     }
@@ -291,15 +312,7 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
       for (ThreadIdType i = 1; i < splitCount; ++i)
       {
         exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-          std::future_status status;
-          do
-          {
-            status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-            if (filter && status == std::future_status::timeout)
-            {
-              filter->IncrementProgress(0);
-            }
-          } while (status != std::future_status::ready);
+          WaitForFuture(*m_ThreadPool, m_ThreadInfoArray[i].Future, filter);
           m_ThreadInfoArray[i].Future.get();
           reporter.CompletedPixel();
         });
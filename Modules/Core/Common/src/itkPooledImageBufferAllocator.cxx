@@ -0,0 +1,290 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPooledImageBufferAllocator.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#if defined(_WIN32)
+#  include <malloc.h>
+#endif
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+constexpr SizeValueType PageSize = 4096;
+
+// The buffers are zeroed by blocks of whole huge pages.
+constexpr SizeValueType ZeroingBlockSize = PooledImageBufferAllocator::HugePageSize;
+
+void *
+AllocateAligned(SizeValueType numberOfBytes, SizeValueType alignment)
+{
+#if defined(_WIN32)
+  return _aligned_malloc(numberOfBytes, alignment);
+#else
+  void * buffer = nullptr;
+  return posix_memalign(&buffer, alignment, numberOfBytes) == 0 ? buffer : nullptr;
+#endif
+}
+
+void
+FreeAligned(void * buffer)
+{
+#if defined(_WIN32)
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+
+// Zeroes the bytes, in parallel when asked to, so that each thread first
+// touches a contiguous part of the buffer.
+void
+ZeroBytes(void * buffer, SizeValueType numberOfBytes, bool parallel)
+{
+  const SizeValueType numberOfBlocks = (numberOfBytes + ZeroingBlockSize - 1) / ZeroingBlockSize;
+  if (!parallel || numberOfBlocks < 2)
+  {
+    std::memset(buffer, 0, numberOfBytes);
+    return;
+  }
+  auto * const bytes = static_cast<unsigned char *>(buffer);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [bytes, numberOfBytes](SizeValueType i) {
+      const SizeValueType begin = i * ZeroingBlockSize;
+      std::memset(bytes + begin, 0, std::min(ZeroingBlockSize, numberOfBytes - begin));
+    },
+    nullptr);
+}
+} // namespace
+
+
+PooledImageBufferAllocator::~PooledImageBufferAllocator()
+{
+  this->ReleasePooledBuffers();
+}
+
+
+SizeValueType
+PooledImageBufferAllocator::ComputeBucketSize(SizeValueType numberOfBytes)
+{
+  // Whole pages, up to eight pages.
+  constexpr SizeValueType NumberOfBucketsPerPowerOfTwo = 8;
+  if (numberOfBytes <= NumberOfBucketsPerPowerOfTwo * PageSize)
+  {
+    return std::max<SizeValueType>(1, (numberOfBytes + PageSize - 1) / PageSize) * PageSize;
+  }
+
+  // Above, eight buckets between each power of two and the next one.
+  SizeValueType powerOfTwo = NumberOfBucketsPerPowerOfTwo * PageSize;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const SizeValueType step = powerOfTwo / NumberOfBucketsPerPowerOfTwo;
+  return (numberOfBytes + step - 1) / step * step;
+}
+
+
+void *
+PooledImageBufferAllocator::Allocate(SizeValueType numberOfBytes, bool zeroInitialize)
+{
+  const SizeValueType bucketSize = ComputeBucketSize(numberOfBytes);
+  void *              buffer = nullptr;
+  bool                useHugePages;
+  bool                useParallelFirstTouch;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    useHugePages = m_UseHugePages;
+    useParallelFirstTouch = m_UseParallelFirstTouch;
+    ++m_NumberOfAllocations;
+    const auto pooled = m_PooledBuffers.find(bucketSize);
+    if (pooled != m_PooledBuffers.end())
+    {
+      buffer = pooled->second.back();
+      pooled->second.pop_back();
+      if (pooled->second.empty())
+      {
+        m_PooledBuffers.erase(pooled);
+      }
+      m_PooledSizeInBytes -= bucketSize;
+      ++m_NumberOfReusedAllocations;
+    }
+    m_AllocatedSizeInBytes += bucketSize;
+  }
+
+  if (buffer != nullptr)
+  {
+    // The pages of a pooled buffer are already touched.
+    if (zeroInitialize)
+    {
+      ZeroBytes(buffer, numberOfBytes, useParallelFirstTouch);
+    }
+    return buffer;
+  }
+
+  const bool          isHuge = useHugePages && bucketSize >= HugePageSize;
+  const SizeValueType alignment = isHuge ? HugePageSize : Alignment;
+  buffer = AllocateAligned(bucketSize, alignment);
+  if (buffer == nullptr)
+  {
+    this->ReleasePooledBuffers();
+    buffer = AllocateAligned(bucketSize, alignment);
+  }
+  if (buffer == nullptr)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      m_AllocatedSizeInBytes -= bucketSize;
+    }
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (isHuge)
+  {
+    // Only advice: the buffer is still usable when it is not followed.
+    madvise(buffer, bucketSize, MADV_HUGEPAGE);
+  }
+#endif
+
+  if (zeroInitialize || useParallelFirstTouch)
+  {
+    ZeroBytes(buffer, zeroInitialize ? numberOfBytes : bucketSize, useParallelFirstTouch);
+  }
+  return buffer;
+}
+
+
+void
+PooledImageBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  const SizeValueType bucketSize = ComputeBucketSize(numberOfBytes);
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_AllocatedSizeInBytes -= bucketSize;
+    if (m_PooledSizeInBytes + bucketSize <= m_MaximumPooledSizeInBytes)
+    {
+      m_PooledBuffers[bucketSize].push_back(buffer);
+      m_PooledSizeInBytes += bucketSize;
+      return;
+    }
+  }
+  FreeAligned(buffer);
+}
+
+
+void
+PooledImageBufferAllocator::ReleasePooledBuffers()
+{
+  std::map<SizeValueType, std::vector<void *>> pooledBuffers;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    pooledBuffers.swap(m_PooledBuffers);
+    m_PooledSizeInBytes = 0;
+  }
+  for (const auto & bucket : pooledBuffers)
+  {
+    for (void * const buffer : bucket.second)
+    {
+      FreeAligned(buffer);
+    }
+  }
+}
+
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfAllocations() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfAllocations;
+}
+
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfReusedAllocations() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfReusedAllocations;
+}
+
+
+double
+PooledImageBufferAllocator::GetReuseRate() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfAllocations == 0
+           ? 0.0
+           : static_cast<double>(m_NumberOfReusedAllocations) / static_cast<double>(m_NumberOfAllocations);
+}
+
+
+SizeValueType
+PooledImageBufferAllocator::GetPooledSizeInBytes() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_PooledSizeInBytes;
+}
+
+
+SizeValueType
+PooledImageBufferAllocator::GetAllocatedSizeInBytes() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_AllocatedSizeInBytes;
+}
+
+
+void
+PooledImageBufferAllocator::ResetStatistics()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfAllocations = 0;
+  m_NumberOfReusedAllocations = 0;
+}
+
+
+void
+PooledImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "MaximumPooledSizeInBytes: " << m_MaximumPooledSizeInBytes << std::endl;
+  os << indent << "UseHugePages: " << (m_UseHugePages ? "On" : "Off") << std::endl;
+  os << indent << "UseParallelFirstTouch: " << (m_UseParallelFirstTouch ? "On" : "Off") << std::endl;
+  os << indent << "NumberOfAllocations: " << this->GetNumberOfAllocations() << std::endl;
+  os << indent << "NumberOfReusedAllocations: " << this->GetNumberOfReusedAllocations() << std::endl;
+  os << indent << "PooledSizeInBytes: " << this->GetPooledSizeInBytes() << std::endl;
+  os << indent << "AllocatedSizeInBytes: " << this->GetAllocatedSizeInBytes() << std::endl;
+}
+
+} // end namespace itk
@@ -32,6 +32,7 @@
 #include <sstream>
 #include <algorithm>
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineProfiler.h"
 
 namespace itk
 {
@@ -1620,6 +1621,29 @@ ProcessObject::ReleaseInputs()
 }
 
 
+void
+ProcessObject::UpdateInputs()
+{
+  if (m_Inputs.size() == 1)
+  {
+    if (this->GetPrimaryInput())
+    {
+      this->GetPrimaryInput()->UpdateOutputData();
+    }
+  }
+  else
+  {
+    for (auto & input : m_Inputs)
+    {
+      if (input.second)
+      {
+        input.second->PropagateRequestedRegion();
+        input.second->UpdateOutputData();
+      }
+    }
+  }
+}
+
 void
 ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 {
@@ -1646,24 +1670,7 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
   m_Updating = true;
   m_UpdateThreadID = std::this_thread::get_id();
 
-  if (m_Inputs.size() == 1)
-  {
-    if (this->GetPrimaryInput())
-    {
-      this->GetPrimaryInput()->UpdateOutputData();
-    }
-  }
-  else
-  {
-    for (auto & input : m_Inputs)
-    {
-      if (input.second)
-      {
-        input.second->PropagateRequestedRegion();
-        input.second->UpdateOutputData();
-      }
-    }
-  }
+  this->UpdateInputs();
 
   /**
    * Cache the state of any ReleaseDataFlag's on the inputs. While the
@@ -1689,6 +1696,7 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 
   try
   {
+    const PipelineProfiler::FilterScope profilerScope(this);
     this->GenerateData();
   }
   catch (const ProcessAborted &)
@@ -32,6 +32,12 @@
 
 namespace itk
 {
+namespace
+{
+// Index of the pool thread running on the current thread, or -1 when the
+// current thread does not belong to the pool.
+thread_local std::ptrdiff_t currentWorkerIndex = -1;
+} // namespace
 
 struct ThreadPoolGlobals
 {
@@ -57,6 +63,9 @@ struct ThreadPoolGlobals
 #else // In a static library, we have to wait.
   std::atomic<bool> m_WaitForThreads{ true };
 #endif
+
+  // Whether jobs are scheduled on per-thread queues with work stealing.
+  std::atomic<bool> m_UseWorkStealing{ false };
 };
 
 itkGetGlobalSimpleMacro(ThreadPool, ThreadPoolGlobals, PimplGlobals);
@@ -104,7 +113,22 @@ ThreadPool::SetDoNotWaitForThreads(bool doNotWaitForThreads)
   m_PimplGlobals->m_WaitForThreads = !doNotWaitForThreads;
 }
 
+bool
+ThreadPool::GetUseWorkStealing()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_UseWorkStealing;
+}
+
+void
+ThreadPool::SetUseWorkStealing(bool useWorkStealing)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_UseWorkStealing = useWorkStealing;
+}
+
 ThreadPool::ThreadPool()
+  : m_WorkerQueues(std::make_unique<WorkerQueue[]>(ITK_MAX_THREADS))
 {
   // m_PimplGlobals->m_Mutex not needed to be acquired here because construction only occurs via GetInstance which is
   // protected by call_once.
@@ -115,19 +139,22 @@ ThreadPool::ThreadPool()
   m_Threads.reserve(threadCount);
   for (ThreadIdType i = 0; i < threadCount; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, i);
   }
+  m_NumberOfWorkers = threadCount;
 }
 
 void
 ThreadPool::AddThreads(ThreadIdType count)
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  const auto firstIndex = static_cast<ThreadIdType>(m_Threads.size());
   m_Threads.reserve(m_Threads.size() + count);
   for (ThreadIdType i = 0; i < count; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, firstIndex + i);
   }
+  m_NumberOfWorkers = static_cast<ThreadIdType>(m_Threads.size());
 }
 
 std::mutex &
@@ -140,7 +167,110 @@ int
 ThreadPool::GetNumberOfCurrentlyIdleThreads() const
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
-  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_WorkQueue.size()); // lousy approximation
+  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_WorkQueue.size()) -
+         static_cast<int>(m_NumberOfQueuedWorkerTasks); // lousy approximation
+}
+
+void
+ThreadPool::PushTask(std::function<void()> && task)
+{
+  const ThreadIdType numberOfQueues = std::min<ThreadIdType>(m_NumberOfWorkers, ITK_MAX_THREADS);
+  if (!m_PimplGlobals->m_UseWorkStealing || numberOfQueues == 0)
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+      m_WorkQueue.emplace_back(std::move(task));
+    }
+    m_Condition.notify_one();
+    return;
+  }
+
+  // Jobs spawned by a pool thread stay on its own queue, for locality.
+  // Jobs from outside the pool are dealt out over all queues.
+  const ThreadIdType queueIndex = currentWorkerIndex >= 0
+                                    ? static_cast<ThreadIdType>(currentWorkerIndex) % ITK_MAX_THREADS
+                                    : m_NextWorkerQueue++ % numberOfQueues;
+  {
+    WorkerQueue &                     queue = m_WorkerQueues[queueIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    queue.m_Tasks.emplace_back(std::move(task));
+  }
+  ++m_NumberOfQueuedWorkerTasks;
+
+  // A sleeping thread increments m_NumberOfSleepingThreads before it checks
+  // m_NumberOfQueuedWorkerTasks, so either it sees the new job or we see it
+  // sleeping. Only in the latter case is the shared mutex needed.
+  if (m_NumberOfSleepingThreads > 0)
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+bool
+ThreadPool::PopOrStealTask(std::function<void()> & task)
+{
+  if (m_NumberOfQueuedWorkerTasks <= 0)
+  {
+    return false;
+  }
+  const ThreadIdType numberOfQueues = std::min<ThreadIdType>(m_NumberOfWorkers, ITK_MAX_THREADS);
+
+  // The owner takes its most recent job (LIFO), as nested jobs are the most
+  // likely to find their data in cache.
+  ThreadIdType firstVictim = 0;
+  if (currentWorkerIndex >= 0)
+  {
+    const ThreadIdType ownIndex = static_cast<ThreadIdType>(currentWorkerIndex) % ITK_MAX_THREADS;
+    WorkerQueue &      queue = m_WorkerQueues[ownIndex];
+    {
+      const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+      if (!queue.m_Tasks.empty())
+      {
+        task = std::move(queue.m_Tasks.back());
+        queue.m_Tasks.pop_back();
+        --m_NumberOfQueuedWorkerTasks;
+        return true;
+      }
+    }
+    firstVictim = ownIndex + 1;
+  }
+
+  // Thieves take the oldest job (FIFO) of the other queues.
+  for (ThreadIdType i = 0; i < numberOfQueues; ++i)
+  {
+    WorkerQueue &                     queue = m_WorkerQueues[(firstVictim + i) % numberOfQueues];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.front());
+      queue.m_Tasks.pop_front();
+      --m_NumberOfQueuedWorkerTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+ThreadPool::RunPendingTask()
+{
+  std::function<void()> task;
+  if (!this->PopOrStealTask(task))
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    if (m_WorkQueue.empty())
+    {
+      return false;
+    }
+    task = std::move(m_WorkQueue.front());
+    m_WorkQueue.pop_front();
+  }
+
+  task(); // execute the task
+  return true;
 }
 
 void
@@ -187,28 +317,40 @@ ThreadPool::ResumeFromFork()
 }
 
 void
-ThreadPool::ThreadExecute()
+ThreadPool::ThreadExecute(ThreadIdType workerIndex)
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  currentWorkerIndex = static_cast<std::ptrdiff_t>(workerIndex);
 
   while (true)
   {
     std::function<void()> task;
 
+    if (!threadPool->PopOrStealTask(task))
     {
       std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-      threadPool->m_Condition.wait(mutexHolder,
-                                   [threadPool] { return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty(); });
-      if (threadPool->m_Stopping && threadPool->m_WorkQueue.empty())
+      ++threadPool->m_NumberOfSleepingThreads;
+      threadPool->m_Condition.wait(mutexHolder, [threadPool] {
+        return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty() ||
+               threadPool->m_NumberOfQueuedWorkerTasks > 0;
+      });
+      --threadPool->m_NumberOfSleepingThreads;
+      if (!threadPool->m_WorkQueue.empty())
+      {
+        task = std::move(threadPool->m_WorkQueue.front());
+        threadPool->m_WorkQueue.pop_front();
+      }
+      else if (threadPool->m_Stopping && threadPool->m_NumberOfQueuedWorkerTasks <= 0)
       {
         return;
       }
-      task = std::move(threadPool->m_WorkQueue.front());
-      threadPool->m_WorkQueue.pop_front();
     }
 
-    task(); // execute the task
+    if (task)
+    {
+      task(); // execute the task
+    }
   }
 }
 
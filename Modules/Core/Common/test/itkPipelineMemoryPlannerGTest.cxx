@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineMemoryPlanner.h"
+#include "itkStreamingImageFilter.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImage.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using MonitorType = itk::PipelineMonitorImageFilter<ImageType>;
+using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+
+// The offset of a pixel in the image of OffsetImageSource.
+float
+Offset(const ImageType::IndexType & index)
+{
+  return static_cast<float>(index[0] + 20 * index[1] + 200 * index[2]);
+}
+
+// A source of an image of 20 x 10 x 8 pixels, of 800 bytes per slice, whose
+// pixels are their offset in the image.
+class OffsetImageSource : public itk::ImageSource<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OffsetImageSource);
+
+  using Self = OffsetImageSource;
+  using Superclass = itk::ImageSource<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OffsetImageSource);
+
+protected:
+  OffsetImageSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    this->GetOutput()->SetLargestPossibleRegion(ImageType::RegionType(ImageType::SizeType{ { 20, 10, 8 } }));
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & outputRegionForThread) override
+  {
+    ImageType * const output = this->GetOutput();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(output, outputRegionForThread); !it.IsAtEnd(); ++it)
+    {
+      it.Set(Offset(it.GetIndex()));
+    }
+  }
+};
+
+void
+ExpectOffsetPixels(const ImageType & image)
+{
+  ASSERT_EQ(image.GetLargestPossibleRegion(), image.GetBufferedRegion());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(&image, image.GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), Offset(it.GetIndex()));
+  }
+}
+} // namespace
+
+
+TEST(PipelineMemoryPlanner, RequestedRegionSizeInBytes)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 4, 3, 2 } });
+  EXPECT_EQ(image->GetRequestedRegionSizeInBytes(), 24 * sizeof(float));
+
+  using VectorImageType = itk::VectorImage<short, 2>;
+  auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(VectorImageType::SizeType{ { 5, 2 } });
+  vectorImage->SetVectorLength(3);
+  EXPECT_EQ(vectorImage->GetRequestedRegionSizeInBytes(), 30 * sizeof(short));
+}
+
+
+TEST(PipelineMemoryPlanner, ComputeNumberOfDivisions)
+{
+  // A fixed overhead, for example the boundary of a neighborhood filter.
+  const auto estimate = [](unsigned int numberOfDivisions) -> itk::SizeValueType {
+    return (1000 + numberOfDivisions - 1) / numberOfDivisions + 10;
+  };
+  itk::SizeValueType estimatedSizeInBytes = 0;
+  EXPECT_EQ(itk::PipelineMemoryPlanner::ComputeNumberOfDivisions(120, 1000, estimate, estimatedSizeInBytes), 10u);
+  EXPECT_EQ(estimatedSizeInBytes, 110u);
+  EXPECT_EQ(itk::PipelineMemoryPlanner::ComputeNumberOfDivisions(2000, 1000, estimate, estimatedSizeInBytes), 1u);
+  EXPECT_EQ(estimatedSizeInBytes, 1010u);
+  for (itk::SizeValueType budget = 12; budget < 1100; budget += 7)
+  {
+    const unsigned int numberOfDivisions =
+      itk::PipelineMemoryPlanner::ComputeNumberOfDivisions(budget, 1000, estimate, estimatedSizeInBytes);
+    EXPECT_LE(estimate(numberOfDivisions), budget);
+    EXPECT_TRUE(numberOfDivisions == 1 || estimate(numberOfDivisions - 1) > budget);
+  }
+
+  // Over the budget, even at the maximum number of divisions.
+  EXPECT_EQ(itk::PipelineMemoryPlanner::ComputeNumberOfDivisions(100, 10, estimate, estimatedSizeInBytes), 10u);
+  EXPECT_EQ(estimatedSizeInBytes, 110u);
+  EXPECT_EQ(itk::PipelineMemoryPlanner::ComputeNumberOfDivisions(
+              100, 50, [](unsigned int) -> itk::SizeValueType { return 500; }, estimatedSizeInBytes),
+            1u);
+  EXPECT_EQ(estimatedSizeInBytes, 500u);
+}
+
+
+TEST(PipelineMemoryPlanner, EstimateUpdateSizeInBytes)
+{
+  auto source = OffsetImageSource::New();
+  auto monitor = MonitorType::New();
+  monitor->SetInput(source->GetOutput());
+  monitor->UpdateOutputInformation();
+
+  ImageType * const output = monitor->GetOutput();
+  output->SetRequestedRegion(ImageType::RegionType({ { 0, 0, 2 } }, { { 20, 10, 3 } }));
+  EXPECT_EQ(itk::PipelineMemoryPlanner::EstimateUpdateSizeInBytes(output), 2 * 600 * sizeof(float));
+  EXPECT_EQ(source->GetOutput()->GetRequestedRegion(), output->GetRequestedRegion());
+
+  // Data that is up to date is not generated again.
+  source->Update();
+  EXPECT_EQ(itk::PipelineMemoryPlanner::EstimateUpdateSizeInBytes(output), 600 * sizeof(float));
+
+  // An image without a source is not generated.
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 4, 3, 2 } });
+  EXPECT_EQ(itk::PipelineMemoryPlanner::EstimateUpdateSizeInBytes(image), 0u);
+}
+
+
+TEST(PipelineMemoryPlanner, StreamingImageFilterWithinMemoryBudget)
+{
+  auto source = OffsetImageSource::New();
+  auto monitor = MonitorType::New();
+  monitor->SetInput(source->GetOutput());
+  auto streamer = StreamerType::New();
+  streamer->SetInput(monitor->GetOutput());
+  EXPECT_EQ(streamer->GetMemoryBudget(), 0u);
+
+  // Two slices per piece, generated by the source and passed by the monitor.
+  streamer->SetMemoryBudget(3200);
+  streamer->Update();
+  EXPECT_EQ(monitor->GetNumberOfUpdates(), 4u);
+  for (const auto & region : monitor->GetUpdatedRequestedRegions())
+  {
+    EXPECT_EQ(region.GetSize(2), 2u);
+  }
+  ExpectOffsetPixels(*streamer->GetOutput());
+
+  // Less than a slice per piece, which the splitter of the slowest dimension
+  // does not support.
+  monitor->ClearPipelineSavedInformation();
+  streamer->SetMemoryBudget(1000);
+  streamer->Modified();
+  streamer->Update();
+  EXPECT_GT(monitor->GetNumberOfUpdates(), 8u);
+  for (const auto & region : monitor->GetUpdatedRequestedRegions())
+  {
+    EXPECT_LE(2 * region.GetNumberOfPixels() * sizeof(float), 1000u);
+  }
+  ExpectOffsetPixels(*streamer->GetOutput());
+}
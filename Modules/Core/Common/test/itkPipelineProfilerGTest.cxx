@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+#include "itkImage.h"
+
+#include "itkGTest.h"
+#include <sstream>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+// A source of an image of 64 x 32 x 16 pixels, generated in parallel.
+class FillImageSource : public itk::ImageSource<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FillImageSource);
+
+  using Self = FillImageSource;
+  using Superclass = itk::ImageSource<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(FillImageSource);
+
+protected:
+  FillImageSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    this->GetOutput()->SetLargestPossibleRegion(ImageType::RegionType(ImageType::SizeType{ { 64, 32, 16 } }));
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & outputRegionForThread) override
+  {
+    for (itk::ImageRegionIterator<ImageType> it(this->GetOutput(), outputRegionForThread); !it.IsAtEnd(); ++it)
+    {
+      it.Set(7);
+    }
+  }
+};
+
+struct PipelineProfiler : public ::testing::Test
+{
+  void
+  TearDown() override
+  {
+    itk::PipelineProfiler::SetEnabled(false);
+    itk::PipelineProfiler::Clear();
+  }
+};
+} // namespace
+
+
+TEST_F(PipelineProfiler, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::PipelineProfiler::GetEnabled());
+  FillImageSource::New()->Update();
+  EXPECT_TRUE(itk::PipelineProfiler::GetEvents().empty());
+}
+
+
+TEST_F(PipelineProfiler, RecordsFiltersAndChunks)
+{
+  itk::PipelineProfiler::SetEnabled(true);
+  auto source = FillImageSource::New();
+  source->SetNumberOfWorkUnits(4);
+  source->Update();
+  itk::PipelineProfiler::SetEnabled(false);
+
+  const std::vector<itk::PipelineProfiler::Event> events = itk::PipelineProfiler::GetEvents();
+  ASSERT_FALSE(events.empty());
+
+  // The filter ends after its chunks, which cover its output.
+  const itk::PipelineProfiler::Event & filterEvent = events.back();
+  EXPECT_EQ(filterEvent.Name, "FillImageSource");
+  EXPECT_EQ(filterEvent.Category, "filter");
+  EXPECT_EQ(filterEvent.NumberOfBytes, 64u * 32u * 16u * sizeof(short));
+  EXPECT_GE(filterEvent.Duration, 0.0);
+
+  itk::SizeValueType numberOfPixels = 0;
+  for (auto event = events.cbegin(); event != events.cend() - 1; ++event)
+  {
+    EXPECT_EQ(event->Name, "FillImageSource");
+    EXPECT_EQ(event->Category, "chunk");
+    EXPECT_GE(event->StartTime, filterEvent.StartTime);
+    EXPECT_LE(event->StartTime + event->Duration, filterEvent.StartTime + filterEvent.Duration);
+    numberOfPixels += event->NumberOfPixels;
+  }
+  EXPECT_EQ(numberOfPixels, 64u * 32u * 16u);
+
+  // Nothing is recorded once the profiler is disabled.
+  source->Modified();
+  source->Update();
+  EXPECT_EQ(itk::PipelineProfiler::GetEvents().size(), events.size());
+}
+
+
+TEST_F(PipelineProfiler, WriteChromeTrace)
+{
+  std::ostringstream emptyTrace;
+  itk::PipelineProfiler::WriteChromeTrace(emptyTrace);
+  EXPECT_EQ(emptyTrace.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+
+  itk::PipelineProfiler::SetEnabled(true);
+  FillImageSource::New()->Update();
+
+  std::ostringstream trace;
+  itk::PipelineProfiler::WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[\n", 0), 0u);
+  EXPECT_NE(json.find(R"({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"Thread 0"}})"),
+            std::string::npos);
+  EXPECT_NE(json.find(R"({"name":"FillImageSource","cat":"filter","ph":"X","ts":)"), std::string::npos);
+  EXPECT_NE(json.find(R"("args":{"pixels":0,"bytes":65536}})"), std::string::npos);
+  EXPECT_NE(json.find(R"({"name":"FillImageSource","cat":"chunk","ph":"X","ts":)"), std::string::npos);
+
+  std::ostringstream report;
+  itk::PipelineProfiler::Report(report);
+  EXPECT_NE(report.str().find("FillImageSource"), std::string::npos);
+
+  EXPECT_THROW(itk::PipelineProfiler::WriteChromeTrace("/nonexistent/directory/trace.json"), itk::ExceptionObject);
+}
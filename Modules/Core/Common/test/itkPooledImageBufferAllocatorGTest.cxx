@@ -0,0 +1,230 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPooledImageBufferAllocator.h"
+#include "itkImportImageContainer.h"
+#include "itkImage.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+// Sets a global default allocator for the lifetime of the scope.
+class GlobalDefaultAllocatorScope
+{
+public:
+  explicit GlobalDefaultAllocatorScope(itk::ImageBufferAllocator * allocator)
+  {
+    itk::ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  }
+  ~GlobalDefaultAllocatorScope() { itk::ImageBufferAllocator::SetGlobalDefaultAllocator(nullptr); }
+};
+
+bool
+IsZero(const void * buffer, itk::SizeValueType numberOfBytes)
+{
+  const auto * const bytes = static_cast<const unsigned char *>(buffer);
+  return std::all_of(bytes, bytes + numberOfBytes, [](unsigned char byte) { return byte == 0; });
+}
+} // namespace
+
+
+TEST(PooledImageBufferAllocator, ComputeBucketSize)
+{
+  using AllocatorType = itk::PooledImageBufferAllocator;
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(0), 4096u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(1), 4096u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(4096), 4096u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(4097), 8192u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(32768), 32768u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(32769), 36864u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(65536), 65536u);
+  EXPECT_EQ(AllocatorType::ComputeBucketSize(65537), 73728u);
+
+  for (itk::SizeValueType numberOfBytes = 1; numberOfBytes < (itk::SizeValueType{ 1 } << 34);
+       numberOfBytes = numberOfBytes * 3 + 7)
+  {
+    const itk::SizeValueType bucketSize = AllocatorType::ComputeBucketSize(numberOfBytes);
+    EXPECT_GE(bucketSize, numberOfBytes);
+    EXPECT_LE(bucketSize, numberOfBytes + std::max<itk::SizeValueType>(4095, numberOfBytes / 8));
+    EXPECT_EQ(bucketSize % 4096, 0u);
+    EXPECT_EQ(AllocatorType::ComputeBucketSize(bucketSize), bucketSize);
+  }
+}
+
+
+TEST(PooledImageBufferAllocator, ReusesReleasedBuffers)
+{
+  const auto allocator = itk::PooledImageBufferAllocator::New();
+  EXPECT_EQ(allocator->GetReuseRate(), 0.0);
+
+  void * const buffer = allocator->Allocate(100000, false);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % itk::ImageBufferAllocator::Alignment, 0u);
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 106496u);
+  allocator->Deallocate(buffer, 100000);
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 0u);
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 106496u);
+
+  // The same bucket.
+  std::memset(buffer, 0xFF, 100000);
+  void * const reusedBuffer = allocator->Allocate(99000, true);
+  EXPECT_EQ(reusedBuffer, buffer);
+  EXPECT_TRUE(IsZero(reusedBuffer, 99000));
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 0u);
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 2u);
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 1u);
+  EXPECT_EQ(allocator->GetReuseRate(), 0.5);
+
+  // Another bucket.
+  void * const otherBuffer = allocator->Allocate(200000, false);
+  EXPECT_NE(otherBuffer, buffer);
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 1u);
+
+  allocator->Deallocate(reusedBuffer, 99000);
+  allocator->Deallocate(otherBuffer, 200000);
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 106496u + 212992u);
+  allocator->ReleasePooledBuffers();
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 0u);
+
+  allocator->ResetStatistics();
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 0u);
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 0u);
+}
+
+
+TEST(PooledImageBufferAllocator, MaximumPooledSize)
+{
+  const auto allocator = itk::PooledImageBufferAllocator::New();
+  allocator->SetMaximumPooledSizeInBytes(8192);
+
+  void * const buffers[] = { allocator->Allocate(4096, false),
+                             allocator->Allocate(4096, false),
+                             allocator->Allocate(4096, false) };
+  for (void * const buffer : buffers)
+  {
+    allocator->Deallocate(buffer, 4096);
+  }
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 8192u);
+
+  allocator->SetMaximumPooledSizeInBytes(0);
+  allocator->Deallocate(allocator->Allocate(4096, false), 4096);
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 4096u);
+}
+
+
+TEST(PooledImageBufferAllocator, LargeBuffers)
+{
+  for (const bool useParallelFirstTouch : { false, true })
+  {
+    const auto allocator = itk::PooledImageBufferAllocator::New();
+    allocator->SetUseParallelFirstTouch(useParallelFirstTouch);
+    constexpr itk::SizeValueType numberOfBytes = 5 * itk::PooledImageBufferAllocator::HugePageSize + 123;
+
+    void * const buffer = allocator->Allocate(numberOfBytes, true);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % itk::PooledImageBufferAllocator::HugePageSize, 0u);
+    EXPECT_TRUE(IsZero(buffer, numberOfBytes));
+    std::memset(buffer, 0xFF, numberOfBytes);
+    allocator->Deallocate(buffer, numberOfBytes);
+
+    void * const reusedBuffer = allocator->Allocate(numberOfBytes, true);
+    EXPECT_EQ(reusedBuffer, buffer);
+    EXPECT_TRUE(IsZero(reusedBuffer, numberOfBytes));
+    allocator->Deallocate(reusedBuffer, numberOfBytes);
+  }
+}
+
+
+TEST(PooledImageBufferAllocator, ImportImageContainer)
+{
+  const auto allocator = itk::PooledImageBufferAllocator::New();
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, float>;
+  const auto container = ContainerType::New();
+  container->SetAllocator(allocator);
+
+  container->Reserve(1000, true);
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 1u);
+  std::fill_n(container->GetBufferPointer(), 1000, 3.0f);
+
+  // Enlarged, keeping the elements.
+  container->Reserve(5000, true);
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 2u);
+  EXPECT_EQ(allocator->GetPooledSizeInBytes(), 4096u);
+  EXPECT_EQ((*container)[999], 3.0f);
+
+  // Squeezed into the released buffer.
+  container->Reserve(1000);
+  container->Squeeze();
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 1u);
+  EXPECT_EQ((*container)[999], 3.0f);
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 4096u);
+
+  container->Initialize();
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 0u);
+
+  // Imported buffers are not released to the allocator.
+  std::vector<float> imported(10);
+  container->SetImportPointer(imported.data(), 10, false);
+  container->Reserve(10);
+  container->Initialize();
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 0u);
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 3u);
+
+  // Elements that are not trivial are allocated with new[].
+  const auto stringContainer = itk::ImportImageContainer<itk::SizeValueType, std::string>::New();
+  stringContainer->SetAllocator(allocator);
+  stringContainer->Reserve(10, true);
+  (*stringContainer)[9] = "nine";
+  stringContainer->Initialize();
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 3u);
+}
+
+
+TEST(PooledImageBufferAllocator, GlobalDefaultAllocator)
+{
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocator(), nullptr);
+
+  const auto                        allocator = itk::PooledImageBufferAllocator::New();
+  const GlobalDefaultAllocatorScope scope(allocator);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocator(), allocator.GetPointer());
+
+  // The images of an iterative pipeline reuse the buffers of the previous iterations.
+  using ImageType = itk::Image<short, 3>;
+  using VectorImageType = itk::VectorImage<float, 3>;
+  constexpr unsigned int numberOfIterations = 10;
+  for (unsigned int i = 0; i < numberOfIterations; ++i)
+  {
+    const auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 64, 32, 16 } });
+    image->AllocateInitialized();
+    EXPECT_EQ(image->GetPixel({ { 63, 31, 15 } }), 0);
+    image->FillBuffer(static_cast<short>(i + 1));
+
+    const auto vectorImage = VectorImageType::New();
+    vectorImage->SetRegions(VectorImageType::SizeType{ { 16, 16, 16 } });
+    vectorImage->SetNumberOfComponentsPerPixel(3);
+    vectorImage->Allocate();
+  }
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 2 * numberOfIterations);
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 2 * (numberOfIterations - 1));
+  EXPECT_EQ(allocator->GetReuseRate(), 0.9);
+  EXPECT_EQ(allocator->GetAllocatedSizeInBytes(), 0u);
+}
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkThreadPool.h"
+#include "itkPoolMultiThreader.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <vector>
+
+
+namespace
+{
+// Enables work stealing for the lifetime of the object, and restores the previous setting afterwards.
+class WorkStealingGuard
+{
+public:
+  WorkStealingGuard()
+    : m_PreviousValue(itk::ThreadPool::GetUseWorkStealing())
+  {
+    itk::ThreadPool::SetUseWorkStealing(true);
+  }
+
+  ~WorkStealingGuard() { itk::ThreadPool::SetUseWorkStealing(m_PreviousValue); }
+
+private:
+  const bool m_PreviousValue;
+};
+} // namespace
+
+
+// Tests that work stealing is off by default, and can be switched on and off.
+TEST(ThreadPool, UseWorkStealingIsOffByDefault)
+{
+  EXPECT_FALSE(itk::ThreadPool::GetUseWorkStealing());
+  {
+    const WorkStealingGuard guard;
+    EXPECT_TRUE(itk::ThreadPool::GetUseWorkStealing());
+  }
+  EXPECT_FALSE(itk::ThreadPool::GetUseWorkStealing());
+}
+
+
+// Tests that all jobs added with work stealing enabled are executed, and return their results.
+TEST(ThreadPool, AddWorkWithWorkStealing)
+{
+  const WorkStealingGuard guard;
+  const auto              threadPool = itk::ThreadPool::GetInstance();
+
+  constexpr int                 numberOfJobs = 1000;
+  std::vector<std::future<int>> results;
+  results.reserve(numberOfJobs);
+  for (int i = 0; i < numberOfJobs; ++i)
+  {
+    results.push_back(threadPool->AddWork([](int value) { return 2 * value; }, i));
+  }
+  for (int i = 0; i < numberOfJobs; ++i)
+  {
+    EXPECT_EQ(results[i].get(), 2 * i);
+  }
+}
+
+
+// Tests that a thread waiting for a job can execute the queued jobs itself.
+TEST(ThreadPool, RunPendingTaskEventuallyReturnsFalse)
+{
+  const WorkStealingGuard guard;
+  const auto              threadPool = itk::ThreadPool::GetInstance();
+
+  std::atomic<int> counter{ 0 };
+  auto             future = threadPool->AddWork([&counter] { ++counter; });
+  while (threadPool->RunPendingTask())
+  {
+  }
+  future.get();
+  EXPECT_EQ(counter, 1);
+}
+
+
+// Tests that parallel sections nested inside parallel sections complete, even when there are more (outer) work units
+// than pool threads, so that pool threads have to wait for jobs queued behind their own.
+TEST(ThreadPool, NestedParallelizeArrayWithWorkStealing)
+{
+  const WorkStealingGuard guard;
+
+  const auto outerThreader = itk::PoolMultiThreader::New();
+  outerThreader->SetNumberOfWorkUnits(4 * itk::ThreadPool::GetInstance()->GetMaximumNumberOfThreads());
+
+  constexpr itk::SizeValueType    outerSize = 64;
+  constexpr itk::SizeValueType    innerSize = 100;
+  std::vector<itk::SizeValueType> sums(outerSize);
+
+  outerThreader->ParallelizeArray(
+    0,
+    outerSize,
+    [&sums](itk::SizeValueType i) {
+      const auto                      innerThreader = itk::PoolMultiThreader::New();
+      std::vector<itk::SizeValueType> values(innerSize);
+      innerThreader->ParallelizeArray(
+        0, innerSize, [&values, i](itk::SizeValueType j) { values[j] = i + j; }, nullptr);
+      sums[i] = std::accumulate(values.cbegin(), values.cend(), itk::SizeValueType{});
+    },
+    nullptr);
+
+  for (itk::SizeValueType i = 0; i < outerSize; ++i)
+  {
+    EXPECT_EQ(sums[i], innerSize * i + innerSize * (innerSize - 1) / 2);
+  }
+}
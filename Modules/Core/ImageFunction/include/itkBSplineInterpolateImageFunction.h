@@ -170,6 +170,17 @@ public:
     return this->EvaluateAtContinuousIndexInternal(index, evaluateIndex, weights);
   }
 
+  /** Evaluate at a batch of continuous indices, with evaluateIndex and
+   * weights allocated once for the batch. When the indices only differ along
+   * the first dimension, the coefficients of the support region are summed
+   * along the other dimensions once for the batch, into a line along the
+   * first dimension, on which each index is interpolated with the weights of
+   * the first dimension only. The values are then equal up to rounding. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   virtual OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & x, ThreadIdType threadId) const
   {
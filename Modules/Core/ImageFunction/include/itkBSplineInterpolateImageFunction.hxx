@@ -524,6 +524,86 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Eval
   return (interpolated);
 }
 
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
+
+  if (numberOfIndices > 1 && Superclass::IndicesDifferOnlyAlongFirstDimension(indices, numberOfIndices))
+  {
+    // The support region along the first dimension, and its weights, at each index.
+    const unsigned int  supportSize = m_SplineOrder + 1;
+    std::vector<long>   firstIndices(numberOfIndices * supportSize);
+    std::vector<double> firstWeights(numberOfIndices * supportSize);
+    long                minIndex = NumericTraits<long>::max();
+    long                maxIndex = NumericTraits<long>::NonpositiveMin();
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      this->DetermineRegionOfSupport(evaluateIndex, indices[i], m_SplineOrder);
+      SetInterpolationWeights(indices[i], evaluateIndex, weights, m_SplineOrder);
+      this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+      for (unsigned int k = 0; k < supportSize; ++k)
+      {
+        firstIndices[i * supportSize + k] = evaluateIndex[0][k];
+        firstWeights[i * supportSize + k] = weights[0][k];
+        minIndex = std::min(minIndex, evaluateIndex[0][k]);
+        maxIndex = std::max(maxIndex, evaluateIndex[0][k]);
+      }
+    }
+
+    // Unless the indices are too sparse along the line, sum the coefficients
+    // along the other dimensions, whose support region and weights are those
+    // of any index.
+    const auto lineLength = static_cast<SizeValueType>(maxIndex - minIndex + 1);
+    if (lineLength <= numberOfIndices * supportSize)
+    {
+      std::vector<double> line(lineLength, 0.0);
+      IndexType           coefficientIndex;
+      coefficientIndex[0] = minIndex;
+      for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
+      {
+        if (m_PointsToIndex[p][0] != 0)
+        {
+          continue;
+        }
+        double w = 1.0;
+        for (unsigned int n = 1; n < ImageDimension; ++n)
+        {
+          const unsigned int indx = m_PointsToIndex[p][n];
+          w *= weights[n][indx];
+          coefficientIndex[n] = evaluateIndex[n][indx];
+        }
+        const CoefficientDataType * const coefficients = &m_Coefficients->GetPixel(coefficientIndex);
+        for (SizeValueType x = 0; x < lineLength; ++x)
+        {
+          line[x] += w * coefficients[x];
+        }
+      }
+
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        double interpolated = 0.0;
+        for (unsigned int k = 0; k < supportSize; ++k)
+        {
+          interpolated += firstWeights[i * supportSize + k] * line[firstIndices[i * supportSize + k] - minIndex];
+        }
+        values[i] = interpolated;
+      }
+      return;
+    }
+  }
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->EvaluateAtContinuousIndexInternal(indices[i], evaluateIndex, weights);
+  }
+}
+
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
@@ -113,6 +113,27 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a batch of continuous index positions
+   *
+   * The i-th value is the interpolated image intensity at the i-th
+   * index. No bounds checking is done. The default implementation calls
+   * EvaluateAtContinuousIndex() on each index, and is overridden by the
+   * interpolators that process a batch faster than an index at a time,
+   * without a virtual call per index.
+   *
+   * ImageFunction::IsInsideBuffer() can be used to check bounds before
+   * calling the method. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -138,6 +159,28 @@ public:
 protected:
   InterpolateImageFunction() = default;
   ~InterpolateImageFunction() override = default;
+
+  /** Whether the indices only differ along the first dimension, as those of
+   * a line of the output of ResampleImageFilter with an axis-aligned linear
+   * transform. An interpolator with separable weights may then compute the
+   * weights of the other dimensions once, and interpolate along the first
+   * dimension a line of the image already interpolated along the others. */
+  static bool
+  IndicesDifferOnlyAlongFirstDimension(const ContinuousIndexType * indices, SizeValueType numberOfIndices)
+  {
+    for (SizeValueType i = 1; i < numberOfIndices; ++i)
+    {
+      for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+      {
+        if (indices[i][dim] != indices[0][dim])
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override
   {
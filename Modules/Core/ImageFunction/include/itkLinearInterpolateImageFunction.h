@@ -104,6 +104,17 @@ public:
     return this->EvaluateOptimized(Dispatch<ImageDimension>(), index);
   }
 
+  /** Evaluate the function at a batch of ContinuousIndex positions, with
+   * the interpolation of the dimension of the image inlined. When the input
+   * is an Image of scalars and the indices only differ along the first
+   * dimension, the image is interpolated along the other dimensions once for
+   * the batch, into a line along the first dimension, on which each index is
+   * then interpolated linearly. The values are then equal up to rounding. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   SizeType
   GetRadius() const override
   {
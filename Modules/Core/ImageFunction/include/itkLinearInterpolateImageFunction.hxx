@@ -19,9 +19,12 @@
 #define itkLinearInterpolateImageFunction_hxx
 
 #include "itkConceptChecking.h"
+#include "itkImage.h"
 
 #include "itkMath.h"
 #include <algorithm> // For min and max.
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -95,6 +98,101 @@ LinearInterpolateImageFunction<TInputImage, TCoordinate>::EvaluateUnoptimized(co
   return (static_cast<OutputType>(value));
 }
 
+template <typename TInputImage, typename TCoordinate>
+void
+LinearInterpolateImageFunction<TInputImage, TCoordinate>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  if constexpr (std::is_arithmetic_v<RealType> && std::is_same_v<TInputImage, Image<InputPixelType, ImageDimension>>)
+  {
+    if (numberOfIndices > 1 && Superclass::IndicesDifferOnlyAlongFirstDimension(indices, numberOfIndices))
+    {
+      // The lower neighbor along the first dimension, and the distance to it,
+      // of each index. The distance is zero when there is no upper neighbor.
+      std::vector<IndexValueType>          lowerIndices(numberOfIndices);
+      std::vector<InternalComputationType> distances(numberOfIndices);
+      IndexValueType                       minIndex = NumericTraits<IndexValueType>::max();
+      IndexValueType                       maxIndex = NumericTraits<IndexValueType>::NonpositiveMin();
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        const IndexValueType lower = std::max(Math::Floor<IndexValueType>(indices[i][0]), this->m_StartIndex[0]);
+        const InternalComputationType distance = indices[i][0] - static_cast<InternalComputationType>(lower);
+        const bool hasUpper = distance > 0. && lower < this->m_EndIndex[0];
+        lowerIndices[i] = lower;
+        distances[i] = hasUpper ? distance : 0.;
+        minIndex = std::min(minIndex, lower);
+        maxIndex = std::max(maxIndex, hasUpper ? lower + 1 : lower);
+      }
+
+      // Unless the indices are too sparse along the line, interpolate the
+      // image along the other dimensions, whose neighbors and distances are
+      // those of any index.
+      const auto lineLength = static_cast<SizeValueType>(maxIndex - minIndex + 1);
+      if (lineLength <= 2 * numberOfIndices)
+      {
+        IndexType               lowerIndex;
+        InternalComputationType distance[ImageDimension];
+        bool                    hasUpper[ImageDimension];
+        lowerIndex[0] = minIndex;
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+          lowerIndex[dim] = std::max(Math::Floor<IndexValueType>(indices[0][dim]), this->m_StartIndex[dim]);
+          distance[dim] = indices[0][dim] - static_cast<InternalComputationType>(lowerIndex[dim]);
+          hasUpper[dim] = distance[dim] > 0. && lowerIndex[dim] < this->m_EndIndex[dim];
+        }
+
+        const TInputImage * const    inputImagePtr = this->GetInputImage();
+        const InputPixelType * const buffer = inputImagePtr->GetBufferPointer();
+        std::vector<RealType>        line(lineLength, RealType{});
+
+        constexpr unsigned int numberOfNeighbors = 1u << (ImageDimension - 1);
+        for (unsigned int counter = 0; counter < numberOfNeighbors; ++counter)
+        {
+          InternalComputationType overlap = 1.0;
+          IndexType               neighIndex(lowerIndex);
+          bool                    isNeighbor = true;
+          for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+          {
+            if (counter & (1u << (dim - 1)))
+            {
+              isNeighbor = isNeighbor && hasUpper[dim];
+              ++(neighIndex[dim]);
+              overlap *= distance[dim];
+            }
+            else if (hasUpper[dim])
+            {
+              overlap *= 1.0 - distance[dim];
+            }
+          }
+          if (!isNeighbor)
+          {
+            continue;
+          }
+          const InputPixelType * const row = buffer + inputImagePtr->ComputeOffset(neighIndex);
+          for (SizeValueType x = 0; x < lineLength; ++x)
+          {
+            line[x] += static_cast<RealType>(row[x]) * overlap;
+          }
+        }
+
+        for (SizeValueType i = 0; i < numberOfIndices; ++i)
+        {
+          const RealType * const val = &line[lowerIndices[i] - minIndex];
+          values[i] = static_cast<OutputType>(distances[i] > 0. ? val[0] + (val[1] - val[0]) * distances[i] : val[0]);
+        }
+        return;
+      }
+    }
+  }
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->EvaluateOptimized(Dispatch<ImageDimension>(), indices[i]);
+  }
+}
+
 template <typename TInputImage, typename TCoordinate>
 void
 LinearInterpolateImageFunction<TInputImage, TCoordinate>::PrintSelf(std::ostream & os, Indent indent) const
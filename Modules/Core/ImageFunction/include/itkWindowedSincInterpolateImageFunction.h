@@ -311,6 +311,17 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override;
 
+  /** Evaluate the function at a batch of ContinuousIndex positions. When the
+   * input is an Image of scalars and the indices only differ along the first
+   * dimension, the image is interpolated along the other dimensions once for
+   * the batch, into a line along the first dimension, on which each index is
+   * then interpolated with the weights of the first dimension only. The
+   * values are then equal up to rounding. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   SizeType
   GetRadius() const override
   {
@@ -344,6 +355,11 @@ private:
   /** Index into the weights array for each offset */
   unsigned int m_WeightOffsetTable[m_OffsetTableSize][ImageDimension]{};
 
+  /** Compute the weights of the window along a dimension, given the
+   * distance of the index to its floor along that dimension. */
+  void
+  ComputeWeights(double distance, double * weights) const;
+
   /** The sinc function */
   static double
   Sinc(const double x)
@@ -19,7 +19,11 @@
 #define itkWindowedSincInterpolateImageFunction_hxx
 
 
+#include "itkImage.h"
 #include "itkMath.h"
+#include <algorithm> // For minmax_element.
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -129,32 +133,7 @@ WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBou
   double xWeight[ImageDimension][2 * VRadius];
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
-    // x is the offset, hence the parameter of the kernel
-    double x = distance[dim] + VRadius;
-
-    // If distance is zero, i.e. the index falls precisely on the
-    // pixel boundary, the weights form a delta function.
-    if (distance[dim] == 0.0)
-    {
-      for (unsigned int i = 0; i < m_WindowSize; ++i)
-      {
-        xWeight[dim][i] = static_cast<int>(i) == VRadius - 1 ? 1 : 0;
-      }
-    }
-    else
-    {
-      // i is the relative offset in dimension dim.
-      for (unsigned int i = 0; i < m_WindowSize; ++i)
-      {
-        // Increment the offset, taking it through the range
-        // (dist + rad - 1, ..., dist - rad), i.e. all x
-        // such that itk::Math::abs(x) <= rad
-        x -= 1.0;
-
-        // Compute the weight for this m
-        xWeight[dim][i] = m_WindowFunction(x) * Sinc(x);
-      }
-    }
+    this->ComputeWeights(distance[dim], xWeight[dim]);
   }
 
   // Iterate over the neighborhood, taking the correct set
@@ -183,6 +162,158 @@ WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBou
   // Return the interpolated value
   return static_cast<OutputType>(xPixelValue);
 }
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordinate>
+void
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordinate>::
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+{
+  using PixelType = typename TInputImage::PixelType;
+  if constexpr (std::is_arithmetic_v<RealType> && std::is_same_v<TInputImage, Image<PixelType, ImageDimension>>)
+  {
+    // The boundary condition is applied to the buffered region by the
+    // neighborhood iterator, but to the largest possible region on its own.
+    const TInputImage * const image = this->GetInputImage();
+    if (numberOfIndices > 1 && image->GetBufferedRegion() == image->GetLargestPossibleRegion() &&
+        Superclass::IndicesDifferOnlyAlongFirstDimension(indices, numberOfIndices))
+    {
+      // The window along the first dimension, from baseIndex - VRadius + 1 to
+      // baseIndex + VRadius, and its weights, at each index.
+      std::vector<IndexValueType> baseIndices(numberOfIndices);
+      std::vector<double>         firstWeights(numberOfIndices * m_WindowSize);
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        baseIndices[i] = Math::Floor<IndexValueType>(indices[i][0]);
+        this->ComputeWeights(indices[i][0] - static_cast<double>(baseIndices[i]), &firstWeights[i * m_WindowSize]);
+      }
+      const auto [minBase, maxBase] = std::minmax_element(baseIndices.cbegin(), baseIndices.cend());
+      const IndexValueType minIndex = *minBase - static_cast<IndexValueType>(VRadius) + 1;
+      const IndexValueType maxIndex = *maxBase + static_cast<IndexValueType>(VRadius);
+
+      // Unless the indices are too sparse along the line, interpolate the
+      // image along the other dimensions, whose windows and weights are those
+      // of any index.
+      const auto lineLength = static_cast<SizeValueType>(maxIndex - minIndex + 1);
+      if (lineLength <= m_WindowSize * numberOfIndices)
+      {
+        IndexType baseIndex;
+        double    xWeight[ImageDimension][2 * VRadius];
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+          baseIndex[dim] = Math::Floor<IndexValueType>(indices[0][dim]);
+          this->ComputeWeights(indices[0][dim] - static_cast<double>(baseIndex[dim]), xWeight[dim]);
+        }
+
+        const auto &             bufferedRegion = image->GetBufferedRegion();
+        const IndexValueType     startIndex = bufferedRegion.GetIndex(0);
+        const IndexValueType     endIndex = startIndex + static_cast<IndexValueType>(bufferedRegion.GetSize(0)) - 1;
+        const bool               isLineInside = minIndex >= startIndex && maxIndex <= endIndex;
+        const PixelType * const  buffer = image->GetBufferPointer();
+        const TBoundaryCondition boundaryCondition{};
+        std::vector<RealType>    line(lineLength, RealType{});
+
+        constexpr unsigned int numberOfRows = m_OffsetTableSize / m_WindowSize;
+        for (unsigned int row = 0; row < numberOfRows; ++row)
+        {
+          // The position of the row in the window of each dimension but the first.
+          IndexType    rowIndex;
+          double       weight = 1.0;
+          unsigned int position = row;
+          rowIndex[0] = minIndex;
+          for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+          {
+            const unsigned int i = position % m_WindowSize;
+            position /= m_WindowSize;
+            rowIndex[dim] = baseIndex[dim] + static_cast<IndexValueType>(i) - static_cast<IndexValueType>(VRadius) + 1;
+            weight *= xWeight[dim][i];
+          }
+          if (weight == 0.0)
+          {
+            continue;
+          }
+
+          if (isLineInside && bufferedRegion.IsInside(rowIndex))
+          {
+            const PixelType * const pixels = buffer + image->ComputeOffset(rowIndex);
+            for (SizeValueType x = 0; x < lineLength; ++x)
+            {
+              line[x] += static_cast<RealType>(pixels[x]) * weight;
+            }
+          }
+          else
+          {
+            for (SizeValueType x = 0; x < lineLength; ++x)
+            {
+              rowIndex[0] = minIndex + static_cast<IndexValueType>(x);
+              line[x] += static_cast<RealType>(boundaryCondition.GetPixel(rowIndex, image)) * weight;
+            }
+          }
+        }
+
+        for (SizeValueType i = 0; i < numberOfIndices; ++i)
+        {
+          const RealType * const window = &line[baseIndices[i] - static_cast<IndexValueType>(VRadius) + 1 - minIndex];
+          const double * const   weights = &firstWeights[i * m_WindowSize];
+          RealType               value{};
+          for (unsigned int k = 0; k < m_WindowSize; ++k)
+          {
+            value += window[k] * weights[k];
+          }
+          values[i] = static_cast<OutputType>(value);
+        }
+        return;
+      }
+    }
+  }
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+  }
+}
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordinate>
+void
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordinate>::
+  ComputeWeights(double distance, double * weights) const
+{
+  // If distance is zero, i.e. the index falls precisely on the
+  // pixel boundary, the weights form a delta function.
+  if (distance == 0.0)
+  {
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
+    {
+      weights[i] = static_cast<int>(i) == VRadius - 1 ? 1 : 0;
+    }
+  }
+  else
+  {
+    // x is the offset, hence the parameter of the kernel
+    double x = distance + VRadius;
+
+    // i is the relative offset in dimension dim.
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
+    {
+      // Increment the offset, taking it through the range
+      // (dist + rad - 1, ..., dist - rad), i.e. all x
+      // such that itk::Math::abs(x) <= rad
+      x -= 1.0;
+
+      // Compute the weight for this m
+      weights[i] = m_WindowFunction(x) * Sinc(x);
+    }
+  }
+}
 } // namespace itk
 
 #endif
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkWindowedSincInterpolateImageFunction.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkGTest.h"
+
+#include <vector>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(itk::MakeFilled<typename TImage::SizeType>(9));
+  image->SetSpacing(itk::MakeFilled<typename TImage::SpacingType>(0.5));
+  image->Allocate();
+  unsigned int state = 12345;
+  for (auto && pixel : itk::ImageBufferRange<TImage>(*image))
+  {
+    state = state * 1103515245u + 12345u;
+    pixel = static_cast<typename TImage::PixelType>((state >> 16) % 200);
+  }
+  return image;
+}
+
+// Checks that EvaluateAtContinuousIndices gives the results of
+// EvaluateAtContinuousIndex, at continuous indices inside the image.
+template <typename TInterpolator>
+void
+ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(TInterpolator & interpolator)
+{
+  using ImageType = typename TInterpolator::InputImageType;
+  using ContinuousIndexType = typename TInterpolator::ContinuousIndexType;
+
+  const auto image = MakeImage<ImageType>();
+  interpolator.SetInputImage(image);
+
+  std::vector<ContinuousIndexType> indices(500);
+  unsigned int                     state = 6789;
+  for (auto & index : indices)
+  {
+    for (unsigned int j = 0; j < ImageType::ImageDimension; ++j)
+    {
+      state = state * 1103515245u + 12345u;
+      index[j] = 8.0 * ((state >> 8) & 0xFFFF) / 65535.0;
+    }
+  }
+  indices[0].Fill(0.0);
+  indices[1].Fill(8.0);
+
+  std::vector<typename TInterpolator::OutputType> values(indices.size());
+  interpolator.EvaluateAtContinuousIndices(indices.data(), values.data(), indices.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    ASSERT_TRUE(interpolator.IsInsideBuffer(indices[i]));
+    EXPECT_EQ(values[i], interpolator.EvaluateAtContinuousIndex(indices[i])) << "index " << indices[i];
+  }
+}
+
+// Checks that EvaluateAtContinuousIndices gives the results of
+// EvaluateAtContinuousIndex up to rounding, at continuous indices that only
+// differ along the first dimension, as those of a scan line resampled by an
+// axis-aligned transform, at fractional, integer and boundary positions.
+template <typename TInterpolator>
+void
+ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(TInterpolator & interpolator)
+{
+  using ImageType = typename TInterpolator::InputImageType;
+  using ContinuousIndexType = typename TInterpolator::ContinuousIndexType;
+
+  const auto image = MakeImage<ImageType>();
+  interpolator.SetInputImage(image);
+
+  for (const double otherIndex : { 3.37, 0.0, 5.0, 7.81, 8.0 })
+  {
+    for (const double step : { 0.23, 0.5, 1.0 })
+    {
+      std::vector<ContinuousIndexType> indices;
+      for (double firstIndex = 0.0; firstIndex <= 8.0; firstIndex += step)
+      {
+        ContinuousIndexType index;
+        index.Fill(otherIndex);
+        index[0] = firstIndex;
+        indices.push_back(index);
+      }
+
+      std::vector<typename TInterpolator::OutputType> values(indices.size());
+      interpolator.EvaluateAtContinuousIndices(indices.data(), values.data(), indices.size());
+      for (size_t i = 0; i < indices.size(); ++i)
+      {
+        EXPECT_NEAR(values[i], interpolator.EvaluateAtContinuousIndex(indices[i]), 1e-9) << "index " << indices[i];
+      }
+    }
+  }
+}
+} // namespace
+
+
+TEST(EvaluateAtContinuousIndices, LinearInterpolateImageFunction)
+{
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<unsigned char, 2>>::New());
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<float, 3>>::New());
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<short, 4>>::New());
+
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<unsigned char, 2>>::New());
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<float, 3>>::New());
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::LinearInterpolateImageFunction<itk::Image<short, 4>>::New());
+}
+
+
+TEST(EvaluateAtContinuousIndices, BSplineInterpolateImageFunction)
+{
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::BSplineInterpolateImageFunction<itk::Image<unsigned char, 2>>::New());
+
+  auto interpolator = itk::BSplineInterpolateImageFunction<itk::Image<float, 3>>::New();
+  interpolator->SetSplineOrder(2);
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(*interpolator);
+
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::BSplineInterpolateImageFunction<itk::Image<unsigned char, 2>>::New());
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(*interpolator);
+}
+
+
+TEST(EvaluateAtContinuousIndices, WindowedSincInterpolateImageFunction)
+{
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::WindowedSincInterpolateImageFunction<itk::Image<float, 3>, 2>::New());
+
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::WindowedSincInterpolateImageFunction<itk::Image<unsigned char, 2>, 3>::New());
+  ExpectEvaluateAtContinuousIndicesAlongFirstDimensionAsEvaluateAtContinuousIndex(
+    *itk::WindowedSincInterpolateImageFunction<itk::Image<float, 3>, 2>::New());
+}
+
+
+TEST(EvaluateAtContinuousIndices, NearestNeighborInterpolateImageFunction)
+{
+  ExpectEvaluateAtContinuousIndicesAsEvaluateAtContinuousIndex(
+    *itk::NearestNeighborInterpolateImageFunction<itk::Image<short, 3>>::New());
+}
@@ -146,6 +146,16 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform a batch of points, by TransformPoint() rather than by the
+   * matrix and the offset of the affine transform. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override
+  {
+    Transform<TParametersValueType, VDimension, VDimension>::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+  }
+
   /** Back transform from cartesian to azimuth-elevation.  */
   inline InputPointType
   BackTransform(const OutputPointType & point) const
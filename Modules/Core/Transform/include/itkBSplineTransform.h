@@ -238,6 +238,15 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
 
+  /** Transform a batch of points. The offsets of the coefficients of a
+   * support region are computed once for the batch, and the coefficients
+   * are read directly from their buffers. The results are those of
+   * TransformPoint(). */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
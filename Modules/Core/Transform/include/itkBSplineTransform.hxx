@@ -592,6 +592,76 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  const ImageType * const coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  // The offsets of the coefficients of a support region from its first one,
+  // in the order of the scanlines of TransformPoint().
+  const OffsetValueType *                                  offsetTable = coefficientImage->GetOffsetTable();
+  FixedArray<OffsetValueType, Superclass::NumberOfWeights> supportOffsets;
+  const ParametersValueType *                              coefficients[SpaceDimension];
+  for (unsigned int k = 0; k < Superclass::NumberOfWeights; ++k)
+  {
+    OffsetValueType offset = 0;
+    unsigned int    position = k;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      offset += static_cast<OffsetValueType>(position % (SplineOrder + 1)) * offsetTable[j];
+      position /= SplineOrder + 1;
+    }
+    supportOffsets[k] = offset;
+  }
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    const InputPointType point = inputPoints[i];
+    ContinuousIndexType  index =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(point);
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[i] = point;
+      continue;
+    }
+
+    this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+    const OffsetValueType supportOffset = coefficientImage->ComputeOffset(supportIndex);
+
+    OutputPointType outputPoint;
+    outputPoint.Fill(ScalarType{});
+    for (unsigned int k = 0; k < Superclass::NumberOfWeights; ++k)
+    {
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        outputPoint[j] += static_cast<ScalarType>(weights[k] * coefficients[j][supportOffset + supportOffsets[k]]);
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoint[j] += point[j];
+    }
+    outputPoints[i] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
@@ -70,6 +70,24 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  /* Apply in reverse queue order, in place in the output.  */
+  if (outputPoints != inputPoints)
+  {
+    std::copy(inputPoints, inputPoints + numberOfPoints, outputPoints);
+  }
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
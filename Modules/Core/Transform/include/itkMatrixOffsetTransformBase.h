@@ -394,6 +394,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform a batch of points, with the matrix and the offset kept out of
+   * the loop over the points, so that the loop may be vectorized. The results
+   * are those of TransformPoint(). */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
 
   OutputVectorType
@@ -128,6 +128,32 @@ MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimensio
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  const MatrixType       matrix = m_Matrix;
+  const OutputVectorType offset = m_Offset;
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // summed in the order of m_Matrix * point + m_Offset
+    const InputPointType point = inputPoints[i];
+    for (unsigned int r = 0; r < VOutputDimension; ++r)
+    {
+      ScalarType sum{};
+      for (unsigned int c = 0; c < VInputDimension; ++c)
+      {
+        sum += matrix[r][c] * point[c];
+      }
+      outputPoints[i][r] = sum + offset[r];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(
@@ -117,6 +117,25 @@ ScaleTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoin
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+ScaleTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                  OutputPointType *      outputPoints,
+                                                                  SizeValueType          numberOfPoints) const
+{
+  const InputPointType center = this->GetCenter();
+  const ScaleType      scale = m_Scale;
+
+  for (SizeValueType j = 0; j < numberOfPoints; ++j)
+  {
+    for (unsigned int i = 0; i < SpaceDimension; ++i)
+    {
+      outputPoints[j][i] = (inputPoints[j][i] - center[i]) * scale[i] + center[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 ScaleTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & vect) const
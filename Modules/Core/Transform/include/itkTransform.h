@@ -180,6 +180,17 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a batch of points: the i-th output point is the
+   * i-th input point transformed. The input and the output may be the same
+   * array. The default implementation calls TransformPoint() on each point,
+   * and is overridden by the transforms that process a batch faster than a
+   * point at a time, without a virtual call per point.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
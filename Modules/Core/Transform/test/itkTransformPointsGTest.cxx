@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkAzimuthElevationToCartesianTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkEuler3DTransform.h"
+#include "itkScaleTransform.h"
+#include "itkGTest.h"
+
+#include <vector>
+
+namespace
+{
+template <typename TTransform>
+std::vector<typename TTransform::InputPointType>
+MakePoints(double extent)
+{
+  std::vector<typename TTransform::InputPointType> points(1000);
+  unsigned int                                     state = 12345;
+  for (auto & point : points)
+  {
+    for (unsigned int j = 0; j < TTransform::InputSpaceDimension; ++j)
+    {
+      state = state * 1103515245u + 12345u;
+      point[j] = extent * (((state >> 8) & 0xFFFF) / 65535.0 - 0.25);
+    }
+  }
+  return points;
+}
+
+// Checks that TransformPoints gives the results of TransformPoint, into
+// another array and in place.
+template <typename TTransform>
+void
+ExpectTransformPointsAsTransformPoint(const TTransform & transform, double extent)
+{
+  const std::vector<typename TTransform::InputPointType> points = MakePoints<TTransform>(extent);
+
+  std::vector<typename TTransform::OutputPointType> outputPoints(points.size());
+  transform.TransformPoints(points.data(), outputPoints.data(), points.size());
+  std::vector<typename TTransform::OutputPointType> inPlacePoints(points.cbegin(), points.cend());
+  transform.TransformPoints(inPlacePoints.data(), inPlacePoints.data(), inPlacePoints.size());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const typename TTransform::OutputPointType expected = transform.TransformPoint(points[i]);
+    ITK_EXPECT_VECTOR_NEAR(outputPoints[i], expected, 1e-12) << "point " << i;
+    ITK_EXPECT_VECTOR_NEAR(inPlacePoints[i], expected, 1e-12) << "point " << i;
+  }
+}
+
+template <unsigned int VDimension>
+typename itk::BSplineTransform<double, VDimension, 3>::Pointer
+MakeBSplineTransform()
+{
+  using TransformType = itk::BSplineTransform<double, VDimension, 3>;
+  auto transform = TransformType::New();
+  transform->SetTransformDomainOrigin(itk::MakeFilled<typename TransformType::OriginType>(-5.0));
+  transform->SetTransformDomainPhysicalDimensions(
+    itk::MakeFilled<typename TransformType::PhysicalDimensionsType>(100.0));
+  transform->SetTransformDomainMeshSize(itk::MakeFilled<typename TransformType::MeshSizeType>(5));
+
+  typename TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.01 * ((i * 37) % 101) - 0.5;
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+} // namespace
+
+
+TEST(TransformPoints, MatrixOffsetTransforms)
+{
+  auto affine = itk::AffineTransform<double, 3>::New();
+  affine->SetCenter(itk::MakePoint(1.0, 2.0, 3.0));
+  affine->Rotate(0, 1, 0.3);
+  affine->Shear(1, 2, 0.1);
+  affine->Scale(itk::MakeVector(1.5, 0.5, 2.0));
+  affine->Translate(itk::MakeVector(-4.0, 3.0, 7.0));
+  ExpectTransformPointsAsTransformPoint(*affine, 100.0);
+
+  auto euler = itk::Euler3DTransform<float>::New();
+  euler->SetRotation(0.1f, -0.2f, 0.3f);
+  euler->SetTranslation(itk::MakeVector(1.0f, 2.0f, 3.0f));
+  ExpectTransformPointsAsTransformPoint(*euler, 100.0);
+
+  auto scale = itk::ScaleTransform<double, 2>::New();
+  scale->SetCenter(itk::MakePoint(5.0, -5.0));
+  scale->SetScale(itk::MakeFilled<itk::ScaleTransform<double, 2>::ScaleType>(1.7));
+  ExpectTransformPointsAsTransformPoint(*scale, 100.0);
+
+  // Its TransformPoint is not that of its matrix and offset.
+  auto azimuthElevation = itk::AzimuthElevationToCartesianTransform<double, 3>::New();
+  azimuthElevation->SetAzimuthElevationToCartesianParameters(1.0, 5.0, 100, 50);
+  ExpectTransformPointsAsTransformPoint(*azimuthElevation, 40.0);
+}
+
+
+TEST(TransformPoints, BSplineTransform)
+{
+  // Some of the points are outside of the domain of the transforms.
+  ExpectTransformPointsAsTransformPoint(*MakeBSplineTransform<2>(), 150.0);
+  ExpectTransformPointsAsTransformPoint(*MakeBSplineTransform<3>(), 150.0);
+  ExpectTransformPointsAsTransformPoint(*itk::BSplineTransform<double, 2, 3>::New(), 150.0);
+}
+
+
+TEST(TransformPoints, CompositeTransform)
+{
+  auto affine = itk::AffineTransform<double, 3>::New();
+  affine->Rotate(0, 2, 0.2);
+  affine->Translate(itk::MakeVector(4.0, -3.0, 1.0));
+
+  auto composite = itk::CompositeTransform<double, 3>::New();
+  composite->AddTransform(affine);
+  composite->AddTransform(MakeBSplineTransform<3>());
+  composite->AddTransform(itk::Euler3DTransform<double>::New());
+  ExpectTransformPointsAsTransformPoint(*composite, 150.0);
+
+  ExpectTransformPointsAsTransformPoint(*itk::CompositeTransform<double, 3>::New(), 150.0);
+}
@@ -26,6 +26,8 @@
 #include "itkVector.h"
 
 #include "vnl/vnl_vector.h"
+#include <array>
+#include <vector>
 
 namespace itk
 {
@@ -53,7 +55,8 @@ namespace itk
  *     intensities, input images with negative and small values (< 1) can
  *     produce poor results.
  *  2. The original authors recommend performing the bias field correction
- *      on a downsampled version of the original image.
+ *      on a downsampled version of the original image, which the filter
+ *      does internally when a ShrinkFactor greater than 1 is set.
  *  3. A binary mask or a weighted image can be supplied.  If a binary mask
  *     is specified, those voxels in the input image which correspond to the
  *     voxels in the mask image are used to estimate the bias field. If a
@@ -343,6 +346,23 @@ public:
    */
   itkGetConstMacro(ConvergenceThreshold, RealType);
 
+  /**
+   * Set the factor by which the input (and the mask and confidence images) is
+   * shrunk internally before the bias field is estimated.  The histogram
+   * sharpening and the B-spline fitting then run on the shrunk grid, and only
+   * the final bias field is reconstructed at the full resolution of the input
+   * to correct it.  This is the downsampling recommended by the original
+   * authors, without the need to reconstruct the bias field outside of the
+   * filter.  Default = 1, i.e. no shrinking.
+   */
+  itkSetClampMacro(ShrinkFactor, unsigned int, 1, NumericTraits<unsigned int>::max());
+
+  /**
+   * Get the factor by which the input is shrunk internally before the bias
+   * field is estimated.  Default = 1.
+   */
+  itkGetConstMacro(ShrinkFactor, unsigned int);
+
   /**
    * Typically, a reduced size image is used as input to the N4 filter using
    * something like itkShrinkImageFilter.  Since the output is a corrected
@@ -373,7 +393,8 @@ public:
   itkGetConstMacro(CurrentLevel, unsigned int);
 
   /**
-   * Reconstruct bias field given the control point lattice.
+   * Reconstruct bias field given the control point lattice, at the resolution
+   * of the input image.
    */
   RealImagePointer
   ReconstructBiasField(const BiasFieldControlPointLatticeType *);
@@ -402,22 +423,77 @@ private:
    * image.
    */
   void
-  SharpenImage(const RealImageType * unsharpenedImage, RealImageType * sharpenedImage) const;
+  SharpenImage(const RealImageType * unsharpenedImage,
+               const RealImageType * weightImage,
+               RealImageType *       sharpenedImage) const;
+
+  /**
+   * The values of the B-spline basis functions at the samples of one
+   * dimension of a grid: for each sample, the first control point whose
+   * basis function is nonzero there, and the SplineOrder + 1 values of the
+   * basis functions of that control point and of the ones after it.  These
+   * are computed once per fitting level, since the B-spline approximation
+   * of Lee et al. only depends on them and on the point weights, and so may
+   * be evaluated one dimension at a time on the grid of the image.
+   */
+  struct BasisFunctionTable
+  {
+    SizeValueType              m_NumberOfControlPoints{ 0 };
+    std::vector<SizeValueType> m_FirstControlPoint{};
+    std::vector<double>        m_Values{};
+    std::vector<double>        m_SquaredValues{};
+    std::vector<double>        m_FittingValues{};
+  };
+  using BasisFunctionTablesType = std::array<BasisFunctionTable, ImageDimension>;
+
+  BasisFunctionTablesType
+  MakeBasisFunctionTables(const typename RealImageType::SizeType & gridSize,
+                          const ArrayType &                        numberOfControlPoints) const;
+
+  /**
+   * Sum the weights of the samples of the grid, multiplied by the sample
+   * values if any, into the control points whose basis functions overlap them,
+   * one dimension at a time.  The fitting values of the basis functions are
+   * used with sample values, and their squared values otherwise.
+   */
+  std::vector<double>
+  AccumulateOntoLattice(const RealImageType *           weightImage,
+                        const RealImageType *           valueImage,
+                        const BasisFunctionTablesType & tables) const;
+
+  /**
+   * Evaluate the B-spline defined by the control point lattice at the
+   * samples of the grid of the field, one dimension at a time.
+   */
+  void
+  EvaluateLattice(const BiasFieldControlPointLatticeType * lattice,
+                  const BasisFunctionTablesType &          tables,
+                  RealImageType *                          field) const;
 
   /**
    * Given the unsmoothed estimate of the bias field, this function smooths
    * the estimate and adds the resulting control point values to the total
-   * bias field estimate.
+   * bias field estimate.  The sum of the squared basis functions weighted by
+   * the point weights, which does not change during a fitting level, is
+   * passed by the caller.
    */
   RealImagePointer
-  UpdateBiasFieldEstimate(RealImageType *, size_t);
+  UpdateBiasFieldEstimate(const RealImageType *           fieldEstimate,
+                          const RealImageType *           weightImage,
+                          const BasisFunctionTablesType & tables,
+                          const std::vector<double> &     omegaLattice);
 
   /**
    * Convergence is determined by the coefficient of variation of the difference
    * image between the current bias field estimate and the previous estimate.
    */
   RealType
-  CalculateConvergenceMeasurement(const RealImageType *, const RealImageType *) const;
+  CalculateConvergenceMeasurement(const RealImageType *, const RealImageType *, const RealImageType *) const;
+
+  // The number of pixels per chunk of the loops over the pixels that are split
+  // among threads.  Being independent of the number of threads, the results of
+  // the loops that sum over pixels are too.
+  static constexpr SizeValueType PixelChunkSize = SizeValueType{ 1 } << 16;
 
   MaskPixelType m_MaskLabel{};
   bool          m_UseMaskLabel{ false };
@@ -435,6 +511,7 @@ private:
   RealType              m_ConvergenceThreshold{ static_cast<RealType>(0.001) };
   RealType              m_CurrentConvergenceMeasurement{};
   unsigned int          m_CurrentLevel{ 0 };
+  unsigned int          m_ShrinkFactor{ 1 };
 
   // B-spline fitting parameters
 
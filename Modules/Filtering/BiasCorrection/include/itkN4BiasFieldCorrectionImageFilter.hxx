@@ -19,18 +19,16 @@
 #define itkN4BiasFieldCorrectionImageFilter_hxx
 
 
-#include "itkAddImageFilter.h"
 #include "itkBSplineControlPointImageFilter.h"
+#include "itkCoxDeBoorBSplineKernelFunction.h"
 #include "itkDivideImageFilter.h"
 #include "itkExpImageFilter.h"
 #include "itkImageBufferRange.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
+#include "itkShrinkImageFilter.h"
 #include "itkSubtractImageFilter.h"
-#include "itkVectorIndexSelectionCastImageFilter.h"
 
 ITK_GCC_PRAGMA_PUSH
 ITK_GCC_SUPPRESS_Wfloat_equal
@@ -109,7 +107,9 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     itkExceptionMacro("If a confidence image is specified, its size should be equal to the input image size");
   }
 
-  // Calculate the log of the input image.
+  // Calculate the log of the input image, and the weight of each pixel in the
+  // estimation of the bias field: zero for the pixels that are excluded by
+  // the mask or the confidence image, and the confidence otherwise.
   const RealImagePointer logInputImage = RealImageType::New();
   logInputImage->CopyInformation(inputImage);
   logInputImage->SetRegions(inputRegion);
@@ -117,38 +117,77 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
 
   ImageAlgorithm::Copy(inputImage, logInputImage.GetPointer(), inputRegion, inputRegion);
 
+  RealImagePointer weightImage = RealImageType::New();
+  weightImage->CopyInformation(inputImage);
+  weightImage->SetRegions(inputRegion);
+  weightImage->Allocate(false);
+
   const auto          maskImageBufferRange = MakeImageBufferRange(maskImage);
   const auto          confidenceImageBufferRange = MakeImageBufferRange(confidenceImage);
   const MaskPixelType maskLabel = this->GetMaskLabel();
   const bool          useMaskLabel = this->GetUseMaskLabel();
 
   const ImageBufferRange logInputImageBufferRange{ *logInputImage };
+  const ImageBufferRange weightImageBufferRange{ *weightImage };
   const size_t           numberOfPixels = logInputImageBufferRange.size();
 
-  // Number of pixels of the input image that are included with the filter.
-  size_t numberOfIncludedPixels = 0;
-
   for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
   {
     if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
          (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
         (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
     {
-      ++numberOfIncludedPixels;
       auto && logInputPixel = logInputImageBufferRange[indexValue];
 
       if (logInputPixel > typename InputImageType::PixelType{})
       {
         logInputPixel = std::log(static_cast<RealType>(logInputPixel));
       }
+      weightImageBufferRange[indexValue] = confidenceImageBufferRange.empty()
+                                             ? RealType{ 1 }
+                                             : static_cast<RealType>(confidenceImageBufferRange[indexValue]);
+    }
+    else
+    {
+      weightImageBufferRange[indexValue] = RealType{};
     }
   }
 
-  // Duplicate logInputImage since we reuse the original at each iteration.
+  // The bias field is estimated on the grid of the input, unless it is shrunk.
+
+  RealImagePointer logFittingImage = logInputImage;
+  if (this->m_ShrinkFactor > 1)
+  {
+    using ShrinkerType = ShrinkImageFilter<RealImageType, RealImageType>;
+    typename ShrinkerType::ShrinkFactorsType shrinkFactors;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      shrinkFactors[d] = std::min(this->m_ShrinkFactor, static_cast<unsigned int>(inputImageSize[d]));
+    }
+
+    auto inputShrinker = ShrinkerType::New();
+    inputShrinker->SetInput(logInputImage);
+    inputShrinker->SetShrinkFactors(shrinkFactors);
+    inputShrinker->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    inputShrinker->Update();
+    logFittingImage = inputShrinker->GetOutput();
+    logFittingImage->DisconnectPipeline();
+
+    auto weightShrinker = ShrinkerType::New();
+    weightShrinker->SetInput(weightImage);
+    weightShrinker->SetShrinkFactors(shrinkFactors);
+    weightShrinker->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    weightShrinker->Update();
+    weightImage = weightShrinker->GetOutput();
+    weightImage->DisconnectPipeline();
+  }
+  const typename RealImageType::RegionType fittingRegion = logFittingImage->GetBufferedRegion();
+
+  // Duplicate logFittingImage since we reuse the original at each iteration.
 
   using DuplicatorType = ImageDuplicator<RealImageType>;
   auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(logInputImage);
+  duplicator->SetInputImage(logFittingImage);
   duplicator->Update();
 
   RealImagePointer logUncorrectedImage = duplicator->GetOutput();
@@ -156,13 +195,13 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
   // Provide an initial log bias field of zeros
 
   RealImagePointer logBiasField = RealImageType::New();
-  logBiasField->CopyInformation(inputImage);
-  logBiasField->SetRegions(inputImage->GetLargestPossibleRegion());
+  logBiasField->CopyInformation(logFittingImage);
+  logBiasField->SetRegions(fittingRegion);
   logBiasField->AllocateInitialized();
 
   const RealImagePointer logSharpenedImage = RealImageType::New();
-  logSharpenedImage->CopyInformation(inputImage);
-  logSharpenedImage->SetRegions(inputImage->GetLargestPossibleRegion());
+  logSharpenedImage->CopyInformation(logFittingImage);
+  logSharpenedImage->SetRegions(fittingRegion);
   logSharpenedImage->Allocate(false);
 
   // Iterate until convergence or iterative exhaustion.
@@ -179,22 +218,39 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     itkExceptionMacro("Number of iteration levels is not equal to the max number of levels.");
   }
 
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   for (this->m_CurrentLevel = 0; this->m_CurrentLevel < maximumNumberOfLevels; this->m_CurrentLevel++)
   {
     IterationReporter reporter(this, 0, 1);
 
+    // The basis functions and the weights of the control points only depend
+    // on the size of the control point lattice, which is fixed during a level.
+    ArrayType numberOfControlPoints = this->m_NumberOfControlPoints;
+    if (this->m_LogBiasFieldControlPointLattice)
+    {
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        numberOfControlPoints[d] = this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion().GetSize()[d];
+      }
+    }
+    const BasisFunctionTablesType tables =
+      this->MakeBasisFunctionTables(fittingRegion.GetSize(), numberOfControlPoints);
+    const std::vector<double> omegaLattice = this->AccumulateOntoLattice(weightImage, nullptr, tables);
+
     this->m_ElapsedIterations = 0;
     this->m_CurrentConvergenceMeasurement = NumericTraits<RealType>::max();
     while (this->m_ElapsedIterations++ < this->m_MaximumNumberOfIterations[this->m_CurrentLevel] &&
            this->m_CurrentConvergenceMeasurement > this->m_ConvergenceThreshold)
     {
       // Sharpen the current estimate of the uncorrected image.
-      this->SharpenImage(logUncorrectedImage, logSharpenedImage);
+      this->SharpenImage(logUncorrectedImage, weightImage, logSharpenedImage);
 
       using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
       auto subtracter1 = SubtracterType::New();
       subtracter1->SetInput1(logUncorrectedImage);
       subtracter1->SetInput2(logSharpenedImage);
+      subtracter1->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
       const RealImagePointer residualBiasField = subtracter1->GetOutput();
       residualBiasField->Update();
@@ -202,14 +258,17 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
       // Smooth the residual bias field estimate and add the resulting
       // control point grid to get the new total bias field estimate.
 
-      const RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixels);
+      const RealImagePointer newLogBiasField =
+        this->UpdateBiasFieldEstimate(residualBiasField, weightImage, tables, omegaLattice);
 
-      this->m_CurrentConvergenceMeasurement = this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField);
+      this->m_CurrentConvergenceMeasurement =
+        this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField, weightImage);
       logBiasField = newLogBiasField;
 
       auto subtracter2 = SubtracterType::New();
-      subtracter2->SetInput1(logInputImage);
+      subtracter2->SetInput1(logFittingImage);
       subtracter2->SetInput2(logBiasField);
+      subtracter2->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
       logUncorrectedImage = subtracter2->GetOutput();
       logUncorrectedImage->Update();
@@ -225,8 +284,9 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     reconstructer->SetDirection(logBiasField->GetDirection());
     reconstructer->SetSize(logBiasField->GetLargestPossibleRegion().GetSize());
     reconstructer->SetSplineOrder(this->m_SplineOrder);
-    reconstructer->Update();
 
+    // Only the refinement of the lattice is needed, not the reconstruction of
+    // the bias field, which is already known.
     auto numberOfLevels = MakeFilled<typename BSplineReconstructerType::ArrayType>(1);
     for (unsigned int d = 0; d < ImageDimension; ++d)
     {
@@ -239,6 +299,13 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     this->m_LogBiasFieldControlPointLattice = reconstructer->RefineControlPointLattice(numberOfLevels);
   }
 
+  // The bias field that is estimated on a shrunk grid corrects the input at
+  // its full resolution.
+  if (logFittingImage != logInputImage)
+  {
+    logBiasField = this->ReconstructBiasField(this->m_LogBiasFieldControlPointLattice);
+  }
+
   using CustomBinaryFilter = itk::BinaryGeneratorImageFilter<InputImageType, RealImageType, OutputImageType>;
   auto expAndDivFilter = CustomBinaryFilter::New();
   auto expAndDivLambda = [](const typename InputImageType::PixelType & input,
@@ -258,69 +325,88 @@ template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::SharpenImage(
   const RealImageType * unsharpenedImage,
+  const RealImageType * weightImage,
   RealImageType *       sharpenedImage) const
 {
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
   // Build the histogram for the uncorrected image.  Store copy
   // in a vnl_vector to utilize vnl FFT routines.  Note that variables
   // in real space are denoted by a single uppercase letter whereas their
   // frequency counterparts are indicated by a trailing lowercase 'f'.
+  // The pixels are split among threads by chunks, whose ranges and
+  // histograms are then merged.
+
+  const RealType * const unsharpenedBuffer = unsharpenedImage->GetBufferPointer();
+  const RealType * const weightBuffer = weightImage->GetBufferPointer();
+  const SizeValueType    numberOfPixels = unsharpenedImage->GetBufferedRegion().GetNumberOfPixels();
+  const SizeValueType    numberOfChunks = (numberOfPixels + PixelChunkSize - 1) / PixelChunkSize;
+  MultiThreaderBase *    multiThreader = this->GetMultiThreader();
+
+  std::vector<RealType> chunkMaxima(numberOfChunks, NumericTraits<RealType>::NonpositiveMin());
+  std::vector<RealType> chunkMinima(numberOfChunks, NumericTraits<RealType>::max());
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const SizeValueType end = std::min(numberOfPixels, (chunk + 1) * PixelChunkSize);
+      for (SizeValueType indexValue = chunk * PixelChunkSize; indexValue < end; ++indexValue)
+      {
+        if (weightBuffer[indexValue] > RealType{})
+        {
+          chunkMaxima[chunk] = std::max(chunkMaxima[chunk], unsharpenedBuffer[indexValue]);
+          chunkMinima[chunk] = std::min(chunkMinima[chunk], unsharpenedBuffer[indexValue]);
+        }
+      }
+    },
+    nullptr);
 
   RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
   RealType binMinimum = NumericTraits<RealType>::max();
-
-  const auto   unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-  const size_t numberOfPixels = unsharpenedImageBufferRange.size();
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
-      if (pixel > binMaximum)
-      {
-        binMaximum = pixel;
-      }
-      else if (pixel < binMinimum)
-      {
-        binMinimum = pixel;
-      }
-    }
+    binMaximum = std::max(binMaximum, chunkMaxima[chunk]);
+    binMinimum = std::min(binMinimum, chunkMinima[chunk]);
   }
   const RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
 
   // Create the intensity profile (within the masked region, if applicable)
   // using a triangular parzen windowing scheme.
 
-  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  const unsigned int    numberOfHistogramBins = this->m_NumberOfHistogramBins;
+  std::vector<RealType> chunkHistograms(numberOfChunks * numberOfHistogramBins, RealType{});
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      RealType * const    chunkHistogram = chunkHistograms.data() + chunk * numberOfHistogramBins;
+      const SizeValueType end = std::min(numberOfPixels, (chunk + 1) * PixelChunkSize);
+      for (SizeValueType indexValue = chunk * PixelChunkSize; indexValue < end; ++indexValue)
+      {
+        if (weightBuffer[indexValue] > RealType{})
+        {
+          const RealType     cidx = (unsharpenedBuffer[indexValue] - binMinimum) / histogramSlope;
+          const unsigned int idx = itk::Math::floor(cidx);
+          const RealType     offset = cidx - static_cast<RealType>(idx);
+
+          if (offset == 0.0)
+          {
+            chunkHistogram[idx] += 1.0;
+          }
+          else if (idx < numberOfHistogramBins - 1)
+          {
+            chunkHistogram[idx] += 1.0 - offset;
+            chunkHistogram[idx + 1] += offset;
+          }
+        }
+      }
+    },
+    nullptr);
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    for (unsigned int n = 0; n < numberOfHistogramBins; ++n)
     {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
-
-      const RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
-      const RealType     offset = cidx - static_cast<RealType>(idx);
-
-      if (offset == 0.0)
-      {
-        H[idx] += 1.0;
-      }
-      else if (idx < this->m_NumberOfHistogramBins - 1)
-      {
-        H[idx] += 1.0 - offset;
-        H[idx + 1] += offset;
-      }
+      H[n] += chunkHistograms[chunk * numberOfHistogramBins + n];
     }
   }
 
@@ -445,163 +531,351 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Sharpen
   E = E.extract(this->m_NumberOfHistogramBins, histogramOffset);
 
   // Sharpen the image with the new mapping, E(u|v)
-  sharpenedImage->FillBuffer(0);
+  RealType * const sharpenedBuffer = sharpenedImage->GetBufferPointer();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const SizeValueType end = std::min(numberOfPixels, (chunk + 1) * PixelChunkSize);
+      for (SizeValueType indexValue = chunk * PixelChunkSize; indexValue < end; ++indexValue)
+      {
+        RealType correctedPixel = 0;
+        if (weightBuffer[indexValue] > RealType{})
+        {
+          const RealType     cidx = (unsharpenedBuffer[indexValue] - binMinimum) / histogramSlope;
+          const unsigned int idx = itk::Math::floor(cidx);
+
+          if (idx < E.size() - 1)
+          {
+            correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+          }
+          else
+          {
+            correctedPixel = E.back();
+          }
+        }
+        sharpenedBuffer[indexValue] = correctedPixel;
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::MakeBasisFunctionTables(
+  const typename RealImageType::SizeType & gridSize,
+  const ArrayType &                        numberOfControlPoints) const -> BasisFunctionTablesType
+{
+  using KernelType = CoxDeBoorBSplineKernelFunction<3>;
+  auto kernel = KernelType::New();
+  kernel->SetSplineOrder(this->m_SplineOrder);
 
-  const ImageBufferRange sharpenedImageBufferRange{ *sharpenedImage };
+  const unsigned int numberOfBasisFunctions = this->m_SplineOrder + 1;
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  BasisFunctionTablesType tables;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    if (numberOfControlPoints[d] < numberOfBasisFunctions)
     {
-      const RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
+      itkExceptionMacro("The number of control points must be greater than the spline order.");
+    }
 
-      RealType correctedPixel = 0;
-      if (idx < E.size() - 1)
+    // The samples are mapped onto the parametric domain [0, numberOfSpans) of
+    // the B-spline as BSplineScatteredDataPointSetToImageFilter and
+    // BSplineControlPointImageFilter do, the last sample being moved inside.
+    const auto   numberOfSpans = static_cast<double>(numberOfControlPoints[d] - this->m_SplineOrder);
+    const double r = gridSize[d] > 1 ? numberOfSpans / static_cast<double>(gridSize[d] - 1) : 0.0;
+    const double epsilon = r * 1e-3;
+
+    BasisFunctionTable & table = tables[d];
+    table.m_NumberOfControlPoints = numberOfControlPoints[d];
+    table.m_FirstControlPoint.resize(gridSize[d]);
+    table.m_Values.resize(gridSize[d] * numberOfBasisFunctions);
+    table.m_SquaredValues.resize(gridSize[d] * numberOfBasisFunctions);
+    table.m_FittingValues.resize(gridSize[d] * numberOfBasisFunctions);
+
+    for (SizeValueType i = 0; i < gridSize[d]; ++i)
+    {
+      double u = r * static_cast<double>(i);
+      if (itk::Math::abs(u - numberOfSpans) <= epsilon)
       {
-        correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+        u = numberOfSpans - epsilon;
       }
-      else
+      const auto first = static_cast<SizeValueType>(u);
+      table.m_FirstControlPoint[i] = first;
+
+      double * const values = table.m_Values.data() + i * numberOfBasisFunctions;
+      double         sumOfSquares = 0.0;
+      for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
       {
-        correctedPixel = E.back();
+        values[j] = kernel->Evaluate(u - static_cast<double>(first + j) +
+                                     0.5 * (static_cast<double>(this->m_SplineOrder) - 1.0));
+        sumOfSquares += values[j] * values[j];
+      }
+      for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
+      {
+        table.m_SquaredValues[i * numberOfBasisFunctions + j] = values[j] * values[j];
+        table.m_FittingValues[i * numberOfBasisFunctions + j] = values[j] * values[j] * values[j] / sumOfSquares;
       }
-      sharpenedImageBufferRange[indexValue] = correctedPixel;
     }
   }
+  return tables;
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
-  RealImageType * fieldEstimate,
-  const size_t    numberOfIncludedPixels)
+std::vector<double>
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::AccumulateOntoLattice(
+  const RealImageType *           weightImage,
+  const RealImageType *           valueImage,
+  const BasisFunctionTablesType & tables) const
 {
-  // Temporarily set the direction cosine to identity since the B-spline
-  // approximation algorithm works in parametric space and not physical
-  // space.
-  typename ScalarImageType::DirectionType identity;
-  identity.SetIdentity();
-
-  const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-  const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
-  const bool                                   filterHandlesMemory = false;
-
-  using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-  auto importer = ImporterType::New();
-  importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
-  importer->SetRegion(fieldEstimate->GetBufferedRegion());
-  importer->SetOrigin(fieldEstimate->GetOrigin());
-  importer->SetSpacing(fieldEstimate->GetSpacing());
-  importer->SetDirection(identity);
-  importer->Update();
-
-  const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-  const PointSetPointer fieldPoints = PointSetType::New();
-  auto &                pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-  pointSTLContainer.reserve(numberOfIncludedPixels);
-  auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-  pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-  auto   weights = BSplineFilterType::WeightsContainerType::New();
-  auto & weightSTLContainer = weights->CastToSTLContainer();
-  weightSTLContainer.reserve(numberOfIncludedPixels);
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                      parametricFieldEstimate->GetRequestedRegion());
+  const unsigned int     numberOfBasisFunctions = this->m_SplineOrder + 1;
+  const RealType * const weights = weightImage->GetBufferPointer();
+  const RealType * const values = valueImage != nullptr ? valueImage->GetBufferPointer() : nullptr;
+
+  // The extent of the summed array along each dimension: the number of control
+  // points along the dimensions that are already summed, and the number of
+  // samples along the others.
+  std::array<SizeValueType, ImageDimension> extent;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    extent[d] = tables[d].m_FirstControlPoint.size();
+  }
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
+  std::vector<double> lattice;
+  std::vector<double> summed;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    const BasisFunctionTable &  table = tables[d];
+    const std::vector<double> & basisValues = values != nullptr ? table.m_FittingValues : table.m_SquaredValues;
+    const SizeValueType         numberOfSamples = extent[d];
+    const SizeValueType         numberOfControlPoints = table.m_NumberOfControlPoints;
+
+    SizeValueType inner = 1;
+    for (unsigned int e = 0; e < d; ++e)
+    {
+      inner *= extent[e];
+    }
+    SizeValueType outer = 1;
+    for (unsigned int e = d + 1; e < ImageDimension; ++e)
     {
-      PointType point;
-      parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+      outer *= extent[e];
+    }
 
-      ScalarType scalar;
-      scalar[0] = It.Get();
+    summed.assign(inner * numberOfControlPoints * outer, 0.0);
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      outer,
+      [&](SizeValueType o) {
+        double * const summedLine = summed.data() + o * numberOfControlPoints * inner;
+        for (SizeValueType s = 0; s < numberOfSamples; ++s)
+        {
+          const double * const basis = basisValues.data() + s * numberOfBasisFunctions;
+          double * const       out = summedLine + table.m_FirstControlPoint[s] * inner;
+          if (d == 0)
+          {
+            const SizeValueType indexValue = o * numberOfSamples + s;
+            if (weights[indexValue] == RealType{})
+            {
+              continue;
+            }
+            const double value =
+              values != nullptr ? static_cast<double>(weights[indexValue]) * values[indexValue] : weights[indexValue];
+            for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
+            {
+              out[j] += basis[j] * value;
+            }
+          }
+          else
+          {
+            const double * const in = lattice.data() + (o * numberOfSamples + s) * inner;
+            for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
+            {
+              for (SizeValueType e = 0; e < inner; ++e)
+              {
+                out[j * inner + e] += basis[j] * in[e];
+              }
+            }
+          }
+        }
+      },
+      nullptr);
+
+    lattice.swap(summed);
+    extent[d] = numberOfControlPoints;
+  }
+  return lattice;
+}
 
-      pointDataSTLContainer.push_back(scalar);
-      pointSTLContainer.push_back(point);
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::EvaluateLattice(
+  const BiasFieldControlPointLatticeType * lattice,
+  const BasisFunctionTablesType &          tables,
+  RealImageType *                          field) const
+{
+  const unsigned int numberOfBasisFunctions = this->m_SplineOrder + 1;
 
-      RealType confidenceWeight = 1.0;
-      if (!confidenceImageBufferRange.empty())
-      {
-        confidenceWeight = confidenceImageBufferRange[indexValue];
-      }
-      weightSTLContainer.push_back(confidenceWeight);
-    }
+  // The extent of the evaluated array along each dimension: the number of
+  // samples along the dimensions that are already evaluated, and the number
+  // of control points along the others.
+  std::array<SizeValueType, ImageDimension> extent;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    extent[d] = lattice->GetLargestPossibleRegion().GetSize()[d];
   }
 
-  auto bspliner = BSplineFilterType::New();
+  const SizeValueType      numberOfControlPoints = lattice->GetLargestPossibleRegion().GetNumberOfPixels();
+  const ScalarType * const latticeBuffer = lattice->GetBufferPointer();
+  std::vector<double>      controlPoints(numberOfControlPoints);
+  for (SizeValueType n = 0; n < numberOfControlPoints; ++n)
+  {
+    controlPoints[n] = latticeBuffer[n][0];
+  }
 
-  typename BSplineFilterType::ArrayType numberOfControlPoints;
-  auto                                  numberOfFittingLevels = MakeFilled<typename BSplineFilterType::ArrayType>(1);
-  for (unsigned int d = 0; d < ImageDimension; ++d)
+  RealType * const    fieldBuffer = field->GetBufferPointer();
+  std::vector<double> evaluated;
+  for (int d = ImageDimension - 1; d >= 0; --d)
   {
-    if (!this->m_LogBiasFieldControlPointLattice)
+    const BasisFunctionTable & table = tables[d];
+    const SizeValueType        numberOfSamples = table.m_FirstControlPoint.size();
+    const SizeValueType        numberOfLatticePoints = extent[d];
+
+    SizeValueType inner = 1;
+    for (int e = 0; e < d; ++e)
     {
-      numberOfControlPoints[d] = this->m_NumberOfControlPoints[d];
+      inner *= extent[e];
     }
-    else
+    SizeValueType outer = 1;
+    for (int e = d + 1; e < static_cast<int>(ImageDimension); ++e)
+    {
+      outer *= extent[e];
+    }
+
+    if (d > 0)
+    {
+      evaluated.assign(inner * numberOfSamples * outer, 0.0);
+    }
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      outer,
+      [&](SizeValueType o) {
+        for (SizeValueType s = 0; s < numberOfSamples; ++s)
+        {
+          const double * const basis = table.m_Values.data() + s * numberOfBasisFunctions;
+          const double * const in =
+            controlPoints.data() + (o * numberOfLatticePoints + table.m_FirstControlPoint[s]) * inner;
+          if (d == 0)
+          {
+            double value = 0.0;
+            for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
+            {
+              value += basis[j] * in[j];
+            }
+            fieldBuffer[o * numberOfSamples + s] = static_cast<RealType>(value);
+          }
+          else
+          {
+            double * const out = evaluated.data() + (o * numberOfSamples + s) * inner;
+            for (unsigned int j = 0; j < numberOfBasisFunctions; ++j)
+            {
+              for (SizeValueType e = 0; e < inner; ++e)
+              {
+                out[e] += basis[j] * in[j * inner + e];
+              }
+            }
+          }
+        }
+      },
+      nullptr);
+
+    if (d > 0)
     {
-      numberOfControlPoints[d] = this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion().GetSize()[d];
+      controlPoints.swap(evaluated);
+      extent[d] = numberOfSamples;
     }
   }
+}
 
-  typename ScalarImageType::PointType parametricOrigin = fieldEstimate->GetOrigin();
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
+  const RealImageType *           fieldEstimate,
+  const RealImageType *           weightImage,
+  const BasisFunctionTablesType & tables,
+  const std::vector<double> &     omegaLattice)
+{
+  // Fit the B-spline approximation of Lee et al. to the field estimate over
+  // the included pixels, as BSplineScatteredDataPointSetToImageFilter does
+  // with one fitting level.  Since the pixels lie on a grid, the sums over the
+  // pixels of the products of their values, their weights and the basis
+  // functions are separable.
+
+  const std::vector<double> deltaLattice = this->AccumulateOntoLattice(weightImage, fieldEstimate, tables);
+
+  typename BiasFieldControlPointLatticeType::SizeType latticeSize;
   for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    parametricOrigin[d] += (fieldEstimate->GetSpacing()[d] * fieldEstimate->GetLargestPossibleRegion().GetIndex()[d]);
+    latticeSize[d] = tables[d].m_NumberOfControlPoints;
   }
-  bspliner->SetOrigin(parametricOrigin);
-  bspliner->SetSpacing(fieldEstimate->GetSpacing());
-  bspliner->SetSize(fieldEstimate->GetLargestPossibleRegion().GetSize());
-  bspliner->SetDirection(fieldEstimate->GetDirection());
-  bspliner->SetGenerateOutputImage(false);
-  bspliner->SetNumberOfLevels(numberOfFittingLevels);
-  bspliner->SetSplineOrder(this->m_SplineOrder);
-  bspliner->SetNumberOfControlPoints(numberOfControlPoints);
-  bspliner->SetInput(fieldPoints);
-  bspliner->SetPointWeights(weights);
-  bspliner->Update();
-
-  const typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
-
-  // Add the bias field control points to the current estimate.
 
+  const typename BiasFieldControlPointLatticeType::Pointer lattice = BiasFieldControlPointLatticeType::New();
   if (!this->m_LogBiasFieldControlPointLattice)
   {
-    this->m_LogBiasFieldControlPointLattice = phiLattice;
+    // Specify the parametric domain of the lattice in physical space as
+    // BSplineScatteredDataPointSetToImageFilter does.
+    const typename RealImageType::RegionType & largestRegion = fieldEstimate->GetLargestPossibleRegion();
+
+    typename BiasFieldControlPointLatticeType::PointType   origin;
+    typename BiasFieldControlPointLatticeType::SpacingType spacing;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const RealType domain = fieldEstimate->GetSpacing()[d] * static_cast<RealType>(largestRegion.GetSize()[d] - 1);
+      spacing[d] = domain / static_cast<RealType>(latticeSize[d] - this->m_SplineOrder);
+      origin[d] = -0.5 * spacing[d] * (static_cast<RealType>(this->m_SplineOrder) - 1);
+    }
+    origin = fieldEstimate->GetDirection() * origin;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      origin[d] += fieldEstimate->GetOrigin()[d] + fieldEstimate->GetSpacing()[d] * largestRegion.GetIndex()[d];
+    }
+    lattice->SetOrigin(origin);
+    lattice->SetSpacing(spacing);
+    lattice->SetDirection(fieldEstimate->GetDirection());
   }
   else
   {
-    // Ensure that the two lattices occupy the same physical space.  Not
-    // necessary for performance since the parameters of the reconstructed
-    // bias field are specified later in this function in the reconstructer.
-    phiLattice->CopyInformation(this->m_LogBiasFieldControlPointLattice);
+    lattice->CopyInformation(this->m_LogBiasFieldControlPointLattice);
+  }
+  lattice->SetRegions(latticeSize);
+  lattice->Allocate(false);
 
-    using AdderType = AddImageFilter<BiasFieldControlPointLatticeType,
-                                     BiasFieldControlPointLatticeType,
-                                     BiasFieldControlPointLatticeType>;
-    auto adder = AdderType::New();
-    adder->SetInput1(this->m_LogBiasFieldControlPointLattice);
-    adder->SetInput2(phiLattice);
-    adder->Update();
+  // Add the bias field control points to the current estimate.
 
-    this->m_LogBiasFieldControlPointLattice = adder->GetOutput();
+  const ScalarType * const previousLatticeBuffer =
+    this->m_LogBiasFieldControlPointLattice ? this->m_LogBiasFieldControlPointLattice->GetBufferPointer() : nullptr;
+  ScalarType * const  latticeBuffer = lattice->GetBufferPointer();
+  const SizeValueType numberOfLatticePoints = omegaLattice.size();
+  for (SizeValueType n = 0; n < numberOfLatticePoints; ++n)
+  {
+    RealType phi{};
+    if (Math::NotAlmostEquals(static_cast<RealType>(omegaLattice[n]), RealType{}))
+    {
+      phi = static_cast<RealType>(deltaLattice[n] / omegaLattice[n]);
+      if (itk::Math::isnan(phi) || itk::Math::isinf(phi))
+      {
+        phi = RealType{};
+      }
+    }
+    latticeBuffer[n][0] = (previousLatticeBuffer != nullptr ? previousLatticeBuffer[n][0] : RealType{}) + phi;
   }
+  this->m_LogBiasFieldControlPointLattice = lattice;
 
-  RealImagePointer smoothField = this->ReconstructBiasField(this->m_LogBiasFieldControlPointLattice);
-  smoothField->SetRegions(this->GetInput()->GetRequestedRegion());
+  const RealImagePointer smoothField = RealImageType::New();
+  smoothField->CopyInformation(fieldEstimate);
+  smoothField->SetRegions(fieldEstimate->GetBufferedRegion());
+  smoothField->Allocate(false);
+  this->EvaluateLattice(lattice, tables, smoothField);
   return smoothField;
 }
 
@@ -612,28 +886,22 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Reconst
 {
   const InputImageType * inputImage = this->GetInput();
 
-  using BSplineReconstructerType = BSplineControlPointImageFilter<BiasFieldControlPointLatticeType, ScalarImageType>;
-  auto reconstructer = BSplineReconstructerType::New();
-  reconstructer->SetInput(controlPointLattice);
-  reconstructer->SetOrigin(inputImage->GetOrigin());
-  reconstructer->SetSpacing(inputImage->GetSpacing());
-  reconstructer->SetDirection(inputImage->GetDirection());
-  reconstructer->SetSplineOrder(this->m_SplineOrder);
-  reconstructer->SetSize(inputImage->GetLargestPossibleRegion().GetSize());
-
-  const typename ScalarImageType::Pointer biasFieldBsplineImage = reconstructer->GetOutput();
-  biasFieldBsplineImage->Update();
-
-  using SelectorType = VectorIndexSelectionCastImageFilter<ScalarImageType, RealImageType>;
-  auto selector = SelectorType::New();
-  selector->SetInput(biasFieldBsplineImage);
-  selector->SetIndex(0);
-
-  RealImagePointer biasField = selector->GetOutput();
-  biasField->Update();
+  ArrayType numberOfControlPoints;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    numberOfControlPoints[d] = controlPointLattice->GetLargestPossibleRegion().GetSize()[d];
+  }
 
-  biasField->DisconnectPipeline();
+  RealImagePointer biasField = RealImageType::New();
+  biasField->CopyInformation(inputImage);
+  biasField->SetRegions(inputImage->GetLargestPossibleRegion());
+  biasField->Allocate(false);
 
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->EvaluateLattice(controlPointLattice,
+                        this->MakeBasisFunctionTables(biasField->GetLargestPossibleRegion().GetSize(),
+                                                      numberOfControlPoints),
+                        biasField);
   return biasField;
 }
 
@@ -641,47 +909,66 @@ template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealType
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::CalculateConvergenceMeasurement(
   const RealImageType * fieldEstimate1,
-  const RealImageType * fieldEstimate2) const
+  const RealImageType * fieldEstimate2,
+  const RealImageType * weightImage) const
 {
-  using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-  auto subtracter = SubtracterType::New();
-  subtracter->SetInput1(fieldEstimate1);
-  subtracter->SetInput2(fieldEstimate2);
-  subtracter->Update();
-
-  // Calculate statistics over the mask region
-
-  RealType mu = 0.0;
-  RealType sigma = 0.0;
-  RealType N = 0.0;
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  const auto   subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
-  const size_t numberOfPixels = subtracterImageBufferRange.size();
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      const RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
-      N += 1.0;
-
-      if (N > 1.0)
+  // Calculate statistics over the mask region, by chunks of pixels whose
+  // statistics are then merged.
+
+  const RealType * const buffer1 = fieldEstimate1->GetBufferPointer();
+  const RealType * const buffer2 = fieldEstimate2->GetBufferPointer();
+  const RealType * const weightBuffer = weightImage->GetBufferPointer();
+  const SizeValueType    numberOfPixels = fieldEstimate1->GetBufferedRegion().GetNumberOfPixels();
+  const SizeValueType    numberOfChunks = (numberOfPixels + PixelChunkSize - 1) / PixelChunkSize;
+
+  std::vector<double> chunkN(numberOfChunks, 0.0);
+  std::vector<double> chunkMu(numberOfChunks, 0.0);
+  std::vector<double> chunkSigma(numberOfChunks, 0.0);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      double              N = 0.0;
+      double              mu = 0.0;
+      double              sigma = 0.0;
+      const SizeValueType end = std::min(numberOfPixels, (chunk + 1) * PixelChunkSize);
+      for (SizeValueType indexValue = chunk * PixelChunkSize; indexValue < end; ++indexValue)
       {
-        sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+        if (weightBuffer[indexValue] > RealType{})
+        {
+          const RealType pixel = std::exp(buffer1[indexValue] - buffer2[indexValue]);
+          N += 1.0;
+
+          if (N > 1.0)
+          {
+            sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+          }
+          mu = mu * (1.0 - 1.0 / N) + pixel / N;
+        }
       }
-      mu = mu * (1.0 - 1.0 / N) + pixel / N;
+      chunkN[chunk] = N;
+      chunkMu[chunk] = mu;
+      chunkSigma[chunk] = sigma;
+    },
+    nullptr);
+
+  double N = 0.0;
+  double mu = 0.0;
+  double sigma = 0.0;
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    if (chunkN[chunk] > 0.0)
+    {
+      const double n = N + chunkN[chunk];
+      const double delta = chunkMu[chunk] - mu;
+      sigma += chunkSigma[chunk] + delta * delta * N * chunkN[chunk] / n;
+      mu += delta * chunkN[chunk] / n;
+      N = n;
     }
   }
   sigma = std::sqrt(sigma / (N - 1.0));
 
-  return (sigma / mu);
+  return static_cast<RealType>(sigma / mu);
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -702,6 +989,7 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::PrintSe
   os << indent << "Spline order: " << this->m_SplineOrder << std::endl;
   os << indent << "Number of fitting levels: " << this->m_NumberOfFittingLevels << std::endl;
   os << indent << "Number of control points: " << this->m_NumberOfControlPoints << std::endl;
+  os << indent << "Shrink factor: " << this->m_ShrinkFactor << std::endl;
   os << indent << "CurrentConvergenceMeasurement: " << this->m_CurrentConvergenceMeasurement << std::endl;
   os << indent << "CurrentLevel: " << this->m_CurrentLevel << std::endl;
   os << indent << "ElapsedIterations: " << this->m_ElapsedIterations << std::endl;
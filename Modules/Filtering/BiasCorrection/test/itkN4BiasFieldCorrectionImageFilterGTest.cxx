@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkBSplineControlPointImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using MaskImageType = itk::Image<unsigned char, 2>;
+using FilterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+
+constexpr unsigned int ImageSize = 96;
+
+// Two tissues, a disc inside a ring, multiplied by a smooth bias field.
+ImageType::Pointer
+MakeBiasedImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(ImageSize, ImageSize));
+  image->SetSpacing(itk::MakeVector(1.5, 1.0));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] / double{ ImageSize } - 0.5;
+    const double y = it.GetIndex()[1] / double{ ImageSize } - 0.5;
+    const double r = std::sqrt(x * x + y * y);
+    const double tissue = r < 0.2 ? 100.0 : (r < 0.45 ? 50.0 : 10.0);
+    it.Set(static_cast<float>(tissue * std::exp(0.5 * x - 0.4 * y * y)));
+  }
+  return image;
+}
+
+// The coefficient of variation of the image over the disc.
+double
+CoefficientOfVariationOfDisc(const ImageType * image)
+{
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double count = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] / double{ ImageSize } - 0.5;
+    const double y = it.GetIndex()[1] / double{ ImageSize } - 0.5;
+    if (std::sqrt(x * x + y * y) < 0.18)
+    {
+      sum += it.Get();
+      sumOfSquares += it.Get() * it.Get();
+      count += 1.0;
+    }
+  }
+  const double mean = sum / count;
+  return std::sqrt(sumOfSquares / count - mean * mean) / mean;
+}
+
+FilterType::Pointer
+MakeFilter(const ImageType * image)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfFittingLevels(3);
+  FilterType::VariableSizeArrayType maximumNumberOfIterations(3);
+  maximumNumberOfIterations.Fill(20);
+  filter->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+  filter->SetConvergenceThreshold(0.0);
+  return filter;
+}
+} // namespace
+
+
+TEST(N4BiasFieldCorrectionImageFilter, ShrinkFactor)
+{
+  auto filter = FilterType::New();
+  EXPECT_EQ(filter->GetShrinkFactor(), 1u);
+  filter->SetShrinkFactor(0);
+  EXPECT_EQ(filter->GetShrinkFactor(), 1u);
+  filter->SetShrinkFactor(3);
+  EXPECT_EQ(filter->GetShrinkFactor(), 3u);
+}
+
+
+TEST(N4BiasFieldCorrectionImageFilter, CorrectsOnShrunkGrid)
+{
+  const auto image = MakeBiasedImage();
+  const double inputVariation = CoefficientOfVariationOfDisc(image);
+
+  auto filter = MakeFilter(image);
+  filter->Update();
+  const double variation = CoefficientOfVariationOfDisc(filter->GetOutput());
+  EXPECT_LT(variation, 0.2 * inputVariation);
+
+  for (const unsigned int shrinkFactor : { 2u, 3u })
+  {
+    auto shrunkFilter = MakeFilter(image);
+    shrunkFilter->SetShrinkFactor(shrinkFactor);
+    shrunkFilter->SetNumberOfWorkUnits(3);
+    shrunkFilter->Update();
+
+    const ImageType * output = shrunkFilter->GetOutput();
+    EXPECT_EQ(output->GetBufferedRegion(), image->GetBufferedRegion());
+    EXPECT_LT(CoefficientOfVariationOfDisc(output), 0.2 * inputVariation);
+    EXPECT_EQ(shrunkFilter->GetLogBiasFieldControlPointLattice()->GetLargestPossibleRegion().GetSize(),
+              filter->GetLogBiasFieldControlPointLattice()->GetLargestPossibleRegion().GetSize());
+  }
+}
+
+
+TEST(N4BiasFieldCorrectionImageFilter, ReconstructBiasFieldMatchesControlPointImageFilter)
+{
+  const auto image = MakeBiasedImage();
+
+  auto mask = MaskImageType::New();
+  mask->CopyInformation(image);
+  mask->SetRegions(image->GetBufferedRegion());
+  mask->AllocateInitialized();
+  for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(it.GetIndex()[0] > 10 && it.GetIndex()[1] < 80);
+  }
+
+  auto filter = MakeFilter(image);
+  filter->SetMaskImage(mask);
+  filter->SetSplineOrder(2);
+  filter->Update();
+
+  const auto * lattice = filter->GetLogBiasFieldControlPointLattice();
+  using ReconstructerType = itk::BSplineControlPointImageFilter<FilterType::BiasFieldControlPointLatticeType,
+                                                                FilterType::ScalarImageType>;
+  auto reconstructer = ReconstructerType::New();
+  reconstructer->SetInput(lattice);
+  reconstructer->SetOrigin(image->GetOrigin());
+  reconstructer->SetSpacing(image->GetSpacing());
+  reconstructer->SetDirection(image->GetDirection());
+  reconstructer->SetSize(image->GetLargestPossibleRegion().GetSize());
+  reconstructer->SetSplineOrder(2);
+  reconstructer->Update();
+
+  const auto biasField = filter->ReconstructBiasField(lattice);
+  ASSERT_EQ(biasField->GetBufferedRegion(), image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FilterType::ScalarImageType> expectedIt(reconstructer->GetOutput(),
+                                                                       image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FilterType::RealImageType>   it(biasField, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++expectedIt)
+  {
+    ASSERT_NEAR(it.Get(), expectedIt.Get()[0], 1e-5);
+  }
+
+  // The output is the input divided by the exponential of that bias field.
+  itk::ImageRegionConstIterator<ImageType> inputIt(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> outputIt(filter->GetOutput(), image->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++inputIt, ++outputIt)
+  {
+    ASSERT_NEAR(outputIt.Get(), inputIt.Get() / std::exp(it.Get()), 1e-3);
+  }
+}
@@ -111,6 +111,18 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get the approximate number of bytes of memory used by the Fourier
+   * transforms. When the output requested region, padded by the kernel
+   * radius, needs more than that, the output is computed tile by tile with
+   * the overlap-save method: each tile, padded by the kernel radius, is
+   * transformed, multiplied by a kernel spectrum computed once for all the
+   * tiles, and transformed back, keeping only the part not affected by the
+   * circular wrap-around. Along with a StreamingImageFilter, which bounds the
+   * input requested region, this convolves images larger than the memory.
+   * Zero, the default, transforms the whole requested region at once. */
+  itkSetMacro(TileMemoryBudget, SizeValueType);
+  itkGetConstMacro(TileMemoryBudget, SizeValueType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -133,6 +145,22 @@ protected:
   void
   GenerateData() override;
 
+  /** Compute the output requested region tile by tile, transforming
+   * tiles of fftSize pixels, which are padded from output tiles of at
+   * most tileSize pixels. */
+  void
+  GenerateDataByTiles(const InputSizeType & tileSize, const InputSizeType & fftSize);
+
+  /** Get the smallest size not less than the given one whose greatest
+   * prime factor is at most SizeGreatestPrimeFactor. */
+  SizeValueType
+  GetFFTFriendlySize(SizeValueType size) const;
+
+  /** Estimate the number of bytes used to convolve an image of fftSize
+   * pixels in the Fourier domain. */
+  SizeValueType
+  EstimateFFTMemorySize(const InputSizeType & fftSize) const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -207,6 +235,7 @@ protected:
 
 private:
   SizeValueType      m_SizeGreatestPrimeFactor{};
+  SizeValueType      m_TileMemoryBudget{ 0 };
   InternalSizeType   m_FFTPadSize{ { 0 } };
   InternalRegionType m_PaddedInputRegion{};
 };
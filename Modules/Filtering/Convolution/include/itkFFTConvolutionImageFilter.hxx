@@ -25,7 +25,9 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionExclusionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
@@ -54,6 +56,7 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
     // as an implementation detail, while pixels for kernel radius padding may be taken
     // from the original image if they lies inside the image bounds.
     inputRegion.PadByRadius(this->GetKernelRadius());
+    const InputRegionType paddedRegion = inputRegion;
 
     // Crop the output requested region to fit within the largest
     // possible region.
@@ -64,6 +67,12 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
       itkExceptionMacro("Requested region is outside the largest possible region.");
     }
 
+    // The boundary condition may read pixels of the image beyond the
+    // cropped region, such as a periodic one does, when the tiles are
+    // padded pixel by pixel.
+    inputRegion =
+      this->GetBoundaryCondition()->GetInputRequestedRegion(inputPtr->GetLargestPossibleRegion(), paddedRegion);
+
     // Input is an image, cast away the constness so we can set
     // the requested region.
     inputPtr->SetRequestedRegion(inputRegion);
@@ -82,6 +91,50 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  if (m_TileMemoryBudget > 0)
+  {
+    const OutputSizeType requestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+    const KernelSizeType kernelRadius = this->GetKernelRadius();
+    InputSizeType        tileSize;
+    InputSizeType        fftSize;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      tileSize[dim] = requestedSize[dim];
+      fftSize[dim] = this->GetFFTFriendlySize(tileSize[dim] + 2 * kernelRadius[dim]);
+    }
+
+    if (this->EstimateFFTMemorySize(fftSize) > m_TileMemoryBudget)
+    {
+      // Halve the tiles along their longest side until they fit in the
+      // budget, or until they are one pixel wide.
+      while (this->EstimateFFTMemorySize(fftSize) > m_TileMemoryBudget)
+      {
+        unsigned int longest = ImageDimension;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          if (tileSize[dim] > 1 && (longest == ImageDimension || fftSize[dim] > fftSize[longest]))
+          {
+            longest = dim;
+          }
+        }
+        if (longest == ImageDimension)
+        {
+          break;
+        }
+        tileSize[longest] = (tileSize[longest] + 1) / 2;
+        fftSize[longest] = this->GetFFTFriendlySize(tileSize[longest] + 2 * kernelRadius[longest]);
+      }
+
+      // Use all of the transform size left by the FFT padding.
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        tileSize[dim] = std::min(fftSize[dim] - 2 * kernelRadius[dim], requestedSize[dim]);
+      }
+      this->GenerateDataByTiles(tileSize, fftSize);
+      return;
+    }
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -112,6 +165,145 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateDataByTiles(
+  const InputSizeType & tileSize,
+  const InputSizeType & fftSize)
+{
+  const InputImageType *        input = this->GetInput();
+  const InputRegionType         inputBufferedRegion = input->GetBufferedRegion();
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  const KernelSizeType          kernelRadius = this->GetKernelRadius();
+
+  this->AllocateOutputs();
+  OutputImageType *      output = this->GetOutput();
+  const OutputRegionType outputRegion = output->GetRequestedRegion();
+
+  // All the tiles are transformed with the same size, so that a single
+  // kernel spectrum serves them all.
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+  m_PaddedInputRegion = InternalRegionType(fftSize);
+  InternalComplexImagePointerType kernelSpectrum = nullptr;
+  this->PrepareKernel(this->GetKernelImage(), kernelSpectrum, progress, 0.1f);
+
+  InputSizeType numberOfTilesPerDimension;
+  SizeValueType numberOfTiles = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    numberOfTilesPerDimension[dim] = (outputRegion.GetSize(dim) + tileSize[dim] - 1) / tileSize[dim];
+    numberOfTiles *= numberOfTilesPerDimension[dim];
+  }
+
+  for (SizeValueType tileNumber = 0; tileNumber < numberOfTiles; ++tileNumber)
+  {
+    OutputRegionType tileRegion;
+    SizeValueType    remainingTileNumber = tileNumber;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType  tilePosition = remainingTileNumber % numberOfTilesPerDimension[dim];
+      const IndexValueType tileIndex = outputRegion.GetIndex(dim) + tilePosition * tileSize[dim];
+      remainingTileNumber /= numberOfTilesPerDimension[dim];
+      tileRegion.SetIndex(dim, tileIndex);
+      tileRegion.SetSize(
+        dim, std::min(tileSize[dim], static_cast<SizeValueType>(outputRegion.GetUpperIndex()[dim] - tileIndex + 1)));
+    }
+
+    // Fill the tile with the input, padded by the kernel radius with the
+    // boundary condition. The zeros beyond only change the part of the
+    // result wrapped around by the circular convolution, which is dropped.
+    InputRegionType paddedTileRegion = tileRegion;
+    paddedTileRegion.PadByRadius(kernelRadius);
+    auto tile = InternalImageType::New();
+    tile->SetRegions(InternalRegionType(paddedTileRegion.GetIndex(), fftSize));
+    tile->AllocateInitialized();
+
+    InputRegionType insideRegion = paddedTileRegion;
+    if (insideRegion.Crop(inputBufferedRegion))
+    {
+      ImageAlgorithm::Copy(input, tile.GetPointer(), insideRegion, insideRegion);
+      if (insideRegion != paddedTileRegion)
+      {
+        ImageRegionExclusionIteratorWithIndex<InternalImageType> it(tile, paddedTileRegion);
+        it.SetExclusionRegion(insideRegion);
+        for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+        {
+          it.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(it.GetIndex(), input)));
+        }
+      }
+    }
+
+    auto fftFilter = FFTFilterType::New();
+    fftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    fftFilter->SetInput(tile);
+    fftFilter->Update();
+    tile = nullptr;
+
+    InternalComplexImageType * spectrum = fftFilter->GetOutput();
+    InternalComplexType *      spectrumBuffer = spectrum->GetBufferPointer();
+    const InternalComplexType * kernelSpectrumBuffer = kernelSpectrum->GetBufferPointer();
+    const SizeValueType         numberOfFrequencies = spectrum->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType i = 0; i < numberOfFrequencies; ++i)
+    {
+      spectrumBuffer[i] *= kernelSpectrumBuffer[i];
+    }
+
+    auto ifftFilter = IFFTFilterType::New();
+    ifftFilter->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
+    ifftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    ifftFilter->SetInput(spectrum);
+    ifftFilter->Update();
+
+    // Keep the part of the result that only depends on the padded tile.
+    const InternalImageType * convolvedTile = ifftFilter->GetOutput();
+    InternalIndexType         validIndex = convolvedTile->GetLargestPossibleRegion().GetIndex();
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      validIndex[dim] += kernelRadius[dim];
+    }
+    ImageAlgorithm::Copy(convolvedTile, output, InternalRegionType(validIndex, tileRegion.GetSize()), tileRegion);
+
+    this->UpdateProgress(0.1f + 0.9f * static_cast<float>(tileNumber + 1) / static_cast<float>(numberOfTiles));
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetFFTFriendlySize(
+  SizeValueType size) const -> SizeValueType
+{
+  // As done by FFTPadImageFilter.
+  SizeValueType paddedSize = size;
+  if (m_SizeGreatestPrimeFactor > 1)
+  {
+    while (Math::GreatestPrimeFactor(paddedSize) > m_SizeGreatestPrimeFactor)
+    {
+      ++paddedSize;
+    }
+  }
+  else if (m_SizeGreatestPrimeFactor == 1)
+  {
+    paddedSize += paddedSize % 2;
+  }
+  return paddedSize;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::EstimateFFTMemorySize(
+  const InputSizeType & fftSize) const -> SizeValueType
+{
+  // Two real images, for the padded input and the result, two half spectra,
+  // for the input and the kernel, and the complex buffer of a transform.
+  SizeValueType numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    numberOfPixels *= fftSize[dim];
+  }
+  return 6 * sizeof(TInternalPrecision) * numberOfPixels;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -524,6 +716,7 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "TileMemoryBudget: " << m_TileMemoryBudget << std::endl;
 }
 
 } // namespace itk
@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestDriverIncludeRequiredFactories.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using FilterType = itk::FFTConvolutionImageFilter<ImageType>;
+using OutputRegionEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+
+ImageType::Pointer
+MakeImage(const ImageType::SizeType & size, unsigned int seed)
+{
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int state = seed;
+  for (float * pixel = image->GetBufferPointer(), *end = pixel + image->GetBufferedRegion().GetNumberOfPixels();
+       pixel != end;
+       ++pixel)
+  {
+    state = state * 1103515245u + 12345u;
+    *pixel = static_cast<float>((state >> 16) & 0xFF) / 255.0f;
+  }
+  return image;
+}
+
+void
+ExpectNearImages(const ImageType & expected, const ImageType & actual)
+{
+  ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> expectedIt(&expected, expected.GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> actualIt(&actual, actual.GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    ASSERT_NEAR(expectedIt.Get(), actualIt.Get(), 1e-3) << "at index " << expectedIt.GetIndex();
+  }
+}
+
+ImageType::Pointer
+Convolve(const ImageType *                   image,
+         const ImageType *                   kernel,
+         itk::SizeValueType                  tileMemoryBudget,
+         bool                                normalize = false,
+         FilterType::BoundaryConditionType * boundaryCondition = nullptr,
+         OutputRegionEnum                    outputRegionMode = OutputRegionEnum::SAME)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->SetTileMemoryBudget(tileMemoryBudget);
+  filter->SetNormalize(normalize);
+  filter->SetOutputRegionMode(outputRegionMode);
+  if (boundaryCondition)
+  {
+    filter->SetBoundaryCondition(boundaryCondition);
+  }
+  filter->Update();
+  return filter->GetOutput();
+}
+
+struct FFTConvolutionImageFilterTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFFTFactories();
+  }
+};
+} // namespace
+
+
+TEST_F(FFTConvolutionImageFilterTest, TileMemoryBudget)
+{
+  auto filter = FilterType::New();
+  EXPECT_EQ(filter->GetTileMemoryBudget(), 0u);
+  filter->SetTileMemoryBudget(1 << 20);
+  EXPECT_EQ(filter->GetTileMemoryBudget(), itk::SizeValueType{ 1 } << 20);
+}
+
+
+TEST_F(FFTConvolutionImageFilterTest, TilesMatchWholeImage)
+{
+  const auto image = MakeImage({ { 41, 30, 23 } }, 1);
+  // Even and odd kernel sizes.
+  const auto kernel = MakeImage({ { 7, 4, 5 } }, 2);
+
+  const auto expected = Convolve(image, kernel, 0);
+  for (const itk::SizeValueType tileMemoryBudget : { 1u << 15, 1u << 18, 1u << 20, 1u << 30 })
+  {
+    SCOPED_TRACE(tileMemoryBudget);
+    ExpectNearImages(*expected, *Convolve(image, kernel, tileMemoryBudget));
+  }
+
+  itk::ConstantBoundaryCondition<ImageType> boundaryCondition;
+  boundaryCondition.SetConstant(2.0f);
+  ExpectNearImages(*Convolve(image, kernel, 0, true, &boundaryCondition),
+                   *Convolve(image, kernel, 1u << 16, true, &boundaryCondition));
+  ExpectNearImages(*Convolve(image, kernel, 0, false, nullptr, OutputRegionEnum::VALID),
+                   *Convolve(image, kernel, 1u << 16, false, nullptr, OutputRegionEnum::VALID));
+}
+
+
+TEST_F(FFTConvolutionImageFilterTest, TilesOfStreamedRegions)
+{
+  const auto image = MakeImage({ { 32, 29, 40 } }, 3);
+  const auto kernel = MakeImage({ { 9, 9, 9 } }, 4);
+
+  const auto expected = Convolve(image, kernel, 0);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->SetTileMemoryBudget(1u << 17);
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  streamer->Update();
+  ExpectNearImages(*expected, *streamer->GetOutput());
+}
@@ -29,6 +29,9 @@
 #include "itkFixedArray.h"
 #include "itkMatrix.h"
 #include "itkRegionConstrainedSubsampler.h"
+#include "itkSpatialNeighborSubsampler.h"
+#include "itkGaussianOperator.h"
+#include "itkProgressReporter.h"
 #include <type_traits>
 
 #include <vector>
@@ -184,6 +187,27 @@ public:
   itkBooleanMacro(UseFastTensorComputations);
   itkGetConstMacro(UseFastTensorComputations, bool);
 
+  /** Set/Get flag indicating whether patch distances should be computed by search offset.
+   *
+   *  When the sampler is a SpatialNeighborSubsampler, each pixel is compared to
+   *  all the pixels within the search radius. With this flag true (default) or On,
+   *  the image is then processed by tiles: for each offset of the search window,
+   *  the squared differences between the tile and the tile shifted by the offset
+   *  are computed once, and summed over the patches of all the pixels of the tile
+   *  (by separable box sums when all the patch weights are equal), as in the fast
+   *  non-local means of
+   *  Darbon J, Cunha A, Chan TF, Osher S, Jensen GJ.
+   *  Fast nonlocal filtering applied to electron cryomicroscopy.
+   *  IEEE ISBI 2008; 1331-1334.
+   *  The result is the one of comparing the patches one by one, up to rounding.
+   *
+   *  The flag is ignored, and the patches are compared one by one, for other
+   *  samplers and when the components are in Riemannian space.
+   */
+  itkSetMacro(UseFastPatchDistances, bool);
+  itkBooleanMacro(UseFastPatchDistances);
+  itkGetConstMacro(UseFastPatchDistances, bool);
+
   /** Maximum number of Newton-Raphson iterations for sigma update. */
   static constexpr unsigned int MaxSigmaUpdateIterations = 20;
 
@@ -514,6 +538,30 @@ private:
                           FixedArray<TensorValueT, 3> &           eigenVals,
                           Matrix<TensorValueT, 3, 3> &            eigenVecs);
 
+  using GaussianOperatorType = GaussianOperator<RealValueType, ImageDimension>;
+  using SpatialNeighborSamplerType = itk::Statistics::SpatialNeighborSubsampler<PatchSampleType, InputImageRegionType>;
+
+  /** Whether the patch distances can be computed by search offset, see UseFastPatchDistances. */
+  bool
+  CanComputePatchDistancesByOffset() const;
+
+  /** Computes the image update of the region, tile by tile, with the patch
+   * distances computed by search offset. */
+  void
+  ThreadedComputeImageUpdateByOffsets(const InputImageRegionType & regionToProcess, ProgressReporter & progress);
+
+  /** Computes the gradient of the joint entropy of each pixel of the tile, as
+   * ComputeGradientJointEntropy does, and stores its components pixel by pixel. */
+  void
+  ComputeGradientJointEntropyByOffsets(const InputImageRegionType & tile, std::vector<RealValueType> & gradients);
+
+  /** Adds to the result the update that keeps the output close to the noisy input, for the noise model. */
+  void
+  AddNoiseModelFidelityUpdate(const PixelType &      in,
+                              const PixelType &      out,
+                              GaussianOperatorType & gOper,
+                              RealType &             result) const;
+
   RealType
   AddEuclideanUpdate(const RealType & a, const RealType & b);
 
@@ -541,6 +589,8 @@ private:
 
   bool m_UseFastTensorComputations{ true };
 
+  bool m_UseFastPatchDistances{ true };
+
   RealArrayType  m_KernelBandwidthSigma{};
   bool           m_KernelBandwidthSigmaIsSet{ false };
   RealArrayType  m_IntensityRescaleInvFactor{};
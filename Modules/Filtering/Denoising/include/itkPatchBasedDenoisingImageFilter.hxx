@@ -30,6 +30,8 @@
 #include "itkSpatialNeighborSubsampler.h"
 #include "itkMacro.h"
 #include "itkMath.h"
+#include <algorithm>
+#include <typeinfo>
 
 namespace itk
 {
@@ -1928,7 +1930,6 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
   using FaceListType = typename FaceCalculatorType::FaceListType;
 
   using SampleIteratorType = typename ListAdaptorType::ConstIterator;
-  using GaussianOperatorType = GaussianOperator<RealValueType, OutputImageType::ImageDimension>;
 
   const PatchRadiusType radius = this->GetPatchRadiusInVoxels();
 
@@ -1943,6 +1944,12 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
 
   ProgressReporter progress(this, threadId, regionToProcess.GetNumberOfPixels());
 
+  if (this->CanComputePatchDistancesByOffset())
+  {
+    this->ThreadedComputeImageUpdateByOffsets(regionToProcess, progress);
+    return threadData;
+  }
+
   // Break the input into a series of regions.  The first region is free
   // of boundary conditions, the rest with boundary conditions.  We operate
   // on the output region because input has been copied to output
@@ -1990,76 +1997,10 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
         result = AddUpdate(result, gradientJointEntropy * (smoothingWeight * stepSizeSmoothing));
       } // end if smoothingWeight > 0
 
-      const double fidelityWeight = this->GetNoiseModelFidelityWeight();
-      if (fidelityWeight > 0)
+      if (this->GetNoiseModelFidelityWeight() > 0)
       {
-        // We should never have fidelity weight > 0 in the non-Euclidean case
-        // so don't bother checking for component space here
-        const PixelType in = inputIt.Get();
-        const PixelType out = outputIt.Get();
-        switch (this->GetNoiseModel())
-        {
-          case Superclass::NoiseModelEnum::NOMODEL:
-          {
-            // Do nothing
-            break;
-          }
-          case Superclass::NoiseModelEnum::GAUSSIAN:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const RealValueType gradientFidelity = 2.0 * (this->GetComponent(in, pc) - this->GetComponent(out, pc));
-              constexpr RealValueType stepSizeFidelity = 0.5;
-              const RealValueType     noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              this->SetComponent(result, pc, this->GetComponent(result, pc) + noiseVal);
-            }
-            break;
-          }
-          case Superclass::NoiseModelEnum::RICIAN:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const PixelValueType inVal = this->GetComponent(in, pc);
-              const PixelValueType outVal = this->GetComponent(out, pc);
-              const RealValueType  sigmaSquared = this->GetComponent(m_NoiseSigmaSquared, pc);
-
-              const RealValueType alpha = inVal * outVal / sigmaSquared;
-              const RealValueType gradientFidelity =
-                (inVal * (gOper.ModifiedBesselI1(alpha) / gOper.ModifiedBesselI0(alpha)) - outVal) / sigmaSquared;
-              const RealValueType stepSizeFidelity = sigmaSquared;
-              // Update
-              const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              // Ensure that the result is nonnegative
-              this->SetComponent(
-                result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.0)));
-            }
-            break;
-          }
-          case Superclass::NoiseModelEnum::POISSON:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const PixelValueType inVal = this->GetComponent(in, pc);
-              const PixelValueType outVal = this->GetComponent(out, pc);
-
-              const RealValueType gradientFidelity = (inVal - outVal) / (outVal + 0.00001);
-              // Prevent large unstable updates when out[pc] less than 1
-              const RealValueType stepSizeFidelity = std::min(outVal, static_cast<PixelValueType>(0.99999)) + 0.00001;
-              // Update
-              const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              // Ensure that the result is positive
-              this->SetComponent(
-                result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.00001)));
-            }
-            break;
-          }
-          default:
-          {
-            itkExceptionMacro("Unexpected noise model " << this->GetNoiseModel() << " specified.");
-            break;
-          }
-        }
-      } // end if fidelityWeight > 0
+        this->AddNoiseModelFidelityUpdate(inputIt.Get(), outputIt.Get(), gOper, result);
+      }
 
       // Set update value, because we can't change the output until the other
       // threads are done using it.
@@ -2083,6 +2024,556 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
   return threadData;
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::CanComputePatchDistancesByOffset() const
+{
+  // The random subsamplers derive from SpatialNeighborSubsampler, but select
+  // only some of the pixels within the search radius.
+  return m_UseFastPatchDistances && this->GetComponentSpace() == Superclass::ComponentSpaceEnum::EUCLIDEAN &&
+         m_Sampler.IsNotNull() && typeid(*m_Sampler) == typeid(SpatialNeighborSamplerType) &&
+         static_cast<const SpatialNeighborSamplerType *>(m_Sampler.GetPointer())->GetRadiusInitialized() &&
+         this->m_OutputImage->GetBufferedRegion() == this->m_OutputImage->GetLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageUpdateByOffsets(
+  const InputImageRegionType & regionToProcess,
+  ProgressReporter &           progress)
+{
+  // Halve the largest dimension of the tiles until the buffers of a tile
+  // (a few values per pixel) fit in the cache.
+  constexpr SizeValueType                 maximumNumberOfTilePixels = 4096;
+  typename InputImageRegionType::SizeType tileSize = regionToProcess.GetSize();
+  while (tileSize.CalculateProductOfElements() > maximumNumberOfTilePixels)
+  {
+    unsigned int largestDimension = 0;
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+    {
+      if (tileSize[dim] > tileSize[largestDimension])
+      {
+        largestDimension = dim;
+      }
+    }
+    tileSize[largestDimension] = (tileSize[largestDimension] + 1) / 2;
+  }
+
+  const double               smoothingWeight = this->GetSmoothingWeight();
+  constexpr RealValueType    stepSizeSmoothing = 0.2;
+  GaussianOperatorType       gOper;
+  std::vector<RealValueType> gradients;
+  RealType                   gradientJointEntropy = m_ZeroPixel;
+
+  typename InputImageRegionType::IndexType tileIndex = regionToProcess.GetIndex();
+  for (;;)
+  {
+    InputImageRegionType tile(tileIndex, tileSize);
+    tile.Crop(regionToProcess);
+
+    if (smoothingWeight > 0)
+    {
+      this->ComputeGradientJointEntropyByOffsets(tile, gradients);
+    }
+
+    InputImageRegionConstIteratorType inputIt(this->m_InputImage, tile);
+    OutputImageRegionIteratorType     outputIt(this->m_OutputImage, tile);
+    OutputImageRegionIteratorType     updateIt(m_UpdateBuffer, tile);
+    for (SizeValueType n = 0; !updateIt.IsAtEnd(); ++n, ++inputIt, ++outputIt, ++updateIt)
+    {
+      RealType result = outputIt.Get();
+      if (smoothingWeight > 0)
+      {
+        for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+        {
+          this->SetComponent(gradientJointEntropy, pc, gradients[n * m_NumPixelComponents + pc]);
+        }
+        result = AddUpdate(result, gradientJointEntropy * (smoothingWeight * stepSizeSmoothing));
+      }
+      if (this->GetNoiseModelFidelityWeight() > 0)
+      {
+        this->AddNoiseModelFidelityUpdate(inputIt.Get(), outputIt.Get(), gOper, result);
+      }
+      updateIt.Set(static_cast<PixelType>(result));
+
+      progress.CompletedPixel();
+    }
+
+    unsigned int dim = 0;
+    for (; dim < ImageDimension; ++dim)
+    {
+      tileIndex[dim] += tileSize[dim];
+      if (tileIndex[dim] <= regionToProcess.GetUpperIndex()[dim])
+      {
+        break;
+      }
+      tileIndex[dim] = regionToProcess.GetIndex(dim);
+    }
+    if (dim == ImageDimension)
+    {
+      break;
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeGradientJointEntropyByOffsets(
+  const InputImageRegionType & tile,
+  std::vector<RealValueType> & gradients)
+{
+  using IndexType = typename InputImageRegionType::IndexType;
+  using OffsetTableType = typename InputImageRegionType::OffsetTableType;
+
+  const InputImageRegionType imageRegion = this->m_OutputImage->GetBufferedRegion();
+  const IndexType            imageIndex = imageRegion.GetIndex();
+  const IndexType            imageUpperIndex = imageRegion.GetUpperIndex();
+  const PatchRadiusType      patchRadius = this->GetPatchRadiusInVoxels();
+  const PatchRadiusType      searchRadius =
+    static_cast<const SpatialNeighborSamplerType *>(m_Sampler.GetPointer())->GetRadius();
+  const unsigned int numberOfComponents = m_NumPixelComponents;
+
+  // Calls lineFunction(index) with the first index of each line of the region along dimension 0.
+  const auto forEachLine = [](const InputImageRegionType & region, const auto & lineFunction) {
+    if (region.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+    IndexType index = region.GetIndex();
+    for (;;)
+    {
+      lineFunction(index);
+      unsigned int dim = 1;
+      for (; dim < ImageDimension; ++dim)
+      {
+        if (++index[dim] <= region.GetUpperIndex()[dim])
+        {
+          break;
+        }
+        index[dim] = region.GetIndex(dim);
+      }
+      if (dim >= ImageDimension)
+      {
+        return;
+      }
+    }
+  };
+
+  // The components of the pixels within the search radius of the tile, one component after the other.
+  InputImageRegionType valuesRegion = tile;
+  valuesRegion.PadByRadius(patchRadius + searchRadius);
+  valuesRegion.Crop(imageRegion);
+  OffsetTableType valuesOffsetTable;
+  valuesRegion.ComputeOffsetTable(valuesOffsetTable);
+  const SizeValueType        numberOfValues = valuesRegion.GetNumberOfPixels();
+  std::vector<RealValueType> values(numberOfValues * numberOfComponents);
+  {
+    ImageRegionConstIterator<OutputImageType> it(this->m_OutputImage, valuesRegion);
+    for (SizeValueType i = 0; !it.IsAtEnd(); ++it, ++i)
+    {
+      const PixelType pixel = it.Get();
+      for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+      {
+        values[pc * numberOfValues + i] = this->GetComponent(pixel, pc);
+      }
+    }
+  }
+
+  // The squared differences, and the patch distances, are stored for the
+  // tile padded by the patch radius, one component after the other.
+  InputImageRegionType patchesRegion = tile;
+  patchesRegion.PadByRadius(patchRadius);
+  OffsetTableType patchesOffsetTable;
+  patchesRegion.ComputeOffsetTable(patchesOffsetTable);
+  const SizeValueType        numberOfPatchValues = patchesRegion.GetNumberOfPixels();
+  std::vector<RealValueType> squaredDifferences(numberOfPatchValues * numberOfComponents);
+  std::vector<RealValueType> distances(numberOfPatchValues * numberOfComponents);
+  std::vector<RealValueType> partialSums;
+
+  const auto valuesPosition = [&](const IndexType & index) {
+    OffsetValueType position = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      position += (index[dim] - valuesRegion.GetIndex(dim)) * valuesOffsetTable[dim];
+    }
+    return position;
+  };
+  const auto patchesPosition = [&](const IndexType & index) {
+    OffsetValueType position = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      position += (index[dim] - patchesRegion.GetIndex(dim)) * patchesOffsetTable[dim];
+    }
+    return position;
+  };
+
+  // The weights of the patch, by lines along dimension 0: the squared
+  // differences are summed along dimension 0 once for all the lines of the
+  // patch with the same weights (by symmetry, a smooth disc has few of them).
+  // When all the weights are equal, the distances are box sums instead.
+  using LineWeightsType = std::vector<std::pair<OffsetValueType, RealValueType>>;
+  const PatchWeightsType                          patchWeights = this->GetPatchWeights();
+  std::vector<LineWeightsType>                    lineWeights;
+  std::vector<std::pair<OffsetValueType, size_t>> patchLines;
+  bool                                            equalWeights = true;
+  {
+    const PatchRadiusType                         patchDiameter = this->GetPatchDiameterInVoxels();
+    const typename PatchRadiusType::SizeValueType numberOfPatchLines =
+      this->GetPatchLengthInVoxels() / patchDiameter[0];
+    for (typename PatchRadiusType::SizeValueType line = 0; line < numberOfPatchLines; ++line)
+    {
+      LineWeightsType weights;
+      for (SizeValueType position = 0; position < patchDiameter[0]; ++position)
+      {
+        const RealValueType weight = patchWeights[line * patchDiameter[0] + position];
+        equalWeights = equalWeights && weight == patchWeights[0];
+        if (weight > 0)
+        {
+          weights.emplace_back(static_cast<OffsetValueType>(position) - static_cast<OffsetValueType>(patchRadius[0]),
+                               weight * weight);
+        }
+      }
+      if (weights.empty())
+      {
+        continue;
+      }
+
+      OffsetValueType lineOffset = 0;
+      SizeValueType   remainder = line;
+      for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+      {
+        const auto position = static_cast<OffsetValueType>(remainder % patchDiameter[dim]);
+        remainder /= patchDiameter[dim];
+        lineOffset += (position - static_cast<OffsetValueType>(patchRadius[dim])) * patchesOffsetTable[dim];
+      }
+      const auto sameWeights = std::find(lineWeights.cbegin(), lineWeights.cend(), weights);
+      patchLines.emplace_back(lineOffset, static_cast<size_t>(sameWeights - lineWeights.cbegin()));
+      if (sameWeights == lineWeights.cend())
+      {
+        lineWeights.push_back(std::move(weights));
+      }
+    }
+  }
+  std::vector<RealValueType> lineSums;
+  if (equalWeights)
+  {
+    partialSums.resize(numberOfPatchValues * numberOfComponents);
+  }
+  else
+  {
+    lineSums.resize(lineWeights.size() * numberOfPatchValues * numberOfComponents);
+  }
+  const RealValueType distanceScale = equalWeights ? RealValueType{ patchWeights[0] } * patchWeights[0] : 1.0;
+
+  std::vector<RealValueType> scaledSquaredSigmas(numberOfComponents);
+  for (unsigned int ic = 0; ic < numberOfComponents; ++ic)
+  {
+    scaledSquaredSigmas[ic] = distanceScale / itk::Math::sqr(m_KernelBandwidthSigma[ic]);
+  }
+
+  const SizeValueType        numberOfTilePixels = tile.GetNumberOfPixels();
+  std::vector<RealValueType> sumsOfGaussians(numberOfTilePixels, 0.0);
+  gradients.assign(numberOfTilePixels * numberOfComponents, 0.0);
+
+  // Visit the offsets in the order the sampler visits the selected patches,
+  // so that the sums are accumulated in the same order.
+  InputImageRegionType searchRegion;
+  searchRegion.SetSize(searchRadius + searchRadius + MakeFilled<PatchRadiusType>(1));
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    searchRegion.SetIndex(dim, -static_cast<IndexValueType>(searchRadius[dim]));
+  }
+  for (IndexType searchIndex = searchRegion.GetIndex();;)
+  {
+    // The pixels of the tile that select the patch at this offset: it must lie
+    // within the constraint region of ComputeGradientJointEntropy, so that the
+    // whole patch is in bounds wherever the patch of the pixel is in bounds.
+    InputImageRegionType validRegion = tile;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const IndexValueType offset = searchIndex[dim];
+      IndexValueType       first = tile.GetIndex(dim);
+      IndexValueType       last = tile.GetUpperIndex()[dim];
+      if (offset > 0)
+      {
+        last = std::min(last, imageUpperIndex[dim] - static_cast<IndexValueType>(patchRadius[dim]) - offset);
+      }
+      else if (offset < 0)
+      {
+        first = std::max(first, imageIndex[dim] + static_cast<IndexValueType>(patchRadius[dim]) - offset);
+      }
+      validRegion.SetIndex(dim, first);
+      validRegion.SetSize(dim, static_cast<SizeValueType>(std::max<IndexValueType>(last - first + 1, 0)));
+    }
+
+    if (validRegion.GetNumberOfPixels() > 0)
+    {
+      OffsetValueType valuesOffset = 0;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        valuesOffset += searchIndex[dim] * valuesOffsetTable[dim];
+      }
+
+      // The squared differences between the pixels around the valid pixels and
+      // the pixels at the offset from them, with zeros out of the image.
+      InputImageRegionType differencesRegion = validRegion;
+      differencesRegion.PadByRadius(patchRadius);
+      const auto lineLength = static_cast<IndexValueType>(differencesRegion.GetSize(0));
+      forEachLine(differencesRegion, [&](const IndexType & lineIndex) {
+        const OffsetValueType position = patchesPosition(lineIndex);
+        const IndexValueType  first = lineIndex[0];
+        const IndexValueType  last = first + lineLength - 1;
+        bool                  lineInImage = true;
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+          lineInImage = lineInImage && lineIndex[dim] >= imageIndex[dim] && lineIndex[dim] <= imageUpperIndex[dim];
+        }
+        const IndexValueType firstInImage = lineInImage ? std::max(first, imageIndex[0]) : last + 1;
+        const IndexValueType lastInImage = lineInImage ? std::min(last, imageUpperIndex[0]) : last;
+        for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+        {
+          RealValueType * const line = squaredDifferences.data() + pc * numberOfPatchValues + position;
+          for (IndexValueType x = first; x < firstInImage; ++x)
+          {
+            line[x - first] = 0.0;
+          }
+          if (firstInImage <= lastInImage)
+          {
+            IndexType valueIndex = lineIndex;
+            valueIndex[0] = firstInImage;
+            const RealValueType * const current = values.data() + pc * numberOfValues + valuesPosition(valueIndex);
+            const RealValueType * const selected = current + valuesOffset;
+            for (IndexValueType x = firstInImage; x <= lastInImage; ++x)
+            {
+              line[x - first] = itk::Math::sqr(selected[x - firstInImage] - current[x - firstInImage]);
+            }
+          }
+          for (IndexValueType x = lastInImage + 1; x <= last; ++x)
+          {
+            line[x - first] = 0.0;
+          }
+        }
+      });
+
+      // The patch distances of the valid pixels.
+      const SizeValueType   validLineLength = validRegion.GetSize(0);
+      const RealValueType * patchDistances = distances.data();
+      if (equalWeights)
+      {
+        // Sum the squared differences over the patch, one dimension after the other.
+        const RealValueType * input = squaredDifferences.data();
+        RealValueType *       output = distances.data();
+        InputImageRegionType  sumRegion = differencesRegion;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          sumRegion.SetIndex(dim, validRegion.GetIndex(dim));
+          sumRegion.SetSize(dim, validRegion.GetSize(dim));
+          const OffsetValueType stride = patchesOffsetTable[dim];
+          const auto            radius = static_cast<OffsetValueType>(patchRadius[dim]);
+          const auto            sumLineLength = static_cast<OffsetValueType>(sumRegion.GetSize(0));
+          forEachLine(sumRegion, [&](const IndexType & lineIndex) {
+            const OffsetValueType position = patchesPosition(lineIndex);
+            for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+            {
+              const RealValueType * const in = input + pc * numberOfPatchValues + position;
+              RealValueType * const       out = output + pc * numberOfPatchValues + position;
+              for (OffsetValueType x = 0; x < sumLineLength; ++x)
+              {
+                out[x] = in[x - radius * stride];
+              }
+              for (OffsetValueType k = 1 - radius; k <= radius; ++k)
+              {
+                for (OffsetValueType x = 0; x < sumLineLength; ++x)
+                {
+                  out[x] += in[x + k * stride];
+                }
+              }
+            }
+          });
+          input = output;
+          output = output == distances.data() ? partialSums.data() : distances.data();
+        }
+        patchDistances = input;
+      }
+      else
+      {
+        // Sum the squared differences along dimension 0 with the weights of each
+        // line of the patch, then sum the lines of the patch.
+        InputImageRegionType lineSumRegion = differencesRegion;
+        lineSumRegion.SetIndex(0, validRegion.GetIndex(0));
+        lineSumRegion.SetSize(0, validRegion.GetSize(0));
+        forEachLine(lineSumRegion, [&](const IndexType & lineIndex) {
+          const OffsetValueType position = patchesPosition(lineIndex);
+          for (size_t lw = 0; lw < lineWeights.size(); ++lw)
+          {
+            for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+            {
+              const RealValueType * const in = squaredDifferences.data() + pc * numberOfPatchValues + position;
+              RealValueType * const out =
+                lineSums.data() + (lw * numberOfComponents + pc) * numberOfPatchValues + position;
+              std::fill_n(out, validLineLength, 0.0);
+              for (const auto & weight : lineWeights[lw])
+              {
+                const RealValueType * const weighted = in + weight.first;
+                for (SizeValueType x = 0; x < validLineLength; ++x)
+                {
+                  out[x] += weight.second * weighted[x];
+                }
+              }
+            }
+          }
+        });
+        forEachLine(validRegion, [&](const IndexType & lineIndex) {
+          const OffsetValueType position = patchesPosition(lineIndex);
+          for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+          {
+            RealValueType * const out = distances.data() + pc * numberOfPatchValues + position;
+            std::fill_n(out, validLineLength, 0.0);
+            for (const auto & patchLine : patchLines)
+            {
+              const RealValueType * const in =
+                lineSums.data() + (patchLine.second * numberOfComponents + pc) * numberOfPatchValues + position +
+                patchLine.first;
+              for (SizeValueType x = 0; x < validLineLength; ++x)
+              {
+                out[x] += in[x];
+              }
+            }
+          }
+        });
+      }
+
+      // Accumulate the Gaussian kernel of the distances, as ComputeGradientJointEntropy does.
+      forEachLine(validRegion, [&](const IndexType & lineIndex) {
+        const OffsetValueType patchPosition = patchesPosition(lineIndex);
+        const OffsetValueType valuePosition = valuesPosition(lineIndex);
+        SizeValueType         tilePosition = 0;
+        SizeValueType         tileStride = 1;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          tilePosition += static_cast<SizeValueType>(lineIndex[dim] - tile.GetIndex(dim)) * tileStride;
+          tileStride *= tile.GetSize(dim);
+        }
+        for (SizeValueType x = 0; x < validLineLength; ++x)
+        {
+          RealValueType distanceJointEntropy = 0.0;
+          RealValueType gaussianJointEntropy = 0.0;
+          for (unsigned int ic = 0; ic < numberOfComponents; ++ic)
+          {
+            distanceJointEntropy +=
+              patchDistances[ic * numberOfPatchValues + patchPosition + x] * scaledSquaredSigmas[ic];
+            gaussianJointEntropy = std::exp(-distanceJointEntropy / 2.0);
+            sumsOfGaussians[tilePosition + x] += gaussianJointEntropy;
+          }
+          for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+          {
+            const RealValueType * const current = values.data() + pc * numberOfValues + valuePosition + x;
+            gradients[(tilePosition + x) * numberOfComponents + pc] +=
+              (current[valuesOffset] - current[0]) * gaussianJointEntropy;
+          }
+        }
+      });
+    }
+
+    unsigned int dim = 0;
+    for (; dim < ImageDimension; ++dim)
+    {
+      if (++searchIndex[dim] <= searchRegion.GetUpperIndex()[dim])
+      {
+        break;
+      }
+      searchIndex[dim] = searchRegion.GetIndex(dim);
+    }
+    if (dim == ImageDimension)
+    {
+      break;
+    }
+  }
+
+  for (SizeValueType n = 0; n < numberOfTilePixels; ++n)
+  {
+    for (unsigned int pc = 0; pc < numberOfComponents; ++pc)
+    {
+      gradients[n * numberOfComponents + pc] /= sumsOfGaussians[n] + m_MinProbability;
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::AddNoiseModelFidelityUpdate(
+  const PixelType &      in,
+  const PixelType &      out,
+  GaussianOperatorType & gOper,
+  RealType &             result) const
+{
+  // We should never have fidelity weight > 0 in the non-Euclidean case
+  // so don't bother checking for component space here
+  const double fidelityWeight = this->GetNoiseModelFidelityWeight();
+  switch (this->GetNoiseModel())
+  {
+    case Superclass::NoiseModelEnum::NOMODEL:
+    {
+      // Do nothing
+      break;
+    }
+    case Superclass::NoiseModelEnum::GAUSSIAN:
+    {
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const RealValueType gradientFidelity = 2.0 * (this->GetComponent(in, pc) - this->GetComponent(out, pc));
+        constexpr RealValueType stepSizeFidelity = 0.5;
+        const RealValueType     noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        this->SetComponent(result, pc, this->GetComponent(result, pc) + noiseVal);
+      }
+      break;
+    }
+    case Superclass::NoiseModelEnum::RICIAN:
+    {
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const PixelValueType inVal = this->GetComponent(in, pc);
+        const PixelValueType outVal = this->GetComponent(out, pc);
+        const RealValueType  sigmaSquared = this->GetComponent(m_NoiseSigmaSquared, pc);
+
+        const RealValueType alpha = inVal * outVal / sigmaSquared;
+        const RealValueType gradientFidelity =
+          (inVal * (gOper.ModifiedBesselI1(alpha) / gOper.ModifiedBesselI0(alpha)) - outVal) / sigmaSquared;
+        const RealValueType stepSizeFidelity = sigmaSquared;
+        // Update
+        const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        // Ensure that the result is nonnegative
+        this->SetComponent(
+          result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.0)));
+      }
+      break;
+    }
+    case Superclass::NoiseModelEnum::POISSON:
+    {
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const PixelValueType inVal = this->GetComponent(in, pc);
+        const PixelValueType outVal = this->GetComponent(out, pc);
+
+        const RealValueType gradientFidelity = (inVal - outVal) / (outVal + 0.00001);
+        // Prevent large unstable updates when out[pc] less than 1
+        const RealValueType stepSizeFidelity = std::min(outVal, static_cast<PixelValueType>(0.99999)) + 0.00001;
+        // Update
+        const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        // Ensure that the result is positive
+        this->SetComponent(
+          result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.00001)));
+      }
+      break;
+    }
+    default:
+    {
+      itkExceptionMacro("Unexpected noise model " << this->GetNoiseModel() << " specified.");
+      break;
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 auto
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeGradientJointEntropy(
@@ -2359,6 +2850,7 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostrea
 
   itkPrintSelfBooleanMacro(UseSmoothDiscPatchWeights);
   itkPrintSelfBooleanMacro(UseFastTensorComputations);
+  itkPrintSelfBooleanMacro(UseFastPatchDistances);
 
   os << indent << "KernelBandwidthSigma: " << m_KernelBandwidthSigma << std::endl;
   itkPrintSelfBooleanMacro(KernelBandwidthSigmaIsSet);
@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPatchBasedDenoisingImageFilter.h"
+#include "itkGaussianRandomSpatialNeighborSubsampler.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVector.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+template <typename TImage>
+struct Problem
+{
+  using ImageType = TImage;
+  using PixelTraits = itk::DefaultConvertPixelTraits<typename ImageType::PixelType>;
+  using FilterType = itk::PatchBasedDenoisingImageFilter<ImageType, ImageType>;
+  using SamplerType = itk::Statistics::SpatialNeighborSubsampler<typename FilterType::PatchSampleType,
+                                                                 typename ImageType::RegionType>;
+
+  // A noisy checkerboard with squares of 5 pixels.
+  explicit Problem(const typename ImageType::SizeType & size)
+    : m_Image(ImageType::New())
+  {
+    m_Image->SetRegions(size);
+    m_Image->Allocate();
+    unsigned int state = 11;
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(m_Image, m_Image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      itk::IndexValueType sum = 0;
+      for (unsigned int d = 0; d < ImageType::ImageDimension; ++d)
+      {
+        sum += it.GetIndex()[d] / 5;
+      }
+      typename ImageType::PixelType pixel;
+      for (unsigned int c = 0; c < PixelTraits::GetNumberOfComponents(); ++c)
+      {
+        state = state * 1103515245u + 12345u;
+        const float noise = 30.0f * static_cast<float>((state >> 16) & 0xFF) / 255.0f;
+        PixelTraits::SetNthComponent(c, pixel, (sum % 2 ? 100.0f : 200.0f) + noise + 10.0f * c);
+      }
+      it.Set(pixel);
+    }
+  }
+
+  typename FilterType::Pointer
+  MakeFilter(unsigned int patchRadius, unsigned int searchRadius, bool useFastPatchDistances) const
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetPatchRadius(patchRadius);
+    auto sampler = SamplerType::New();
+    sampler->SetRadius(searchRadius);
+    filter->SetSampler(sampler);
+    filter->SetNumberOfIterations(2);
+    filter->SetUseFastPatchDistances(useFastPatchDistances);
+    return filter;
+  }
+
+  // Compares the outputs of the filter with and without the fast patch distances.
+  static void
+  ExpectSameOutputs(FilterType * slow, FilterType * fast)
+  {
+    slow->Update();
+    fast->Update();
+    const ImageType & expected = *slow->GetOutput();
+    const ImageType & actual = *fast->GetOutput();
+    ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> expectedIt(&expected, expected.GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> actualIt(&actual, actual.GetBufferedRegion());
+    double                                   maximumDifference = 0.0;
+    double                                   maximumChange = 0.0;
+    for (itk::ImageRegionConstIterator<ImageType> inputIt(slow->GetInput(), expected.GetBufferedRegion());
+         !expectedIt.IsAtEnd();
+         ++expectedIt, ++actualIt, ++inputIt)
+    {
+      for (unsigned int c = 0; c < expected.GetNumberOfComponentsPerPixel(); ++c)
+      {
+        const double expectedValue = PixelTraits::GetNthComponent(c, expectedIt.Get());
+        const double actualValue = PixelTraits::GetNthComponent(c, actualIt.Get());
+        const double inputValue = PixelTraits::GetNthComponent(c, inputIt.Get());
+        maximumDifference = std::max(maximumDifference, std::abs(actualValue - expectedValue));
+        maximumChange = std::max(maximumChange, std::abs(expectedValue - inputValue));
+      }
+    }
+    // The filter denoises, and both computations agree up to rounding.
+    EXPECT_GT(maximumChange, 1.0);
+    EXPECT_LT(maximumDifference, 1e-3);
+  }
+
+  typename ImageType::Pointer m_Image;
+};
+} // namespace
+
+
+TEST(PatchBasedDenoisingImageFilter, FastPatchDistancesWithSmoothDiscWeights)
+{
+  using ProblemType = Problem<itk::Image<float, 2>>;
+  const ProblemType problem(itk::MakeSize(43, 37));
+
+  const auto slow = problem.MakeFilter(2, 6, false);
+  const auto fast = problem.MakeFilter(2, 6, true);
+  for (const auto & filter : { slow, fast })
+  {
+    filter->SetNoiseModel(itk::PatchBasedDenoisingBaseImageFilterEnums::NoiseModel::GAUSSIAN);
+    filter->SetNoiseModelFidelityWeight(0.1);
+  }
+  ProblemType::ExpectSameOutputs(slow, fast);
+}
+
+
+TEST(PatchBasedDenoisingImageFilter, FastPatchDistancesWithEqualWeights)
+{
+  using ProblemType = Problem<itk::Image<float, 3>>;
+  const ProblemType problem(itk::MakeSize(19, 14, 12));
+
+  const auto slow = problem.MakeFilter(2, 3, false);
+  const auto fast = problem.MakeFilter(2, 3, true);
+  slow->UseSmoothDiscPatchWeightsOff();
+  fast->UseSmoothDiscPatchWeightsOff();
+  // Several work units, each with several tiles.
+  fast->SetNumberOfWorkUnits(3);
+  ProblemType::ExpectSameOutputs(slow, fast);
+}
+
+
+TEST(PatchBasedDenoisingImageFilter, FastPatchDistancesOfVectorPixels)
+{
+  using ProblemType = Problem<itk::Image<itk::Vector<float, 2>, 2>>;
+  const ProblemType problem(itk::MakeSize(90, 70));
+
+  const auto slow = problem.MakeFilter(1, 4, false);
+  const auto fast = problem.MakeFilter(1, 4, true);
+  ProblemType::ExpectSameOutputs(slow, fast);
+}
+
+
+TEST(PatchBasedDenoisingImageFilter, FastPatchDistancesIgnoredForRandomSampler)
+{
+  using ProblemType = Problem<itk::Image<float, 2>>;
+  using RandomSamplerType =
+    itk::Statistics::GaussianRandomSpatialNeighborSubsampler<ProblemType::FilterType::PatchSampleType,
+                                                             itk::ImageRegion<2>>;
+  const ProblemType problem(itk::MakeSize(30, 30));
+
+  const auto slow = problem.MakeFilter(1, 5, false);
+  const auto fast = problem.MakeFilter(1, 5, true);
+  for (const auto & filter : { slow, fast })
+  {
+    auto sampler = RandomSamplerType::New();
+    sampler->SetRadius(5);
+    sampler->SetNumberOfResultsRequested(20);
+    filter->SetSampler(sampler);
+    filter->SetNumberOfWorkUnits(1);
+  }
+  // The random samplers select the same pixels from the same seeds.
+  slow->Update();
+  fast->Update();
+  itk::ImageRegionConstIterator<ProblemType::ImageType> expectedIt(slow->GetOutput(),
+                                                                  slow->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ProblemType::ImageType> actualIt(fast->GetOutput(),
+                                                                fast->GetOutput()->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+  }
+}
@@ -52,6 +52,9 @@ namespace itk
  * Danielsson, Per-Erik.  Euclidean Distance Mapping.  Computer
  * Graphics and Image Processing 14, 227-248 (1980).
  *
+ * When ExactDistance is on, the outputs are instead computed from the exact
+ * Euclidean distance transform, with all its passes in parallel.
+ *
  * \ingroup ImageFeatureExtraction
  * \ingroup ITKDistanceMap
  */
@@ -145,6 +148,14 @@ public:
   itkGetConstReferenceMacro(UseImageSpacing, bool);
   itkBooleanMacro(UseImageSpacing);
 
+  /** Set/Get if the exact Euclidean distance should be computed, in
+   * parallel, by EuclideanDistanceTransform instead of the serial
+   * approximation of Danielsson. The outputs are the same images, computed
+   * over the buffered region of the input. Off by default. */
+  itkSetMacro(ExactDistance, bool);
+  itkGetConstReferenceMacro(ExactDistance, bool);
+  itkBooleanMacro(ExactDistance);
+
   /** Get Voronoi Map
    * This map shows for each pixel what object is closest to it.
    * Each object should be labeled by a number (larger than 0),
@@ -204,10 +215,16 @@ protected:
   void
   UpdateLocalDistance(VectorImageType *, const IndexType &, const OffsetType &);
 
+  /** Compute the outputs with the exact Euclidean distance. Used by
+   * GenerateData() when ExactDistance is on. */
+  void
+  ComputeExactDistanceMap();
+
 private:
   bool m_SquaredDistance{};
   bool m_InputIsBinary{};
   bool m_UseImageSpacing{ true };
+  bool m_ExactDistance{ false };
 
   SpacingType m_InputSpacingCache{};
 };
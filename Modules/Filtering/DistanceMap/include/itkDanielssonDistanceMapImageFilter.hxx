@@ -22,6 +22,9 @@
 
 #include "itkReflectiveImageRegionConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkEuclideanDistanceTransform.h"
+#include "itkProgressTransformer.h"
 #include <algorithm> // For max.
 
 namespace itk
@@ -280,10 +283,120 @@ DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::Upda
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
+void
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::ComputeExactDistanceMap()
+{
+  const InputImagePointer   inputImage = dynamic_cast<const InputImageType *>(ProcessObject::GetInput(0));
+  const VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
+  const OutputImagePointer  distanceMap = this->GetDistanceMap();
+  const VectorImagePointer  distanceComponents = this->GetVectorDistanceMap();
+
+  const auto allocate = [&inputImage](ImageBase<InputImageDimension> * image) {
+    image->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
+    image->SetBufferedRegion(inputImage->GetBufferedRegion());
+    image->SetRequestedRegion(inputImage->GetRequestedRegion());
+  };
+  allocate(voronoiMap);
+  voronoiMap->Allocate();
+  allocate(distanceMap);
+  distanceMap->Allocate();
+  allocate(distanceComponents);
+  distanceComponents->Allocate();
+
+  const RegionType region = inputImage->GetBufferedRegion();
+
+  using DistanceTransformType = EuclideanDistanceTransform<Image<double, InputImageDimension>>;
+  using FeatureImageType = typename DistanceTransformType::FeatureImageType;
+  auto squaredDistance = DistanceTransformType::RealImageType::New();
+  squaredDistance->CopyInformation(inputImage);
+  squaredDistance->SetRegions(region);
+  squaredDistance->Allocate();
+  auto nearestFeature = FeatureImageType::New();
+  nearestFeature->CopyInformation(inputImage);
+  nearestFeature->SetRegions(region);
+  nearestFeature->Allocate();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // the non-zero pixels of the input are the objects
+  multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+    region,
+    [&inputImage, &squaredDistance](const RegionType & lambdaRegion) {
+      ImageRegionConstIterator<InputImageType>                          it(inputImage, lambdaRegion);
+      ImageRegionIterator<typename DistanceTransformType::RealImageType> dt(squaredDistance, lambdaRegion);
+      for (; !it.IsAtEnd(); ++it, ++dt)
+      {
+        dt.Set(it.Get() ? 0.0 : NumericTraits<double>::max());
+      }
+    },
+    nullptr);
+
+  {
+    ProgressTransformer distanceProgress(0.0f, 0.9f, this);
+    DistanceTransformType::ComputeSquaredDistance(
+      squaredDistance, m_UseImageSpacing, nearestFeature, multiThreader, distanceProgress.GetProcessObject());
+  }
+
+  // without any object, the vectors are as long as in PrepareData()
+  OffsetType    noObjectVector;
+  SizeValueType maxLength = 0;
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    maxLength = std::max(maxLength, region.GetSize()[dim]);
+  }
+  noObjectVector.Fill(static_cast<OffsetValueType>(2 * maxLength));
+
+  ProgressTransformer mapProgress(0.9f, 1.0f, this);
+  multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+    region,
+    [&](const RegionType & lambdaRegion) {
+      ImageRegionConstIteratorWithIndex<FeatureImageType> ft(nearestFeature, lambdaRegion);
+      ImageRegionIterator<VoronoiImageType>               ot(voronoiMap, lambdaRegion);
+      ImageRegionIterator<VectorImageType>                ct(distanceComponents, lambdaRegion);
+      ImageRegionIterator<OutputImageType>                dt(distanceMap, lambdaRegion);
+      for (; !ft.IsAtEnd(); ++ft, ++ot, ++ct, ++dt)
+      {
+        OffsetType       distanceVector = noObjectVector;
+        VoronoiPixelType label{};
+        if (ft.Get() >= 0)
+        {
+          const IndexType nearest = nearestFeature->ComputeIndex(ft.Get());
+          distanceVector = nearest - ft.GetIndex();
+          label = m_InputIsBinary ? static_cast<VoronoiPixelType>(1)
+                                  : static_cast<VoronoiPixelType>(inputImage->GetPixel(nearest));
+        }
+        ot.Set(label);
+        ct.Set(distanceVector);
+
+        double distance = 0.0;
+        for (unsigned int i = 0; i < InputImageDimension; ++i)
+        {
+          double component = distanceVector[i];
+          if (m_UseImageSpacing)
+          {
+            component *= static_cast<double>(m_InputSpacingCache[i]);
+          }
+          distance += component * component;
+        }
+        dt.Set(static_cast<OutputPixelType>(m_SquaredDistance ? distance : std::sqrt(distance)));
+      }
+    },
+    mapProgress.GetProcessObject());
+}
+
 template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
 void
 DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::GenerateData()
 {
+  if (m_ExactDistance)
+  {
+    this->m_InputSpacingCache = this->GetInput()->GetSpacing();
+    this->ComputeExactDistanceMap();
+    return;
+  }
+
   this->PrepareData();
 
   this->m_InputSpacingCache = this->GetInput()->GetSpacing();
@@ -402,6 +515,7 @@ DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::Prin
   os << indent << "Input Is Binary   : " << m_InputIsBinary << std::endl;
   os << indent << "Use Image Spacing : " << m_UseImageSpacing << std::endl;
   os << indent << "Squared Distance  : " << m_SquaredDistance << std::endl;
+  os << indent << "Exact Distance    : " << m_ExactDistance << std::endl;
 }
 } // end namespace itk
 
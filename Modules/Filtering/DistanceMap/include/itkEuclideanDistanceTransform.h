@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkEuclideanDistanceTransform_h
+#define itkEuclideanDistanceTransform_h
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkProcessObject.h"
+
+namespace itk
+{
+/**
+ * \class EuclideanDistanceTransform
+ *
+ * \brief Computes the exact Euclidean distance transform of an image in
+ * parallel, one dimension after the other.
+ *
+ * The squared distance to the nearest feature pixel is separable: along each
+ * dimension in turn, the squared distance of every pixel of a line is the
+ * lower envelope of the parabolas rooted at the pixels of the line, as
+ * computed by Felzenszwalb and Huttenlocher. The lines of a pass are
+ * independent, and are processed in parallel by tiles of TileSize lines that
+ * are next to each other along the dimension 0. The pixels of a tile are
+ * copied, transposed, to a buffer of the size of the tile, so that the pixels
+ * of a line are contiguous while the image is read and written a row at a
+ * time, whatever the dimension of the pass. The memory used beyond the image
+ * is therefore bounded by that of a tile per work unit, however large the image.
+ *
+ * The nearest feature pixel of each pixel, the Voronoi partition of the
+ * features, may be computed along with the distances, as the offset of the
+ * feature in the buffer of the image.
+ *
+ * The transform is done in place, in the floating point pixel type of the
+ * image, over its buffered region. It is used by
+ * SignedMaurerDistanceMapImageFilter, and by DanielssonDistanceMapImageFilter
+ * when its ExactDistance is on.
+ *
+ * Reference:
+ * P. F. Felzenszwalb and D. P. Huttenlocher, "Distance Transforms of
+ * Sampled Functions", Theory of Computing, 8(19): 415-428, 2012.
+ *
+ * \ingroup ImageFeatureExtraction
+ * \ingroup ITKDistanceMap
+ */
+template <typename TRealImage>
+class ITK_TEMPLATE_EXPORT EuclideanDistanceTransform
+{
+public:
+  static constexpr unsigned int ImageDimension = TRealImage::ImageDimension;
+
+  using RealImageType = TRealImage;
+  using RealType = typename RealImageType::PixelType;
+  using SpacingType = typename RealImageType::SpacingType;
+
+  /** The image of the offsets of the nearest features in the buffer. */
+  using FeatureImageType = Image<OffsetValueType, ImageDimension>;
+
+  /** The number of lines processed together, adjacent along the dimension 0. */
+  static constexpr SizeValueType TileSize = 16;
+
+  /** Replaces, in place, an image that is 0 at the feature pixels and
+   * NumericTraits<RealType>::max() elsewhere by the squared Euclidean distance
+   * to the nearest feature pixel. The distance along each dimension is scaled
+   * by the spacing of the image when useImageSpacing is true. The pixels stay
+   * at NumericTraits<RealType>::max() when there is no feature pixel.
+   *
+   * When nearestFeature is not null, it must have the buffered region of the
+   * image, and it receives the offset in the buffer of the nearest feature
+   * pixel, or -1 when there is none. The work is split over the work units of
+   * the multi-threader, and the progress is reported to the process object,
+   * when it is not null. */
+  static void
+  ComputeSquaredDistance(RealImageType *     image,
+                         bool                useImageSpacing,
+                         FeatureImageType *  nearestFeature,
+                         MultiThreaderBase * multiThreader,
+                         ProcessObject *     progress = nullptr);
+
+private:
+  /** Computes the squared distances of the n pixels of a line, whose
+   * squared distances along the former dimensions are in distances. */
+  static void
+  TransformLine(SizeValueType           n,
+                double                  spacing,
+                const RealType *        distances,
+                const OffsetValueType * features,
+                RealType *              transformedDistances,
+                OffsetValueType *       transformedFeatures,
+                SizeValueType *         sites,
+                double *                boundaries);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkEuclideanDistanceTransform.hxx"
+#endif
+
+#endif
@@ -0,0 +1,279 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkEuclideanDistanceTransform_hxx
+#define itkEuclideanDistanceTransform_hxx
+
+#include "itkNumericTraits.h"
+#include "itkProgressTransformer.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+template <typename TRealImage>
+void
+EuclideanDistanceTransform<TRealImage>::ComputeSquaredDistance(RealImageType *     image,
+                                                               bool                useImageSpacing,
+                                                               FeatureImageType *  nearestFeature,
+                                                               MultiThreaderBase * multiThreader,
+                                                               ProcessObject *     progress)
+{
+  const typename RealImageType::RegionType region = image->GetBufferedRegion();
+  const typename RealImageType::SizeType   size = region.GetSize();
+  const SizeValueType                      numberOfPixels = region.GetNumberOfPixels();
+  if (nearestFeature != nullptr && nearestFeature->GetBufferedRegion() != region)
+  {
+    itkGenericExceptionMacro("The buffered region of the nearest features " << nearestFeature->GetBufferedRegion()
+                                                                            << " differs from that of the image "
+                                                                            << region);
+  }
+  if (numberOfPixels == 0)
+  {
+    return;
+  }
+
+  RealType * const        distances = image->GetBufferPointer();
+  OffsetValueType * const features = nearestFeature != nullptr ? nearestFeature->GetBufferPointer() : nullptr;
+  const OffsetValueType * offsetTable = image->GetOffsetTable();
+  const SpacingType &     spacing = image->GetSpacing();
+  constexpr RealType      infinity = NumericTraits<RealType>::max();
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const SizeValueType n = size[d];
+    const auto          stride = static_cast<SizeValueType>(offsetTable[d]);
+    const double        lineSpacing = useImageSpacing ? static_cast<double>(spacing[d]) : 1.0;
+
+    // Along the dimension 0, the lines of a tile follow each other in the
+    // buffer. Along the other dimensions, they are next to each other.
+    SizeValueType numberOfTiles = 0;
+    SizeValueType tilesPerRow = 1;
+    if (d == 0)
+    {
+      numberOfTiles = (numberOfPixels / n + TileSize - 1) / TileSize;
+    }
+    else
+    {
+      tilesPerRow = (size[0] + TileSize - 1) / TileSize;
+      numberOfTiles = tilesPerRow * (numberOfPixels / (n * size[0]));
+    }
+
+    const auto transformTile = [&](SizeValueType tile) {
+      SizeValueType first = 0;
+      SizeValueType numberOfLines = 0;
+      SizeValueType lineStep = 0;
+      if (d == 0)
+      {
+        first = tile * TileSize * n;
+        numberOfLines = std::min(TileSize, numberOfPixels / n - tile * TileSize);
+        lineStep = n;
+      }
+      else
+      {
+        // the index along the dimension 0, then along the dimensions other than d
+        SizeValueType rest = tile / tilesPerRow;
+        first = (tile % tilesPerRow) * TileSize;
+        numberOfLines = std::min(TileSize, size[0] - first);
+        lineStep = 1;
+        for (unsigned int k = 1; k < ImageDimension; ++k)
+        {
+          if (k != d)
+          {
+            first += (rest % size[k]) * static_cast<SizeValueType>(offsetTable[k]);
+            rest /= size[k];
+          }
+        }
+      }
+      const auto bufferOffset = [first, lineStep, stride](SizeValueType line, SizeValueType i) {
+        return first + line * lineStep + i * stride;
+      };
+
+      // the lines of the tile, transposed to be contiguous
+      std::vector<RealType>        tileDistances(numberOfLines * n);
+      std::vector<RealType>        transformedDistances(numberOfLines * n);
+      std::vector<OffsetValueType> tileFeatures(features != nullptr ? numberOfLines * n : 0);
+      std::vector<OffsetValueType> transformedFeatures(tileFeatures.size());
+      std::vector<SizeValueType>   sites(n);
+      std::vector<double>          boundaries(n);
+
+      const auto gather = [&](SizeValueType line, SizeValueType i) {
+        const SizeValueType offset = bufferOffset(line, i);
+        tileDistances[line * n + i] = distances[offset];
+        if (features != nullptr)
+        {
+          // the first pass starts from the features themselves
+          tileFeatures[line * n + i] = d > 0                           ? features[offset]
+                                       : distances[offset] < infinity ? static_cast<OffsetValueType>(offset)
+                                                                       : -1;
+        }
+      };
+      const auto scatter = [&](SizeValueType line, SizeValueType i) {
+        const SizeValueType offset = bufferOffset(line, i);
+        distances[offset] = transformedDistances[line * n + i];
+        if (features != nullptr)
+        {
+          features[offset] = transformedFeatures[line * n + i];
+        }
+      };
+
+      // read and write the image along its rows
+      if (d == 0)
+      {
+        for (SizeValueType line = 0; line < numberOfLines; ++line)
+        {
+          for (SizeValueType i = 0; i < n; ++i)
+          {
+            gather(line, i);
+          }
+        }
+      }
+      else
+      {
+        for (SizeValueType i = 0; i < n; ++i)
+        {
+          for (SizeValueType line = 0; line < numberOfLines; ++line)
+          {
+            gather(line, i);
+          }
+        }
+      }
+
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        TransformLine(n,
+                      lineSpacing,
+                      tileDistances.data() + line * n,
+                      features != nullptr ? tileFeatures.data() + line * n : nullptr,
+                      transformedDistances.data() + line * n,
+                      features != nullptr ? transformedFeatures.data() + line * n : nullptr,
+                      sites.data(),
+                      boundaries.data());
+      }
+
+      if (d == 0)
+      {
+        for (SizeValueType line = 0; line < numberOfLines; ++line)
+        {
+          for (SizeValueType i = 0; i < n; ++i)
+          {
+            scatter(line, i);
+          }
+        }
+      }
+      else
+      {
+        for (SizeValueType i = 0; i < n; ++i)
+        {
+          for (SizeValueType line = 0; line < numberOfLines; ++line)
+          {
+            scatter(line, i);
+          }
+        }
+      }
+    };
+
+    if (progress != nullptr)
+    {
+      ProgressTransformer passProgress(
+        static_cast<float>(d) / ImageDimension, static_cast<float>(d + 1) / ImageDimension, progress);
+      multiThreader->ParallelizeArray(0, numberOfTiles, transformTile, passProgress.GetProcessObject());
+    }
+    else
+    {
+      multiThreader->ParallelizeArray(0, numberOfTiles, transformTile, nullptr);
+    }
+  }
+}
+
+template <typename TRealImage>
+void
+EuclideanDistanceTransform<TRealImage>::TransformLine(SizeValueType           n,
+                                                      double                  spacing,
+                                                      const RealType *        distances,
+                                                      const OffsetValueType * features,
+                                                      RealType *              transformedDistances,
+                                                      OffsetValueType *       transformedFeatures,
+                                                      SizeValueType *         sites,
+                                                      double *                boundaries)
+{
+  constexpr RealType infinity = NumericTraits<RealType>::max();
+
+  // The lower envelope of the parabolas rooted at the pixels that are at a
+  // finite distance: sites[k] is the pixel of the k-th parabola of the
+  // envelope, which is the lowest from boundaries[k] on.
+  SizeValueType numberOfSites = 0;
+  for (SizeValueType q = 0; q < n; ++q)
+  {
+    if (!(distances[q] < infinity))
+    {
+      continue;
+    }
+    const double x = static_cast<double>(q) * spacing;
+    const double height = static_cast<double>(distances[q]) + x * x;
+    double       boundary = -std::numeric_limits<double>::infinity();
+    while (numberOfSites > 0)
+    {
+      const SizeValueType site = sites[numberOfSites - 1];
+      const double        siteX = static_cast<double>(site) * spacing;
+      boundary = (height - (static_cast<double>(distances[site]) + siteX * siteX)) / (2.0 * (x - siteX));
+      if (boundary > boundaries[numberOfSites - 1])
+      {
+        break;
+      }
+      --numberOfSites;
+    }
+    if (numberOfSites == 0)
+    {
+      boundary = -std::numeric_limits<double>::infinity();
+    }
+    sites[numberOfSites] = q;
+    boundaries[numberOfSites] = boundary;
+    ++numberOfSites;
+  }
+
+  if (numberOfSites == 0)
+  {
+    std::copy(distances, distances + n, transformedDistances);
+    if (features != nullptr)
+    {
+      std::copy(features, features + n, transformedFeatures);
+    }
+    return;
+  }
+
+  SizeValueType k = 0;
+  for (SizeValueType q = 0; q < n; ++q)
+  {
+    const double x = static_cast<double>(q) * spacing;
+    while (k + 1 < numberOfSites && boundaries[k + 1] < x)
+    {
+      ++k;
+    }
+    const double difference = x - static_cast<double>(sites[k]) * spacing;
+    transformedDistances[q] = static_cast<RealType>(difference * difference + static_cast<double>(distances[sites[k]]));
+    if (features != nullptr)
+    {
+      transformedFeatures[q] = features[sites[k]];
+    }
+  }
+}
+} // end namespace itk
+
+#endif
@@ -162,6 +162,12 @@ public:
   /** Set On/Off whether spacing is used. */
   itkBooleanMacro(UseImageSpacing);
 
+  /** Set/Get if the exact Euclidean distance should be computed.
+   * \sa DanielssonDistanceMapImageFilter::SetExactDistance() */
+  itkSetMacro(ExactDistance, bool);
+  itkGetConstReferenceMacro(ExactDistance, bool);
+  itkBooleanMacro(ExactDistance);
+
   /** Set if the inside represents positive values in the signed distance
    *  map. By convention ON pixels are treated as inside pixels.           */
   itkSetMacro(InsideIsPositive, bool);
@@ -222,6 +228,7 @@ protected:
 private:
   bool m_SquaredDistance{};
   bool m_UseImageSpacing{ true };
+  bool m_ExactDistance{ false };
   bool m_InsideIsPositive{}; // ON is treated as inside pixels
 }; // end of SignedDanielssonDistanceMapImageFilter
    // class
@@ -109,6 +109,8 @@ SignedDanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>
   filter2->SetUseImageSpacing(m_UseImageSpacing);
   filter1->SetSquaredDistance(m_SquaredDistance);
   filter2->SetSquaredDistance(m_SquaredDistance);
+  filter1->SetExactDistance(m_ExactDistance);
+  filter2->SetExactDistance(m_ExactDistance);
 
   // Invert input image for second Danielsson filter
   using InputPixelType = typename InputImageType::PixelType;
@@ -184,6 +186,7 @@ SignedDanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>
   os << indent << "Signed Danielson Distance: " << std::endl;
   os << indent << "Use Image Spacing : " << m_UseImageSpacing << std::endl;
   os << indent << "Squared Distance  : " << m_SquaredDistance << std::endl;
+  os << indent << "Exact Distance  : " << m_ExactDistance << std::endl;
   os << indent << "Inside is positive  : " << m_InsideIsPositive << std::endl;
 }
 } // end namespace itk
@@ -50,6 +50,9 @@ namespace itk
  *  the itk::DanielssonDistanceImageFilter class except it does not return
  *  the Voronoi map.
  *
+ *  The distance transform is computed by EuclideanDistanceTransform, from the
+ *  boundary of the object, with all its passes in parallel.
+ *
  *  Reference:
  *  C. R. Maurer, Jr., R. Qi, and V. Raghavan, "A Linear Time Algorithm
  *  for Computing Exact Euclidean Distance Transforms of Binary Images in
@@ -167,33 +170,13 @@ protected:
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
-
-  void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
-
-  void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
-  {
-    itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
-  }
-
 private:
-  void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
-
   InputPixelType   m_BackgroundValue{};
   InputSpacingType m_Spacing{};
 
-  unsigned int m_CurrentDimension{ 0 };
-
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
-
-  const InputImageType * m_InputCache{};
 };
 } // end namespace itk
 
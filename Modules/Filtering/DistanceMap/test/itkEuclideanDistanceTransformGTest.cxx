@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkEuclideanDistanceTransform.h"
+#include "itkDanielssonDistanceMapImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include "itkGTest.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using IndexType = itk::Index<Dimension>;
+using SpacingType = itk::Vector<double, Dimension>;
+
+const itk::Size<Dimension> ImageSize{ { 37, 21, 13 } };
+
+// Some scattered pixels, labeled from 1.
+std::vector<IndexType>
+MakeFeatures(unsigned int numberOfFeatures)
+{
+  std::vector<IndexType> features;
+  unsigned int           state = 12345;
+  for (unsigned int i = 0; i < numberOfFeatures; ++i)
+  {
+    IndexType index;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      state = state * 1103515245u + 12345u;
+      index[d] = (state >> 16) % ImageSize[d];
+    }
+    features.push_back(index);
+  }
+  return features;
+}
+
+double
+SquaredDistance(const IndexType & a, const IndexType & b, const SpacingType & spacing)
+{
+  double distance = 0.0;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const double component = (a[d] - b[d]) * spacing[d];
+    distance += component * component;
+  }
+  return distance;
+}
+
+double
+BruteForceSquaredDistance(const IndexType & index, const std::vector<IndexType> & features, const SpacingType & spacing)
+{
+  double distance = std::numeric_limits<double>::max();
+  for (const IndexType & feature : features)
+  {
+    distance = std::min(distance, SquaredDistance(index, feature, spacing));
+  }
+  return distance;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const std::vector<IndexType> & features,
+          typename TImage::PixelType     background,
+          const SpacingType &            spacing,
+          bool                           labelFeatures)
+{
+  auto image = TImage::New();
+  image->SetRegions(ImageSize);
+  image->SetSpacing(spacing);
+  image->Allocate();
+  image->FillBuffer(background);
+  for (size_t i = 0; i < features.size(); ++i)
+  {
+    image->SetPixel(features[i], static_cast<typename TImage::PixelType>(labelFeatures ? i + 1 : 0));
+  }
+  return image;
+}
+
+template <typename TRealImage>
+void
+CheckDistanceTransform(const std::vector<IndexType> & features, bool useImageSpacing, double tolerance)
+{
+  using TransformType = itk::EuclideanDistanceTransform<TRealImage>;
+  using RealType = typename TRealImage::PixelType;
+  constexpr RealType infinity = itk::NumericTraits<RealType>::max();
+
+  const SpacingType spacing = itk::MakeVector(0.7, 1.3, 2.1);
+  const SpacingType usedSpacing = useImageSpacing ? spacing : itk::MakeVector(1.0, 1.0, 1.0);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+  {
+    const auto image = MakeImage<TRealImage>(features, infinity, spacing, false);
+    auto       nearestFeature = TransformType::FeatureImageType::New();
+    nearestFeature->SetRegions(ImageSize);
+    nearestFeature->Allocate();
+
+    const auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    TransformType::ComputeSquaredDistance(image, useImageSpacing, nearestFeature, multiThreader);
+
+    for (itk::ImageRegionConstIteratorWithIndex<TRealImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const IndexType            index = it.GetIndex();
+      const itk::OffsetValueType feature = nearestFeature->GetPixel(index);
+      if (features.empty())
+      {
+        ASSERT_EQ(it.Get(), infinity);
+        ASSERT_EQ(feature, -1);
+        continue;
+      }
+      const double expected = BruteForceSquaredDistance(index, features, usedSpacing);
+      ASSERT_NEAR(it.Get(), expected, tolerance * (1.0 + expected)) << index;
+
+      // the nearest feature is a feature at that distance, maybe one of several
+      ASSERT_GE(feature, 0);
+      const IndexType featureIndex = nearestFeature->ComputeIndex(feature);
+      ASSERT_NE(std::find(features.cbegin(), features.cend(), featureIndex), features.cend());
+      ASSERT_NEAR(SquaredDistance(index, featureIndex, usedSpacing), expected, tolerance * (1.0 + expected));
+    }
+  }
+}
+
+} // namespace
+
+
+TEST(EuclideanDistanceTransform, MatchesBruteForce)
+{
+  const std::vector<IndexType> features = MakeFeatures(40);
+  CheckDistanceTransform<itk::Image<double, Dimension>>(features, true, 1e-12);
+  CheckDistanceTransform<itk::Image<double, Dimension>>(features, false, 1e-12);
+  CheckDistanceTransform<itk::Image<float, Dimension>>(features, true, 1e-6);
+  CheckDistanceTransform<itk::Image<float, Dimension>>(MakeFeatures(1), false, 1e-6);
+}
+
+
+TEST(EuclideanDistanceTransform, WithoutFeatures)
+{
+  CheckDistanceTransform<itk::Image<float, Dimension>>({}, true, 0.0);
+}
+
+
+TEST(EuclideanDistanceTransform, SignedMaurerDistanceMapImageFilter)
+{
+  // Isolated object pixels are their own boundary.
+  using InputImageType = itk::Image<unsigned char, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+  std::vector<IndexType> features;
+  for (const IndexType & feature : MakeFeatures(12))
+  {
+    features.push_back(feature);
+    for (IndexType & other : features)
+    {
+      if (&other != &features.back() && SquaredDistance(feature, other, itk::MakeVector(1.0, 1.0, 1.0)) < 4.0)
+      {
+        features.pop_back();
+        break;
+      }
+    }
+  }
+  const SpacingType spacing = itk::MakeVector(0.5, 1.0, 3.0);
+  const auto        input = MakeImage<InputImageType>(features, 0, spacing, true);
+
+  for (const bool squaredDistance : { false, true })
+  {
+    const auto filter = itk::SignedMaurerDistanceMapImageFilter<InputImageType, OutputImageType>::New();
+    filter->SetInput(input);
+    filter->SetSquaredDistance(squaredDistance);
+    filter->SetNumberOfWorkUnits(3);
+    filter->Update();
+
+    for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(filter->GetOutput(),
+                                                                    filter->GetOutput()->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const double expected = BruteForceSquaredDistance(it.GetIndex(), features, spacing);
+      ASSERT_NEAR(it.Get(), squaredDistance ? expected : std::sqrt(expected), 1e-4 * (1.0 + expected));
+    }
+  }
+}
+
+
+TEST(EuclideanDistanceTransform, ExactDanielssonDistanceMapImageFilter)
+{
+  using InputImageType = itk::Image<short, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+  const std::vector<IndexType> features = MakeFeatures(30);
+  const SpacingType            spacing = itk::MakeVector(1.5, 1.0, 0.25);
+  const auto                   input = MakeImage<InputImageType>(features, 0, spacing, true);
+
+  const auto filter = itk::DanielssonDistanceMapImageFilter<InputImageType, OutputImageType>::New();
+  filter->SetInput(input);
+  filter->SetExactDistance(true);
+  filter->SetNumberOfWorkUnits(4);
+  filter->Update();
+
+  const auto * voronoiMap = filter->GetVoronoiMap();
+  const auto * vectorMap = filter->GetVectorDistanceMap();
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(filter->GetDistanceMap(),
+                                                                  filter->GetDistanceMap()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const IndexType index = it.GetIndex();
+    const double    expected = BruteForceSquaredDistance(index, features, spacing);
+    ASSERT_NEAR(it.Get(), std::sqrt(expected), 1e-5 * (1.0 + expected));
+
+    // the vector leads to the nearest object, whose label is in the Voronoi map
+    const IndexType nearest = index + vectorMap->GetPixel(index);
+    ASSERT_EQ(input->GetPixel(nearest), voronoiMap->GetPixel(index));
+    ASSERT_NEAR(SquaredDistance(index, nearest, spacing), expected, 1e-9 * (1.0 + expected));
+  }
+}
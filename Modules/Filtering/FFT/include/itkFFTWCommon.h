@@ -33,7 +33,10 @@
 
 #endif
 
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -69,6 +72,8 @@ public:
   using PixelType = float;
   using ComplexType = fftwf_complex;
   using PlanType = fftwf_plan;
+  using PlanValueType = std::remove_pointer_t<PlanType>;
+  using PlanPointer = std::shared_ptr<PlanValueType>;
   using Self = Proxy<float>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
@@ -373,6 +378,74 @@ public:
   }
 
 
+  /** Returns a plan of Plan_dft_c2r(), Plan_dft_r2c() or Plan_dft() that is
+   * cached process-wide by FFTWGlobalConfiguration, keyed by the sizes, the
+   * direction, the flags, the number of threads, and the alignment and
+   * placement of the arrays. The plan is created on first use only, and
+   * must be executed with Execute_dft_c2r(), Execute_dft_r2c() or
+   * Execute_dft() on arrays aligned as the arrays it was created with. A
+   * plan may be executed by several threads at once. */
+  static PlanPointer
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("c2r", rank, n, 0, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  static PlanPointer
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("r2c", rank, n, 0, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  static PlanPointer
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads = 1,
+                    bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("dft", rank, n, sign, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    });
+  }
+
+  static void
+  Execute_dft_c2r(const PlanPointer & p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft_r2c(const PlanPointer & p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft(const PlanPointer & p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p.get(), in, out);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -386,6 +459,42 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+private:
+  template <typename TCreatePlan>
+  static PlanPointer
+  GetCachedPlan(const char *        kind,
+                int                 rank,
+                const int *         n,
+                int                 sign,
+                unsigned int        flags,
+                int                 threads,
+                bool                canDestroyInput,
+                void *              in,
+                void *              out,
+                const TCreatePlan & createPlan)
+  {
+#  ifdef ITK_USE_CUFFTW
+    return PlanPointer(createPlan(), DestroyPlan);
+#  else
+    std::ostringstream key;
+    key << "fftwf " << kind << ' ' << sign << ' ' << flags << ' ' << threads << ' ' << canDestroyInput << ' '
+        << (in == out) << ' ' << fftwf_alignment_of(static_cast<PixelType *>(in)) << ' '
+        << fftwf_alignment_of(static_cast<PixelType *>(out));
+    for (int i = 0; i < rank; ++i)
+    {
+      key << ' ' << n[i];
+    }
+    // The mutex outlives the cached plans, which are destroyed with FFTWGlobalConfiguration.
+    std::mutex * const mutex = &FFTWGlobalConfiguration::GetLockMutex();
+    return std::static_pointer_cast<PlanValueType>(FFTWGlobalConfiguration::GetCachedPlan(key.str(), [&]() {
+      return std::shared_ptr<void>(createPlan(), [mutex](void * plan) {
+        const std::lock_guard<std::mutex> lockGuard(*mutex);
+        fftwf_destroy_plan(static_cast<PlanType>(plan));
+      });
+    }));
+#  endif
+  }
 };
 
 #endif // ITK_USE_FFTWF
@@ -399,6 +508,8 @@ public:
   using PixelType = double;
   using ComplexType = fftw_complex;
   using PlanType = fftw_plan;
+  using PlanValueType = std::remove_pointer_t<PlanType>;
+  using PlanPointer = std::shared_ptr<PlanValueType>;
   using Self = Proxy<double>;
 
   // FFTW works with any data size, but is optimized for size decomposition with prime factors up to 13.
@@ -702,6 +813,74 @@ public:
   }
 
 
+  /** Returns a plan of Plan_dft_c2r(), Plan_dft_r2c() or Plan_dft() that is
+   * cached process-wide by FFTWGlobalConfiguration, keyed by the sizes, the
+   * direction, the flags, the number of threads, and the alignment and
+   * placement of the arrays. The plan is created on first use only, and
+   * must be executed with Execute_dft_c2r(), Execute_dft_r2c() or
+   * Execute_dft() on arrays aligned as the arrays it was created with. A
+   * plan may be executed by several threads at once. */
+  static PlanPointer
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("c2r", rank, n, 0, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  static PlanPointer
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("r2c", rank, n, 0, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  static PlanPointer
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads = 1,
+                    bool          canDestroyInput = false)
+  {
+    return GetCachedPlan("dft", rank, n, sign, flags, threads, canDestroyInput, in, out, [=]() {
+      return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    });
+  }
+
+  static void
+  Execute_dft_c2r(const PlanPointer & p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft_r2c(const PlanPointer & p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p.get(), in, out);
+  }
+
+  static void
+  Execute_dft(const PlanPointer & p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p.get(), in, out);
+  }
+
   static void
   Execute(PlanType p)
   {
@@ -715,6 +894,42 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+private:
+  template <typename TCreatePlan>
+  static PlanPointer
+  GetCachedPlan(const char *        kind,
+                int                 rank,
+                const int *         n,
+                int                 sign,
+                unsigned int        flags,
+                int                 threads,
+                bool                canDestroyInput,
+                void *              in,
+                void *              out,
+                const TCreatePlan & createPlan)
+  {
+#  ifdef ITK_USE_CUFFTW
+    return PlanPointer(createPlan(), DestroyPlan);
+#  else
+    std::ostringstream key;
+    key << "fftw " << kind << ' ' << sign << ' ' << flags << ' ' << threads << ' ' << canDestroyInput << ' '
+        << (in == out) << ' ' << fftw_alignment_of(static_cast<PixelType *>(in)) << ' '
+        << fftw_alignment_of(static_cast<PixelType *>(out));
+    for (int i = 0; i < rank; ++i)
+    {
+      key << ' ' << n[i];
+    }
+    // The mutex outlives the cached plans, which are destroyed with FFTWGlobalConfiguration.
+    std::mutex * const mutex = &FFTWGlobalConfiguration::GetLockMutex();
+    return std::static_pointer_cast<PlanValueType>(FFTWGlobalConfiguration::GetCachedPlan(key.str(), [&]() {
+      return std::shared_ptr<void>(createPlan(), [mutex](void * plan) {
+        const std::lock_guard<std::mutex> lockGuard(*mutex);
+        fftw_destroy_plan(static_cast<PlanType>(plan));
+      });
+    }));
+#  endif
+  }
 };
 
 #endif
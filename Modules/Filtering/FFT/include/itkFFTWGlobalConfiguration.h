@@ -35,6 +35,10 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <deque>
+#  include <functional>
+#  include <map>
+#  include <memory>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -348,6 +352,22 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /** The maximum number of plans kept by the plan cache. */
+  static constexpr unsigned int MaximumNumberOfCachedPlans = 32;
+
+  /** Returns the plan cached with the key, or else caches and returns the
+   * plan returned by createPlan. The filters get their plans through
+   * fftw::Proxy::GetCachedPlan_dft() and the like, so that a plan is
+   * created once per size, direction and flags, instead of at each update.
+   * When the cache is full, the oldest plan is released from it; it is
+   * destroyed once no filter uses it anymore. */
+  static std::shared_ptr<void>
+  GetCachedPlan(const std::string & key, const std::function<std::shared_ptr<void>()> & createPlan);
+
+  /** Releases all the plans of the plan cache. */
+  static void
+  ReleaseCachedPlans();
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -376,6 +396,11 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  // The plan cache, and its keys from the oldest to the newest.
+  std::mutex                                   m_PlanCacheMutex;
+  std::map<std::string, std::shared_ptr<void>> m_CachedPlans;
+  std::deque<std::string>                      m_CachedPlanKeys;
 };
 } // namespace itk
 #endif
@@ -21,6 +21,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
+#include "itkFFTWorkBuffer.h"
+#include <optional>
 
 namespace itk
 {
@@ -75,6 +77,7 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
   // FFTW_PRESERVE_INPUT flag at this time. So if the input can't be
   // destroyed, we have to copy the input data to a buffer before
   // running the IFFT.
+  std::optional<FFTWorkBuffer<typename InputImageType::PixelType>> inputCopy;
   typename FFTWProxyType::ComplexType * const in = [&]() -> typename FFTWProxyType::ComplexType * {
     if (m_CanUseDestructiveAlgorithm)
     {
@@ -85,24 +88,24 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     else
     {
       // We must use a buffer where fftw can work and destroy what it wants.
-      return new typename FFTWProxyType::ComplexType[totalInputSize];
+      inputCopy.emplace(totalInputSize);
+      return reinterpret_cast<typename FFTWProxyType::ComplexType *>(inputCopy->data());
     }
   }();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
+  const auto plan = FFTWProxyType::GetCachedPlan_dft_c2r(ImageDimension,
+                                                         sizes,
+                                                         in,
+                                                         out,
+                                                         m_PlanRigor,
+                                                         MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                                         !m_CanUseDestructiveAlgorithm);
   if (!m_CanUseDestructiveAlgorithm)
   {
     // complex<double> and double[2] types are compatible memory layouts.
@@ -111,14 +114,7 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     std::copy_n(
       inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
   }
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
-  if (!m_CanUseDestructiveAlgorithm)
-  {
-    delete[] in;
-  }
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 }
 
 template <typename TInputImage, typename TOutputImage>
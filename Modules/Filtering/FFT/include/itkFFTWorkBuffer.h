@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFFTWorkBuffer_h
+#define itkFFTWorkBuffer_h
+
+#include "ITKFFTExport.h"
+
+#include "itkPooledImageBufferAllocator.h"
+#include "itkSingletonMacro.h"
+#include <type_traits>
+
+namespace itk
+{
+struct FFTWorkBufferGlobals;
+
+/** \class FFTWorkBufferAllocator
+ * \brief Process-wide allocator of the work buffers of the FFT filters.
+ *
+ * The FFT filters transform their data in work buffers, such as the complex
+ * signal of the Vnl filters, or the copy of an input that FFTW may destroy.
+ * Filters that are updated over and over on images of the same size, as in
+ * the iterations of a deconvolution, would allocate, page fault, and
+ * release buffers of the same sizes each time. These buffers are instead
+ * taken from a PooledImageBufferAllocator, shared by all the FFT filters,
+ * that keeps at most 512 MiB of released buffers by default.
+ *
+ * \sa FFTWorkBuffer
+ * \ingroup ITKFFT
+ */
+class ITKFFT_EXPORT FFTWorkBufferAllocator
+{
+public:
+  /** Returns the allocator of the work buffers, which is created on first use. */
+  static PooledImageBufferAllocator *
+  GetInstance();
+
+private:
+  itkGetGlobalDeclarationMacro(FFTWorkBufferGlobals, PimplGlobals);
+  static FFTWorkBufferGlobals * m_PimplGlobals;
+};
+
+/** \class FFTWorkBuffer
+ * \brief Uninitialized work buffer of an FFT filter, aligned on 64 bytes.
+ *
+ * The buffer is allocated by the FFTWorkBufferAllocator, and released to
+ * its pool when the FFTWorkBuffer is destroyed.
+ *
+ * \ingroup ITKFFT
+ */
+template <typename T>
+class FFTWorkBuffer
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FFTWorkBuffer);
+
+  static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                "The work buffers only hold trivial values, such as real and complex numbers.");
+
+  explicit FFTWorkBuffer(SizeValueType size)
+    : m_Size(size)
+    , m_Buffer(static_cast<T *>(FFTWorkBufferAllocator::GetInstance()->Allocate(size * sizeof(T), false)))
+  {}
+
+  ~FFTWorkBuffer() { FFTWorkBufferAllocator::GetInstance()->Deallocate(m_Buffer, m_Size * sizeof(T)); }
+
+  T *
+  data()
+  {
+    return m_Buffer;
+  }
+
+  const T *
+  data() const
+  {
+    return m_Buffer;
+  }
+
+  SizeValueType
+  size() const
+  {
+    return m_Size;
+  }
+
+  T &
+  operator[](SizeValueType i)
+  {
+    return m_Buffer[i];
+  }
+
+  const T &
+  operator[](SizeValueType i) const
+  {
+    return m_Buffer[i];
+  }
+
+private:
+  SizeValueType m_Size;
+  T *           m_Buffer;
+};
+} // end namespace itk
+
+#endif
@@ -25,8 +25,8 @@
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
+#include "itkVnlFFTCommon.h"
+#include "itkFFTWorkBuffer.h"
 
 namespace itk
 {
@@ -61,51 +61,46 @@ VnlComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
       outputIt.SetDirection(direction);
 
       using PixelType = typename TInputImage::PixelType;
-      using VNLVectorType = vnl_vector<PixelType>;
-      VNLVectorType                    inputBuffer(vectorSize);
-      typename VNLVectorType::iterator inputBufferIt = inputBuffer.begin();
-      // fft is done in-place
-      typename VNLVectorType::iterator                         outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<typename NumericTraits<PixelType>::ValueType> v1d(vectorSize);
-
-      // for every fft line
-      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
-      {
-        // copy the input line into our buffer
-        inputIt.GoToBeginOfLine();
-        inputBufferIt = inputBuffer.begin();
-        while (!inputIt.IsAtEndOfLine())
-        {
-          *inputBufferIt = inputIt.Get();
-          ++inputIt;
-          ++inputBufferIt;
-        }
+      using ValueType = typename NumericTraits<PixelType>::ValueType;
+      using ComplexType = std::complex<ValueType>;
+      const auto factors = VnlFFTCommon::GetPrimeFactors<ValueType>(vectorSize);
+      const bool isDirect = this->m_TransformDirection == Superclass::DIRECT;
 
-        // do the transform
-        if (this->m_TransformDirection == Superclass::DIRECT)
+      // The lines are gathered by batches, interleaved in the buffer, so
+      // that each batch is transformed at once.
+      constexpr SizeValueType    batchSize = VnlFFTCommon::NumberOfLinesPerBatch;
+      FFTWorkBuffer<ComplexType> buffer(batchSize * vectorSize);
+
+      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd();)
+      {
+        // copy a batch of input lines into our buffer
+        SizeValueType numberOfLines = 0;
+        for (; numberOfLines < batchSize && !inputIt.IsAtEnd(); ++numberOfLines, inputIt.NextLine())
         {
-          v1d.bwd_transform(inputBuffer);
-          // copy the output from the buffer into our line
-          outputBufferIt = inputBuffer.begin();
-          outputIt.GoToBeginOfLine();
-          while (!outputIt.IsAtEndOfLine())
+          for (ComplexType * bufferIt = buffer.data() + numberOfLines; !inputIt.IsAtEndOfLine(); ++inputIt)
           {
-            outputIt.Set(*outputBufferIt);
-            ++outputIt;
-            ++outputBufferIt;
+            *bufferIt = inputIt.Get();
+            bufferIt += batchSize;
           }
         }
-        else // m_TransformDirection == INVERSE
+
+        // do the transform
+        VnlFFTCommon::TransformLines(buffer.data(), *factors, batchSize, 1, numberOfLines, isDirect ? -1 : 1);
+
+        // copy the output from the buffer into our lines
+        for (SizeValueType line = 0; line < numberOfLines; ++line, outputIt.NextLine())
         {
-          v1d.fwd_transform(inputBuffer);
-          // copy the output from the buffer into our line
-          outputBufferIt = inputBuffer.begin();
-          outputIt.GoToBeginOfLine();
-          while (!outputIt.IsAtEndOfLine())
+          for (const ComplexType * bufferIt = buffer.data() + line; !outputIt.IsAtEndOfLine(); ++outputIt)
           {
-            outputIt.Set((*outputBufferIt) / static_cast<PixelType>(vectorSize));
-            ++outputIt;
-            ++outputBufferIt;
+            if (isDirect)
+            {
+              outputIt.Set(*bufferIt);
+            }
+            else // m_TransformDirection == INVERSE
+            {
+              outputIt.Set((*bufferIt) / static_cast<PixelType>(vectorSize));
+            }
+            bufferIt += batchSize;
           }
         }
       }
@@ -18,12 +18,18 @@
 #ifndef itkVnlFFTCommon_h
 #define itkVnlFFTCommon_h
 
+#include "ITKFFTExport.h"
+
 #include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
 
-#include "vnl/algo/vnl_fft_base.h"
+#include "vnl/algo/vnl_fft_prime_factors.h"
+#include <complex>
+#include <memory>
 
 namespace itk
 {
+struct VnlFFTCommonGlobals;
 
 /**
  * \class VnlFFTCommon
@@ -31,7 +37,7 @@ namespace itk
  *
  * \ingroup ITKFFT
  */
-struct VnlFFTCommon
+struct ITKFFT_EXPORT VnlFFTCommon
 {
 
   /** Vnl's FFT supports discrete Fourier transforms for images whose
@@ -42,16 +48,64 @@ struct VnlFFTCommon
 
   static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
 
+  /** The prime factors and twiddle factors of the transforms of a size. */
+  template <typename TValue>
+  using PrimeFactorsPointer = std::shared_ptr<const vnl_fft_prime_factors<TValue>>;
+
+  /** Returns the prime factors and twiddle factors of the transforms of the
+  given size. They are computed once per size and precision, and cached
+  process-wide, so that the filters that transform images of the same size
+  over and over, or line by line, do not compute them each time. */
+  template <typename TValue>
+  static PrimeFactorsPointer<TValue>
+  GetPrimeFactors(SizeValueType n);
+
+  /** Transforms in place numberOfLines lines of the signal, each of the
+  size of the factors. The values of a line are separated by stride complex
+  values, and the first values of two consecutive lines by distance complex
+  values. All the lines are transformed at once by vnl_fft_gpfa, which
+  vectorizes its butterflies over the lines. The direction is -1 for the
+  forward transform, and +1 for the unnormalized inverse transform. */
+  template <typename TValue>
+  static void
+  TransformLines(std::complex<TValue> *               signal,
+                 const vnl_fft_prime_factors<TValue> & factors,
+                 SizeValueType                         stride,
+                 SizeValueType                         distance,
+                 SizeValueType                         numberOfLines,
+                 int                                   direction);
+
+  /** The number of lines the 1D filters gather to transform them at once
+  with TransformLines(). */
+  static constexpr SizeValueType NumberOfLinesPerBatch = 32;
+
   /** Convenience struct for computing the discrete Fourier
   Transform. */
   template <typename TImage>
-  struct VnlFFTTransform : public vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>
+  struct VnlFFTTransform
   {
-    using Base = vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>;
+    using ValueType = typename TImage::PixelType;
 
     //: constructor takes size of signal.
     VnlFFTTransform(const typename TImage::SizeType & s);
+
+    //: dir = +1/-1 according to direction of transform.
+    void
+    transform(std::complex<ValueType> * signal, int dir) const;
+
+  private:
+    typename TImage::SizeType      m_Size;
+    PrimeFactorsPointer<ValueType> m_Factors[TImage::ImageDimension];
   };
+
+private:
+  static PrimeFactorsPointer<float>
+  GetPrimeFactorsFloat(SizeValueType n);
+  static PrimeFactorsPointer<double>
+  GetPrimeFactorsDouble(SizeValueType n);
+
+  itkGetGlobalDeclarationMacro(VnlFFTCommonGlobals, PimplGlobals);
+  static VnlFFTCommonGlobals * m_PimplGlobals;
 };
 } // namespace itk
 
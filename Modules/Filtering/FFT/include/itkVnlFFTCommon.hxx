@@ -18,6 +18,9 @@
 #ifndef itkVnlFFTCommon_hxx
 #define itkVnlFFTCommon_hxx
 
+#include "vnl/algo/vnl_fft.h"
+#include "itkMacro.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -39,12 +42,86 @@ VnlFFTCommon::IsDimensionSizeLegal(TSizeValue n)
   return (n == 1); // return false if decomposition failed
 }
 
+template <typename TValue>
+auto
+VnlFFTCommon::GetPrimeFactors(SizeValueType n) -> PrimeFactorsPointer<TValue>
+{
+  static_assert(std::is_same_v<TValue, float> || std::is_same_v<TValue, double>,
+                "Vnl's FFT only supports float and double values.");
+  if constexpr (std::is_same_v<TValue, float>)
+  {
+    return GetPrimeFactorsFloat(n);
+  }
+  else
+  {
+    return GetPrimeFactorsDouble(n);
+  }
+}
+
+template <typename TValue>
+void
+VnlFFTCommon::TransformLines(std::complex<TValue> *               signal,
+                             const vnl_fft_prime_factors<TValue> & factors,
+                             SizeValueType                         stride,
+                             SizeValueType                         distance,
+                             SizeValueType                         numberOfLines,
+                             int                                   direction)
+{
+  // This relies on std::complex<T> being layout compatible with T[2].
+  auto * data = reinterpret_cast<TValue *>(signal);
+  long   info = 0;
+  vnl_fft_gpfa(/* A */ data,
+               /* B */ data + 1,
+               /* TRIGS */ factors.trigs(),
+               /* INC */ static_cast<long>(2 * stride),
+               /* JUMP */ static_cast<long>(2 * distance),
+               /* N */ factors.number(),
+               /* LOT */ static_cast<long>(numberOfLines),
+               /* ISIGN */ direction,
+               /* NIPQ */ factors.pqr(),
+               /* INFO */ &info);
+  itkAssertOrThrowMacro(info != -1, "Vnl's FFT failed on lines of size " << factors.number() << '.');
+}
+
 template <typename TImage>
 VnlFFTCommon::VnlFFTTransform<TImage>::VnlFFTTransform(const typename TImage::SizeType & s)
+  : m_Size(s)
+{
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    m_Factors[i] = GetPrimeFactors<ValueType>(s[i]);
+  }
+}
+
+template <typename TImage>
+void
+VnlFFTCommon::VnlFFTTransform<TImage>::transform(std::complex<ValueType> * signal, int dir) const
 {
+  // Transform along each dimension in turn. Pretend the signal is
+  // N1xN2xN3, N3 being the fastest, and transform along N2, all the lines
+  // of an n1 slab at once, or, along the fastest dimension, all the lines.
+  SizeValueType numberOfSlabs = 1;
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    numberOfSlabs *= m_Size[i];
+  }
+  SizeValueType N3 = 1;
   for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
   {
-    Base::factors_[TImage::ImageDimension - i - 1].resize(s[i]);
+    const SizeValueType N2 = m_Size[i];
+    numberOfSlabs /= N2;
+    if (i == 0)
+    {
+      TransformLines(signal, *m_Factors[i], 1, N2, numberOfSlabs, dir);
+    }
+    else
+    {
+      for (SizeValueType n1 = 0; n1 < numberOfSlabs; ++n1)
+      {
+        TransformLines(signal + n1 * N2 * N3, *m_Factors[i], N3, 1, N3, dir);
+      }
+    }
+    N3 *= N2;
   }
 }
 
@@ -26,8 +26,7 @@
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
 #include "itkVnlFFTCommon.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
+#include "itkFFTWorkBuffer.h"
 
 namespace itk
 {
@@ -68,37 +67,37 @@ VnlForward1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
       using PixelType = typename TInputImage::PixelType;
       using ComplexType = std::complex<PixelType>;
-      using ComplexVectorType = vnl_vector<ComplexType>;
-      ComplexVectorType                    inputBuffer(vectorSize);
-      typename ComplexVectorType::iterator inputBufferIt = inputBuffer.begin();
-      // fft is done in-place
-      typename ComplexVectorType::iterator outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<PixelType>                v1d(vectorSize);
-
-      // for every fft line
-      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
+      const auto factors = VnlFFTCommon::GetPrimeFactors<PixelType>(vectorSize);
+
+      // The lines are gathered by batches, interleaved in the buffer, so
+      // that each batch is transformed at once.
+      constexpr SizeValueType    batchSize = VnlFFTCommon::NumberOfLinesPerBatch;
+      FFTWorkBuffer<ComplexType> buffer(batchSize * vectorSize);
+
+      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd();)
       {
-        // copy the input line into our buffer
-        inputIt.GoToBeginOfLine();
-        inputBufferIt = inputBuffer.begin();
-        while (!inputIt.IsAtEndOfLine())
+        // copy a batch of input lines into our buffer
+        SizeValueType numberOfLines = 0;
+        for (; numberOfLines < batchSize && !inputIt.IsAtEnd(); ++numberOfLines, inputIt.NextLine())
         {
-          *inputBufferIt = inputIt.Value();
-          ++inputIt;
-          ++inputBufferIt;
+          for (ComplexType * bufferIt = buffer.data() + numberOfLines; !inputIt.IsAtEndOfLine(); ++inputIt)
+          {
+            *bufferIt = inputIt.Value();
+            bufferIt += batchSize;
+          }
         }
 
         // do the transform
-        v1d.bwd_transform(inputBuffer);
+        VnlFFTCommon::TransformLines(buffer.data(), *factors, batchSize, 1, numberOfLines, -1);
 
-        // copy the output from the buffer into our line
-        outputBufferIt = inputBuffer.begin();
-        outputIt.GoToBeginOfLine();
-        while (!outputIt.IsAtEndOfLine())
+        // copy the output from the buffer into our lines
+        for (SizeValueType line = 0; line < numberOfLines; ++line, outputIt.NextLine())
         {
-          outputIt.Set(*outputBufferIt);
-          ++outputIt;
-          ++outputBufferIt;
+          for (const ComplexType * bufferIt = buffer.data() + line; !outputIt.IsAtEndOfLine(); ++outputIt)
+          {
+            outputIt.Set(*bufferIt);
+            bufferIt += batchSize;
+          }
         }
       }
     },
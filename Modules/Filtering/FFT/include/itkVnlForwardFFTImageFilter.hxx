@@ -19,6 +19,7 @@
 #define itkVnlForwardFFTImageFilter_hxx
 
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkFFTWorkBuffer.h"
 #include "itkProgressReporter.h"
 #include "itkVnlFFTCommon.h"
 
@@ -60,8 +61,8 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     vectorSize *= inputSize[i];
   }
 
-  const InputPixelType * in = inputPtr->GetBufferPointer();
-  SignalVectorType       signal(vectorSize);
+  const InputPixelType *                      in = inputPtr->GetBufferPointer();
+  FFTWorkBuffer<std::complex<InputPixelType>> signal(vectorSize);
   for (unsigned int i = 0; i < vectorSize; ++i)
   {
     signal[i] = in[i];
@@ -69,7 +70,7 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
+  vnlfft.transform(signal.data(), -1);
 
   // Copy the VNL output back to the ITK image.
   for (ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion()); !oIt.IsAtEnd();
@@ -19,6 +19,7 @@
 #define itkVnlHalfHermitianToRealInverseFFTImageFilter_hxx
 
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkFFTWorkBuffer.h"
 #include "itkProgressReporter.h"
 
 namespace itk
@@ -65,7 +66,7 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
 
   // VNL requires the full complex result of the transform, so we
   // produce it here from the half complex image assumed when the output is real.
-  SignalVectorType signal(vectorSize);
+  FFTWorkBuffer<InputPixelType> signal(vectorSize);
 
   const OutputIndexValueType maxXIndex = inputIndex[0] + static_cast<OutputIndexValueType>(inputSize[0]);
   unsigned int               si = 0;
@@ -97,7 +98,7 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
 
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<OutputImageType> vnlfft(outputSize);
-  vnlfft.transform(signal.data_block(), 1);
+  vnlfft.transform(signal.data(), 1);
 
   // Copy the VNL output back to the ITK image. Extract the real part
   // of the signal. Ideally, the normalization by the number of
@@ -25,8 +25,8 @@
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
+#include "itkVnlFFTCommon.h"
+#include "itkFFTWorkBuffer.h"
 
 namespace itk
 {
@@ -61,36 +61,38 @@ VnlInverse1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
       outputIt.SetDirection(direction);
 
       using OutputPixelType = typename TOutputImage::PixelType;
-      vnl_vector<std::complex<OutputPixelType>>                    inputBuffer(vectorSize);
-      typename vnl_vector<std::complex<OutputPixelType>>::iterator inputBufferIt = inputBuffer.begin();
-      // fft is done in-place
-      typename vnl_vector<std::complex<OutputPixelType>>::iterator outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<OutputPixelType>                                  v1d(vectorSize);
-
-      // for every fft line
-      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
+      using ComplexType = std::complex<OutputPixelType>;
+      const auto factors = VnlFFTCommon::GetPrimeFactors<OutputPixelType>(vectorSize);
+
+      // The lines are gathered by batches, interleaved in the buffer, so
+      // that each batch is transformed at once.
+      constexpr SizeValueType    batchSize = VnlFFTCommon::NumberOfLinesPerBatch;
+      FFTWorkBuffer<ComplexType> buffer(batchSize * vectorSize);
+
+      for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd();)
       {
-        // copy the input line into our buffer
-        inputIt.GoToBeginOfLine();
-        inputBufferIt = inputBuffer.begin();
-        while (!inputIt.IsAtEndOfLine())
+        // copy a batch of input lines into our buffer
+        SizeValueType numberOfLines = 0;
+        for (; numberOfLines < batchSize && !inputIt.IsAtEnd(); ++numberOfLines, inputIt.NextLine())
         {
-          *inputBufferIt = inputIt.Get();
-          ++inputIt;
-          ++inputBufferIt;
+          for (ComplexType * bufferIt = buffer.data() + numberOfLines; !inputIt.IsAtEndOfLine(); ++inputIt)
+          {
+            *bufferIt = inputIt.Get();
+            bufferIt += batchSize;
+          }
         }
 
         // do the transform
-        v1d.fwd_transform(inputBuffer);
+        VnlFFTCommon::TransformLines(buffer.data(), *factors, batchSize, 1, numberOfLines, 1);
 
-        // copy the output from the buffer into our line
-        outputBufferIt = inputBuffer.begin();
-        outputIt.GoToBeginOfLine();
-        while (!outputIt.IsAtEndOfLine())
+        // copy the output from the buffer into our lines
+        for (SizeValueType line = 0; line < numberOfLines; ++line, outputIt.NextLine())
         {
-          outputIt.Set(outputBufferIt->real() / vectorSize);
-          ++outputIt;
-          ++outputBufferIt;
+          for (const ComplexType * bufferIt = buffer.data() + line; !outputIt.IsAtEndOfLine(); ++outputIt)
+          {
+            outputIt.Set(bufferIt->real() / vectorSize);
+            bufferIt += batchSize;
+          }
         }
       }
     },
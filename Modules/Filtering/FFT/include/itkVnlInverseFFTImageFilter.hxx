@@ -18,6 +18,7 @@
 #ifndef itkVnlInverseFFTImageFilter_hxx
 #define itkVnlInverseFFTImageFilter_hxx
 
+#include "itkFFTWorkBuffer.h"
 #include "itkProgressReporter.h"
 #include "itkVnlFFTCommon.h"
 
@@ -62,7 +63,7 @@ VnlInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     vectorSize *= outputSize[i];
   }
 
-  SignalVectorType signal(vectorSize);
+  FFTWorkBuffer<InputPixelType> signal(vectorSize);
   for (unsigned int i = 0; i < vectorSize; ++i)
   {
     signal[i] = in[i];
@@ -72,7 +73,7 @@ VnlInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<OutputImageType> vnlfft(outputSize);
-  vnlfft.transform(signal.data_block(), 1);
+  vnlfft.transform(signal.data(), 1);
 
   // Copy the VNL output back to the ITK image.
   // Extract the real part of the signal.
@@ -485,6 +485,8 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The plans must be destroyed before FFTW is cleaned up.
+  m_CachedPlans.clear();
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     const std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -737,6 +739,39 @@ FFTWGlobalConfiguration::GetLockMutex()
   return GetInstance()->m_Mutex;
 }
 
+std::shared_ptr<void>
+FFTWGlobalConfiguration::GetCachedPlan(const std::string &                            key,
+                                       const std::function<std::shared_ptr<void>()> & createPlan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  std::shared_ptr<void> &           plan = instance->m_CachedPlans[key];
+  if (plan == nullptr)
+  {
+    plan = createPlan();
+    instance->m_CachedPlanKeys.push_back(key);
+    if (instance->m_CachedPlanKeys.size() > MaximumNumberOfCachedPlans)
+    {
+      const std::shared_ptr<void> newPlan = plan;
+      instance->m_CachedPlans.erase(instance->m_CachedPlanKeys.front());
+      instance->m_CachedPlanKeys.pop_front();
+      return newPlan;
+    }
+  }
+  return plan;
+}
+
+void
+FFTWGlobalConfiguration::ReleaseCachedPlans()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  instance->m_CachedPlans.clear();
+  instance->m_CachedPlanKeys.clear();
+}
+
 void
 FFTWGlobalConfiguration::SetNewWisdomAvailable(const bool v)
 {
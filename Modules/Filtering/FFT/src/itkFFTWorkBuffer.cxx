@@ -0,0 +1,51 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkFFTWorkBuffer.h"
+#include "itkSingleton.h"
+
+#include <mutex>
+
+namespace itk
+{
+struct FFTWorkBufferGlobals
+{
+  FFTWorkBufferGlobals() = default;
+
+  std::mutex                          m_Mutex;
+  PooledImageBufferAllocator::Pointer m_Allocator;
+};
+
+itkGetGlobalSimpleMacro(FFTWorkBufferAllocator, FFTWorkBufferGlobals, PimplGlobals);
+
+FFTWorkBufferGlobals * FFTWorkBufferAllocator::m_PimplGlobals;
+
+
+PooledImageBufferAllocator *
+FFTWorkBufferAllocator::GetInstance()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  if (m_PimplGlobals->m_Allocator.IsNull())
+  {
+    m_PimplGlobals->m_Allocator = PooledImageBufferAllocator::New();
+    m_PimplGlobals->m_Allocator->SetMaximumPooledSizeInBytes(SizeValueType{ 512 } << 20);
+  }
+  return m_PimplGlobals->m_Allocator.GetPointer();
+}
+
+} // end namespace itk
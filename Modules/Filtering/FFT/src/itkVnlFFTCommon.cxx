@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkVnlFFTCommon.h"
+#include "itkSingleton.h"
+
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+template <typename TValue>
+using PrimeFactorsCache = std::map<SizeValueType, VnlFFTCommon::PrimeFactorsPointer<TValue>>;
+
+struct VnlFFTCommonGlobals
+{
+  VnlFFTCommonGlobals() = default;
+
+  std::mutex                m_Mutex;
+  PrimeFactorsCache<float>  m_FloatPrimeFactors;
+  PrimeFactorsCache<double> m_DoublePrimeFactors;
+};
+
+itkGetGlobalSimpleMacro(VnlFFTCommon, VnlFFTCommonGlobals, PimplGlobals);
+
+VnlFFTCommonGlobals * VnlFFTCommon::m_PimplGlobals;
+
+namespace
+{
+template <typename TValue>
+VnlFFTCommon::PrimeFactorsPointer<TValue>
+GetCachedPrimeFactors(std::mutex & mutex, PrimeFactorsCache<TValue> & cache, SizeValueType n)
+{
+  const std::lock_guard<std::mutex> lock(mutex);
+  auto &                            factors = cache[n];
+  if (factors == nullptr)
+  {
+    factors = std::make_shared<const vnl_fft_prime_factors<TValue>>(static_cast<int>(n));
+  }
+  return factors;
+}
+} // namespace
+
+
+auto
+VnlFFTCommon::GetPrimeFactorsFloat(SizeValueType n) -> PrimeFactorsPointer<float>
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetCachedPrimeFactors(m_PimplGlobals->m_Mutex, m_PimplGlobals->m_FloatPrimeFactors, n);
+}
+
+
+auto
+VnlFFTCommon::GetPrimeFactorsDouble(SizeValueType n) -> PrimeFactorsPointer<double>
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetCachedPrimeFactors(m_PimplGlobals->m_Mutex, m_PimplGlobals->m_DoublePrimeFactors, n);
+}
+
+} // end namespace itk
@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkVnlFFTCommon.h"
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include "itkVnlComplexToComplex1DFFTImageFilter.h"
+#include "itkVnlForward1DFFTImageFilter.h"
+#include "itkVnlInverse1DFFTImageFilter.h"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using ComplexType = std::complex<double>;
+
+// Computes the discrete Fourier transform of the values by its definition.
+std::vector<ComplexType>
+ComputeDFT(const std::vector<ComplexType> & values, int direction)
+{
+  const auto               n = static_cast<double>(values.size());
+  std::vector<ComplexType> dft(values.size());
+  for (size_t k = 0; k < values.size(); ++k)
+  {
+    for (size_t j = 0; j < values.size(); ++j)
+    {
+      const auto phase = static_cast<double>(j * k % values.size()) / n;
+      dft[k] += values[j] * std::polar(1.0, direction * 2.0 * itk::Math::pi * phase);
+    }
+  }
+  return dft;
+}
+
+std::vector<ComplexType>
+MakeRandomValues(size_t numberOfValues)
+{
+  std::mt19937                           randomNumberEngine;
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<ComplexType>               values(numberOfValues);
+  for (ComplexType & value : values)
+  {
+    value = { distribution(randomNumberEngine), distribution(randomNumberEngine) };
+  }
+  return values;
+}
+
+void
+ExpectNear(const ComplexType & expected, const ComplexType & actual)
+{
+  EXPECT_NEAR(expected.real(), actual.real(), 1e-9);
+  EXPECT_NEAR(expected.imag(), actual.imag(), 1e-9);
+}
+
+} // namespace
+
+
+TEST(VnlFFTCommon, PrimeFactorsAreComputedOncePerSizeAndPrecision)
+{
+  const auto factors = itk::VnlFFTCommon::GetPrimeFactors<double>(60);
+  ASSERT_NE(factors, nullptr);
+  EXPECT_EQ(factors->number(), 60);
+  EXPECT_TRUE(*factors);
+  EXPECT_EQ(itk::VnlFFTCommon::GetPrimeFactors<double>(60), factors);
+  EXPECT_NE(itk::VnlFFTCommon::GetPrimeFactors<double>(30), factors);
+  EXPECT_EQ(itk::VnlFFTCommon::GetPrimeFactors<float>(60)->number(), 60);
+}
+
+
+// Tests that the lines transformed at once, whether interleaved or one after the other, are transformed as each line
+// alone.
+TEST(VnlFFTCommon, TransformLinesComputesDFTOfEachLine)
+{
+  constexpr itk::SizeValueType size = 60;
+  constexpr itk::SizeValueType numberOfLines = 7;
+  const auto                   factors = itk::VnlFFTCommon::GetPrimeFactors<double>(size);
+
+  for (const int direction : { -1, 1 })
+  {
+    for (const bool interleaved : { false, true })
+    {
+      const itk::SizeValueType stride = interleaved ? numberOfLines + 2 : 1;
+      const itk::SizeValueType distance = interleaved ? 1 : size + 3;
+      std::vector<ComplexType> signal = MakeRandomValues(size * (numberOfLines + 2) + 3 * numberOfLines);
+      const std::vector<ComplexType> input = signal;
+
+      itk::VnlFFTCommon::TransformLines(signal.data(), *factors, stride, distance, numberOfLines, direction);
+
+      for (itk::SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        std::vector<ComplexType> values(size);
+        for (itk::SizeValueType i = 0; i < size; ++i)
+        {
+          values[i] = input[line * distance + i * stride];
+        }
+        const std::vector<ComplexType> expected = ComputeDFT(values, direction);
+        for (itk::SizeValueType i = 0; i < size; ++i)
+        {
+          ExpectNear(expected[i], signal[line * distance + i * stride]);
+        }
+      }
+    }
+  }
+}
+
+
+TEST(VnlFFTCommon, VnlFFTTransformComputesDFTAlongEachDimension)
+{
+  using ImageType = itk::Image<double, 3>;
+  const ImageType::SizeType size{ { 6, 5, 4 } };
+  std::vector<ComplexType>  signal = MakeRandomValues(size.CalculateProductOfElements());
+
+  // The expected transform, computed along each dimension in turn.
+  std::vector<ComplexType> expected = signal;
+  itk::SizeValueType       stride = 1;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    for (itk::SizeValueType first = 0; first < expected.size(); ++first)
+    {
+      if ((first / stride) % size[d] != 0)
+      {
+        continue;
+      }
+      std::vector<ComplexType> values(size[d]);
+      for (itk::SizeValueType i = 0; i < size[d]; ++i)
+      {
+        values[i] = expected[first + i * stride];
+      }
+      const std::vector<ComplexType> dft = ComputeDFT(values, -1);
+      for (itk::SizeValueType i = 0; i < size[d]; ++i)
+      {
+        expected[first + i * stride] = dft[i];
+      }
+    }
+    stride *= size[d];
+  }
+
+  const itk::VnlFFTCommon::VnlFFTTransform<ImageType> transform(size);
+  transform.transform(signal.data(), -1);
+  for (itk::SizeValueType i = 0; i < signal.size(); ++i)
+  {
+    ExpectNear(expected[i], signal[i]);
+  }
+}
+
+
+// Tests that the 1D filters, which transform the lines by batches, transform each line of the image, in each
+// direction, also when the number of lines is not a multiple of the size of the batches.
+TEST(VnlFFTCommon, OneDimensionalFiltersTransformEachLine)
+{
+  using RealImageType = itk::Image<double, 3>;
+  using ComplexImageType = itk::Image<ComplexType, 3>;
+  const RealImageType::RegionType region(RealImageType::IndexType{ { 2, -1, 3 } },
+                                         RealImageType::SizeType{ { 10, 12, 9 } });
+  const auto                      image = RealImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  const std::vector<ComplexType> values = MakeRandomValues(region.GetNumberOfPixels());
+  for (itk::SizeValueType i = 0; i < values.size(); ++i)
+  {
+    image->GetBufferPointer()[i] = values[i].real();
+  }
+
+  for (unsigned int direction = 0; direction < 3; ++direction)
+  {
+    const auto forward = itk::VnlForward1DFFTImageFilter<RealImageType, ComplexImageType>::New();
+    forward->SetInput(image);
+    forward->SetDirection(direction);
+    forward->Update();
+
+    for (const auto & index : itk::ImageRegionIndexRange<3>(region))
+    {
+      if (index[direction] != region.GetIndex(direction))
+      {
+        continue;
+      }
+      std::vector<ComplexType> line(region.GetSize(direction));
+      auto                     lineIndex = index;
+      for (ComplexType & value : line)
+      {
+        value = image->GetPixel(lineIndex);
+        ++lineIndex[direction];
+      }
+      const std::vector<ComplexType> expected = ComputeDFT(line, -1);
+      lineIndex = index;
+      for (const ComplexType & value : expected)
+      {
+        ExpectNear(value, forward->GetOutput()->GetPixel(lineIndex));
+        ++lineIndex[direction];
+      }
+    }
+
+    const auto complexToComplex = itk::VnlComplexToComplex1DFFTImageFilter<ComplexImageType>::New();
+    complexToComplex->SetInput(forward->GetOutput());
+    complexToComplex->SetDirection(direction);
+    complexToComplex->SetTransformDirection(itk::VnlComplexToComplex1DFFTImageFilter<ComplexImageType>::INVERSE);
+    complexToComplex->Update();
+
+    const auto inverse = itk::VnlInverse1DFFTImageFilter<ComplexImageType, RealImageType>::New();
+    inverse->SetInput(forward->GetOutput());
+    inverse->SetDirection(direction);
+    inverse->Update();
+
+    for (const auto & index : itk::ImageRegionIndexRange<3>(region))
+    {
+      ExpectNear(image->GetPixel(index), complexToComplex->GetOutput()->GetPixel(index));
+      EXPECT_NEAR(image->GetPixel(index), inverse->GetOutput()->GetPixel(index), 1e-9);
+    }
+  }
+}
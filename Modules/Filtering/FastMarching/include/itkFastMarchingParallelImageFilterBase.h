@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastMarchingParallelImageFilterBase_h
+#define itkFastMarchingParallelImageFilterBase_h
+
+#include "itkFastMarchingImageFilterBase.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastMarchingParallelImageFilterBase
+ * \brief Solve the Eikonal equation of fast marching on an image, in parallel.
+ *
+ * FastMarchingImageFilterBase accepts the nodes one at a time from a single
+ * priority queue, so it runs on one thread. This filter computes the same
+ * upwind discretization with the block fast iterative method instead: the
+ * image is split into blocks of BlockSize pixels per side, and the active
+ * blocks are repeatedly swept, in parallel, until their values no longer
+ * decrease. A block is activated when the values on a face of one of its
+ * neighbors change. The blocks are processed in two colors, as on a
+ * checkerboard, so that the blocks processed concurrently never share a
+ * face, and the result does not depend on the number of threads.
+ *
+ * The filter takes the same inputs as FastMarchingImageFilterBase: the speed
+ * image or constant, the alive, trial and forbidden points, and the stopping
+ * criterion. Once the values are computed, the nodes are accepted in the
+ * order of their values, as the priority queue does, until the stopping
+ * criterion is satisfied: the accepted nodes are labeled alive, the nodes
+ * next to them keep their value as trial nodes, and the other nodes are set
+ * to the large value, so the output matches the one of the priority queue up
+ * to the convergence tolerance of the iterations. Unlike with the priority
+ * queue, the nodes next to the alive points propagate the front even when
+ * they are not trial points.
+ *
+ * The topology constraints depend on the order in which the front reaches
+ * the nodes, so when a TopologyCheck is set, the priority queue of
+ * FastMarchingImageFilterBase is used instead.
+ *
+ * When CompareWithHeapSolver is on, the output is also computed with the
+ * priority queue, and the largest absolute difference between the values of
+ * the nodes accepted by both is available from
+ * GetMaximumDifferenceFromHeapSolver(), to check the agreement of the two
+ * solvers on a given problem. Note that the priority queue does not update
+ * the neighbors of the nodes on the border of the image, so that the values
+ * it computes are larger once the front reaches the border.
+ *
+ * Reference: W.-K. Jeong and R. T. Whitaker, "A Fast Iterative Method for
+ * Eikonal Equations", SIAM Journal on Scientific Computing, 30(5):2512-2534,
+ * 2008.
+ *
+ * \sa FastMarchingImageFilterBase
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TInput, typename TOutput>
+class ITK_TEMPLATE_EXPORT FastMarchingParallelImageFilterBase : public FastMarchingImageFilterBase<TInput, TOutput>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FastMarchingParallelImageFilterBase);
+
+  using Self = FastMarchingParallelImageFilterBase;
+  using Superclass = FastMarchingImageFilterBase<TInput, TOutput>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using typename Superclass::Traits;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FastMarchingParallelImageFilterBase);
+
+  using typename Superclass::InputImageType;
+  using typename Superclass::InputPixelType;
+  using typename Superclass::OutputImageType;
+  using typename Superclass::OutputPixelType;
+  using typename Superclass::OutputRegionType;
+  using typename Superclass::NodeType;
+  using typename Superclass::NodePairType;
+  using typename Superclass::NodePairContainerType;
+  using typename Superclass::LabelImageType;
+
+  static constexpr unsigned int ImageDimension = Superclass::ImageDimension;
+
+  /** Set/Get the number of pixels per side of the blocks. Defaults to 8. */
+  itkSetClampMacro(BlockSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(BlockSize, SizeValueType);
+
+  /** Set/Get whether the output is also computed with the priority queue of
+   * FastMarchingImageFilterBase, to compare the two solvers. Defaults to
+   * false. */
+  itkSetMacro(CompareWithHeapSolver, bool);
+  itkGetConstMacro(CompareWithHeapSolver, bool);
+  itkBooleanMacro(CompareWithHeapSolver);
+
+  /** Get the largest absolute difference between the values of the nodes
+   * accepted by both solvers, when CompareWithHeapSolver is on. */
+  itkGetConstMacro(MaximumDifferenceFromHeapSolver, double);
+
+  /** Get the number of rounds of block sweeps of the last update. */
+  itkGetConstMacro(NumberOfIterations, SizeValueType);
+
+protected:
+  FastMarchingParallelImageFilterBase() = default;
+  ~FastMarchingParallelImageFilterBase() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+  /** Compute the values of the free nodes with the block fast iterative
+   * method, from the values of the alive and trial points. */
+  void
+  SolveByBlocks(OutputImageType * oImage);
+
+  /** Accept the nodes in the order of their values until the stopping
+   * criterion is satisfied, and label the output as the priority queue
+   * does. */
+  void
+  AcceptNodesInOrder(OutputImageType * oImage);
+
+private:
+  class BlockSolver;
+
+  SizeValueType m_BlockSize{ 8 };
+  bool          m_CompareWithHeapSolver{ false };
+  double        m_MaximumDifferenceFromHeapSolver{ 0.0 };
+  SizeValueType m_NumberOfIterations{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFastMarchingParallelImageFilterBase.hxx"
+#endif
+
+#endif // itkFastMarchingParallelImageFilterBase_h
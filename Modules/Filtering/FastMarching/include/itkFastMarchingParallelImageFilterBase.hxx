@@ -0,0 +1,600 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastMarchingParallelImageFilterBase_hxx
+#define itkFastMarchingParallelImageFilterBase_hxx
+
+#include "itkImageAlgorithm.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <queue>
+
+namespace itk
+{
+
+// Sweeps the blocks of the image. The values of the output and the labels
+// are accessed through the buffers, with the offsets of the nodes.
+template <typename TInput, typename TOutput>
+class FastMarchingParallelImageFilterBase<TInput, TOutput>::BlockSolver
+{
+public:
+  using IndexValueType = typename NodeType::IndexValueType;
+
+  // The bit of the result of ProcessBlock() set when any value changed. The
+  // bits 2 * d and 2 * d + 1 are set when a value changed on the lower or the
+  // upper face of the block along the dimension d.
+  static constexpr unsigned int AnyChange = 2 * ImageDimension;
+  static_assert(AnyChange < 32, "The faces of a block must fit in the bits of an unsigned int.");
+
+  BlockSolver(const Self & filter, OutputImageType * oImage)
+    : m_Values(oImage->GetBufferPointer())
+    , m_Labels(filter.m_LabelImage->GetBufferPointer())
+    , m_Speed(filter.m_InputCache)
+    , m_InverseSpeed(filter.m_InverseSpeed)
+    , m_NormalizationFactor(filter.m_NormalizationFactor)
+    , m_LargeValue(filter.m_LargeValue)
+    , m_Tolerance(16 * static_cast<double>(NumericTraits<OutputPixelType>::epsilon()))
+    , m_BlockSize(filter.m_BlockSize)
+  {
+    const OutputRegionType & region = oImage->GetBufferedRegion();
+    m_SpeedIsAligned = m_Speed && m_Speed->GetBufferedRegion() == region;
+    m_SpeedBuffer = m_SpeedIsAligned ? m_Speed->GetBufferPointer() : nullptr;
+
+    OffsetValueType stride = 1;
+    SizeValueType   blockStride = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      m_Start[d] = region.GetIndex(d);
+      m_Size[d] = region.GetSize(d);
+      m_Strides[d] = stride;
+      stride *= static_cast<OffsetValueType>(m_Size[d]);
+      m_SpaceFactors[d] = itk::Math::sqr(1.0 / oImage->GetSpacing()[d]);
+
+      m_NumberOfBlocksPerDimension[d] = (m_Size[d] + m_BlockSize - 1) / m_BlockSize;
+      m_BlockStrides[d] = blockStride;
+      blockStride *= m_NumberOfBlocksPerDimension[d];
+    }
+    m_NumberOfBlocks = blockStride;
+  }
+
+  SizeValueType
+  GetNumberOfBlocks() const
+  {
+    return m_NumberOfBlocks;
+  }
+
+  // Returns the block holding the node.
+  SizeValueType
+  GetBlock(const NodeType & node) const
+  {
+    SizeValueType block = 0;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      block += static_cast<SizeValueType>(node[d] - m_Start[d]) / m_BlockSize * m_BlockStrides[d];
+    }
+    return block;
+  }
+
+  // Returns the color of the block. Blocks sharing a face have different colors.
+  unsigned int
+  GetBlockColor(SizeValueType block) const
+  {
+    SizeValueType sum = 0;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      sum += block / m_BlockStrides[d] % m_NumberOfBlocksPerDimension[d];
+    }
+    return static_cast<unsigned int>(sum % 2);
+  }
+
+  // Gets the block across the lower (side 0) or upper (side 1) face of a
+  // block along a dimension. Returns false at the border of the image.
+  bool
+  GetNeighborBlock(SizeValueType block, unsigned int d, unsigned int side, SizeValueType & neighbor) const
+  {
+    const SizeValueType position = block / m_BlockStrides[d] % m_NumberOfBlocksPerDimension[d];
+    if (side == 0 ? position == 0 : position + 1 == m_NumberOfBlocksPerDimension[d])
+    {
+      return false;
+    }
+    neighbor = side == 0 ? block - m_BlockStrides[d] : block + m_BlockStrides[d];
+    return true;
+  }
+
+  // Sweeps the block, alternately forward and backward, until its values no
+  // longer decrease by more than the tolerance. Returns the changes as bits.
+  unsigned int
+  ProcessBlock(SizeValueType block)
+  {
+    NodeType      blockStart;
+    SizeValueType blockSize[ImageDimension];
+    SizeValueType numberOfLines = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const SizeValueType position = block / m_BlockStrides[d] % m_NumberOfBlocksPerDimension[d];
+      blockStart[d] = m_Start[d] + static_cast<IndexValueType>(position * m_BlockSize);
+      blockSize[d] = std::min(m_BlockSize, m_Size[d] - position * m_BlockSize);
+      if (d > 0)
+      {
+        numberOfLines *= blockSize[d];
+      }
+    }
+
+    unsigned int result = 0;
+    for (unsigned int sweep = 0;; ++sweep)
+    {
+      const bool forward = sweep % 2 == 0;
+      bool       changed = false;
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        NodeType        node = blockStart;
+        SizeValueType   remainder = forward ? line : numberOfLines - 1 - line;
+        OffsetValueType lineOffset = 0;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          node[d] += static_cast<IndexValueType>(remainder % blockSize[d]);
+          remainder /= blockSize[d];
+          lineOffset += (node[d] - m_Start[d]) * m_Strides[d];
+        }
+        for (SizeValueType x = 0; x < blockSize[0]; ++x)
+        {
+          node[0] = blockStart[0] + static_cast<IndexValueType>(forward ? x : blockSize[0] - 1 - x);
+          const OffsetValueType offset = lineOffset + node[0] - m_Start[0];
+          const unsigned char   label = m_Labels[offset];
+          if (label == Traits::Alive || label == Traits::InitialTrial || label == Traits::Forbidden)
+          {
+            continue;
+          }
+
+          const OutputPixelType oldValue = m_Values[offset];
+          const double          solution = this->Solve(offset, node);
+          if (solution < static_cast<double>(oldValue))
+          {
+            const auto newValue = static_cast<OutputPixelType>(solution);
+            m_Values[offset] = newValue;
+            if (static_cast<double>(oldValue) - solution > m_Tolerance * solution)
+            {
+              changed = true;
+              for (unsigned int d = 0; d < ImageDimension; ++d)
+              {
+                if (node[d] == blockStart[d])
+                {
+                  result |= 1u << (2 * d);
+                }
+                if (node[d] == blockStart[d] + static_cast<IndexValueType>(blockSize[d]) - 1)
+                {
+                  result |= 1u << (2 * d + 1);
+                }
+              }
+            }
+          }
+        }
+      }
+      if (!changed)
+      {
+        return result;
+      }
+      result |= 1u << AnyChange;
+    }
+  }
+
+  bool
+  HasNegativeDiscriminant() const
+  {
+    return m_NegativeDiscriminant;
+  }
+
+private:
+  // Solves the upwind quadratic equation at the node, as
+  // FastMarchingImageFilterBase::Solve() does, from the smallest value of
+  // the neighbors along each dimension.
+  double
+  Solve(OffsetValueType offset, const NodeType & node)
+  {
+    std::pair<double, double> neighbors[ImageDimension];
+    unsigned int              numberOfNeighbors = 0;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      OutputPixelType minimum = m_LargeValue;
+      if (node[d] > m_Start[d] && m_Labels[offset - m_Strides[d]] != Traits::Forbidden)
+      {
+        minimum = std::min(minimum, m_Values[offset - m_Strides[d]]);
+      }
+      if (node[d] + 1 < m_Start[d] + static_cast<IndexValueType>(m_Size[d]) &&
+          m_Labels[offset + m_Strides[d]] != Traits::Forbidden)
+      {
+        minimum = std::min(minimum, m_Values[offset + m_Strides[d]]);
+      }
+      if (minimum < m_LargeValue)
+      {
+        neighbors[numberOfNeighbors++] = { static_cast<double>(minimum), m_SpaceFactors[d] };
+      }
+    }
+    std::sort(neighbors, neighbors + numberOfNeighbors);
+
+    double cc = m_InverseSpeed;
+    if (m_Speed)
+    {
+      cc = static_cast<double>(m_SpeedIsAligned ? m_SpeedBuffer[offset] : m_Speed->GetPixel(node)) /
+           m_NormalizationFactor;
+      if (itk::Math::FloatAlmostEqual<double>(cc, 0.0))
+      {
+        cc = -1.0 * itk::Math::sqr(1.0 / (cc + itk::Math::eps));
+      }
+      else
+      {
+        cc = -1.0 * itk::Math::sqr(1.0 / cc);
+      }
+    }
+
+    double solution = NumericTraits<double>::max();
+    double aa = 0.0;
+    double bb = 0.0;
+    for (unsigned int i = 0; i < numberOfNeighbors && solution >= neighbors[i].first; ++i)
+    {
+      const double value = neighbors[i].first;
+      const double spaceFactor = neighbors[i].second;
+      aa += spaceFactor;
+      bb += value * spaceFactor;
+      cc += itk::Math::sqr(value) * spaceFactor;
+
+      const double discrim = itk::Math::sqr(bb) - aa * cc;
+      if (discrim < itk::Math::eps)
+      {
+        m_NegativeDiscriminant = true;
+        return NumericTraits<double>::max();
+      }
+      solution = (std::sqrt(discrim) + bb) / aa;
+    }
+    return solution;
+  }
+
+  OutputPixelType *      m_Values;
+  const unsigned char *  m_Labels;
+  const InputImageType * m_Speed;
+  const InputPixelType * m_SpeedBuffer{};
+  bool                   m_SpeedIsAligned{};
+  double                 m_InverseSpeed;
+  double                 m_NormalizationFactor;
+  OutputPixelType        m_LargeValue;
+  double                 m_Tolerance;
+  SizeValueType          m_BlockSize;
+
+  NodeType        m_Start;
+  SizeValueType   m_Size[ImageDimension];
+  OffsetValueType m_Strides[ImageDimension];
+  double          m_SpaceFactors[ImageDimension];
+
+  SizeValueType m_NumberOfBlocksPerDimension[ImageDimension];
+  SizeValueType m_BlockStrides[ImageDimension];
+  SizeValueType m_NumberOfBlocks;
+
+  std::atomic<bool> m_NegativeDiscriminant{ false };
+};
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingParallelImageFilterBase<TInput, TOutput>::GenerateData()
+{
+  // The topology constraints depend on the order in which the front
+  // reaches the nodes, which only the priority queue follows.
+  if (this->m_TopologyCheck != Superclass::TopologyCheckEnum::Nothing)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  OutputImageType * output = this->GetOutput();
+
+  typename OutputImageType::Pointer heapOutput;
+  typename LabelImageType::Pointer  heapLabels;
+  if (m_CompareWithHeapSolver)
+  {
+    Superclass::GenerateData();
+
+    const OutputRegionType region = output->GetBufferedRegion();
+    heapOutput = OutputImageType::New();
+    heapOutput->SetRegions(region);
+    heapOutput->Allocate();
+    ImageAlgorithm::Copy(output, heapOutput.GetPointer(), region, region);
+    heapLabels = LabelImageType::New();
+    heapLabels->SetRegions(region);
+    heapLabels->Allocate();
+    ImageAlgorithm::Copy(this->m_LabelImage.GetPointer(), heapLabels.GetPointer(), region, region);
+    if (this->m_ProcessedPoints)
+    {
+      this->m_ProcessedPoints->Initialize();
+    }
+  }
+
+  this->Initialize(output);
+
+  // The trial points seed the blocks instead of the priority queue.
+  while (!this->m_Heap.empty())
+  {
+    this->m_Heap.pop();
+  }
+  this->m_StoppingCriterion->Reinitialize();
+
+  this->SolveByBlocks(output);
+  this->AcceptNodesInOrder(output);
+
+  if (m_CompareWithHeapSolver)
+  {
+    const OutputPixelType * values = output->GetBufferPointer();
+    const OutputPixelType * heapValues = heapOutput->GetBufferPointer();
+    const unsigned char *   labels = this->m_LabelImage->GetBufferPointer();
+    const unsigned char *   heapLabelsBuffer = heapLabels->GetBufferPointer();
+    const SizeValueType     numberOfNodes = output->GetBufferedRegion().GetNumberOfPixels();
+
+    m_MaximumDifferenceFromHeapSolver = 0.0;
+    for (SizeValueType i = 0; i < numberOfNodes; ++i)
+    {
+      if (labels[i] == Traits::Alive && heapLabelsBuffer[i] == Traits::Alive)
+      {
+        m_MaximumDifferenceFromHeapSolver =
+          std::max(m_MaximumDifferenceFromHeapSolver,
+                   std::abs(static_cast<double>(values[i]) - static_cast<double>(heapValues[i])));
+      }
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingParallelImageFilterBase<TInput, TOutput>::SolveByBlocks(OutputImageType * oImage)
+{
+  BlockSolver         solver(*this, oImage);
+  const SizeValueType numberOfBlocks = solver.GetNumberOfBlocks();
+
+  std::vector<unsigned int>  results(numberOfBlocks, 0);
+  std::vector<bool>          isActive(numberOfBlocks, false);
+  std::vector<SizeValueType> activeBlocks;
+  const auto                 activate = [&isActive, &activeBlocks](SizeValueType block) {
+    if (!isActive[block])
+    {
+      isActive[block] = true;
+      activeBlocks.push_back(block);
+    }
+  };
+
+  // Start from the blocks of the alive and trial points, and their
+  // neighbors, which the points may be next to.
+  for (const NodePairContainerType * points : { this->m_AlivePoints.GetPointer(), this->m_TrialPoints.GetPointer() })
+  {
+    if (points)
+    {
+      for (auto pointsIter = points->Begin(); pointsIter != points->End(); ++pointsIter)
+      {
+        const NodeType node = pointsIter->Value().GetNode();
+        if (this->m_BufferedRegion.IsInside(node))
+        {
+          const SizeValueType block = solver.GetBlock(node);
+          activate(block);
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            for (unsigned int side = 0; side < 2; ++side)
+            {
+              SizeValueType neighbor;
+              if (solver.GetNeighborBlock(block, d, side, neighbor))
+              {
+                activate(neighbor);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  m_NumberOfIterations = 0;
+  std::vector<SizeValueType> colorBlocks;
+  std::vector<SizeValueType> nextActiveBlocks;
+  while (!activeBlocks.empty())
+  {
+    ++m_NumberOfIterations;
+
+    // Blocks of the same color do not share a face, so they are swept
+    // concurrently without reading the values written by one another.
+    for (unsigned int color = 0; color < 2; ++color)
+    {
+      colorBlocks.clear();
+      for (const SizeValueType block : activeBlocks)
+      {
+        if (solver.GetBlockColor(block) == color)
+        {
+          colorBlocks.push_back(block);
+        }
+      }
+      multiThreader->ParallelizeArray(
+        0,
+        colorBlocks.size(),
+        [&solver, &results, &colorBlocks](SizeValueType i) {
+          results[colorBlocks[i]] = solver.ProcessBlock(colorBlocks[i]);
+        },
+        nullptr);
+    }
+    if (solver.HasNegativeDiscriminant())
+    {
+      itkExceptionMacro("Discriminant of quadratic equation is negative");
+    }
+
+    // Activate the blocks across the faces where values changed.
+    for (const SizeValueType block : activeBlocks)
+    {
+      isActive[block] = false;
+    }
+    nextActiveBlocks.clear();
+    std::swap(activeBlocks, nextActiveBlocks);
+    for (const SizeValueType block : nextActiveBlocks)
+    {
+      const unsigned int result = results[block];
+      results[block] = 0;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        for (unsigned int side = 0; side < 2; ++side)
+        {
+          SizeValueType neighbor;
+          if ((result & (1u << (2 * d + side))) && solver.GetNeighborBlock(block, d, side, neighbor))
+          {
+            activate(neighbor);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingParallelImageFilterBase<TInput, TOutput>::AcceptNodesInOrder(OutputImageType * oImage)
+{
+  OutputPixelType *     values = oImage->GetBufferPointer();
+  unsigned char *       labels = this->m_LabelImage->GetBufferPointer();
+  const OutputPixelType largeValue = this->m_LargeValue;
+  const SizeValueType   numberOfNodes = this->m_BufferedRegion.GetNumberOfPixels();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  const SizeValueType numberOfChunks =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(numberOfNodes, 8 * this->GetNumberOfWorkUnits()));
+  const auto chunkBegin = [numberOfNodes, numberOfChunks](SizeValueType chunk) {
+    return static_cast<OffsetValueType>(numberOfNodes * chunk / numberOfChunks);
+  };
+
+  // Sort the nodes reached by the front in chunks, in parallel, then merge
+  // the chunks while accepting the nodes, in the order of the priority queue.
+  using ValueOffsetPairType = std::pair<OutputPixelType, OffsetValueType>;
+  std::vector<std::vector<ValueOffsetPairType>> chunks(numberOfChunks);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      for (OffsetValueType i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+      {
+        if ((labels[i] == Traits::Far || labels[i] == Traits::InitialTrial) && values[i] < largeValue)
+        {
+          chunks[chunk].emplace_back(values[i], i);
+        }
+      }
+      std::sort(chunks[chunk].begin(), chunks[chunk].end());
+    },
+    nullptr);
+
+  using CursorType = std::pair<ValueOffsetPairType, SizeValueType>;
+  std::priority_queue<CursorType, std::vector<CursorType>, std::greater<CursorType>> cursors;
+  std::vector<SizeValueType>                                                         positions(numberOfChunks, 0);
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    if (!chunks[chunk].empty())
+    {
+      cursors.emplace(chunks[chunk].front(), chunk);
+    }
+  }
+
+  ProgressReporter progress(this, 0, this->GetTotalNumberOfNodes());
+  OutputPixelType  currentValue{};
+  while (!cursors.empty())
+  {
+    const auto [valueOffsetPair, chunk] = cursors.top();
+    cursors.pop();
+    if (++positions[chunk] < chunks[chunk].size())
+    {
+      cursors.emplace(chunks[chunk][positions[chunk]], chunk);
+    }
+
+    currentValue = valueOffsetPair.first;
+    const NodePairType nodePair(oImage->ComputeIndex(valueOffsetPair.second), currentValue);
+    this->m_StoppingCriterion->SetCurrentNodePair(nodePair);
+    if (this->m_StoppingCriterion->IsSatisfied())
+    {
+      break;
+    }
+    if (this->m_CollectPoints)
+    {
+      this->m_ProcessedPoints->push_back(nodePair);
+    }
+    labels[valueOffsetPair.second] = Traits::Alive;
+    progress.CompletedPixel();
+  }
+  this->m_TargetReachedValue = currentValue;
+  chunks.clear();
+
+  // The nodes not accepted keep their value as trial nodes when they are
+  // next to an alive node. The labels are only read in the first pass, and
+  // the values only in the second.
+  const NodeType start = this->m_BufferedRegion.GetIndex();
+  const NodeType last = this->m_LastIndex;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      for (OffsetValueType i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+      {
+        if (labels[i] != Traits::Far || !(values[i] < largeValue))
+        {
+          continue;
+        }
+        const NodeType node = oImage->ComputeIndex(i);
+        bool           isNextToAlive = false;
+        OffsetValueType stride = 1;
+        for (unsigned int d = 0; d < ImageDimension && !isNextToAlive; ++d)
+        {
+          isNextToAlive = (node[d] > start[d] && labels[i - stride] == Traits::Alive) ||
+                          (node[d] < last[d] && labels[i + stride] == Traits::Alive);
+          stride *= static_cast<OffsetValueType>(this->m_BufferedRegion.GetSize(d));
+        }
+        if (!isNextToAlive)
+        {
+          values[i] = largeValue;
+        }
+      }
+    },
+    nullptr);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      for (OffsetValueType i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+      {
+        if (labels[i] == Traits::Far && values[i] < largeValue)
+        {
+          labels[i] = Traits::Trial;
+        }
+      }
+    },
+    nullptr);
+}
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingParallelImageFilterBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  itkPrintSelfBooleanMacro(CompareWithHeapSolver);
+  os << indent << "MaximumDifferenceFromHeapSolver: " << m_MaximumDifferenceFromHeapSolver << std::endl;
+  os << indent << "NumberOfIterations: " << m_NumberOfIterations << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkFastMarchingParallelImageFilterBase_hxx
@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkFastMarchingParallelImageFilterBase.h"
+#include "itkFastMarchingNumberOfElementsStoppingCriterion.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageRegionConstIterator.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+template <unsigned int VDimension>
+struct Problem
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::FastMarchingParallelImageFilterBase<ImageType, ImageType>;
+  using HeapFilterType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using NodePairContainerType = typename FilterType::NodePairContainerType;
+  using NodePairType = typename FilterType::NodePairType;
+  using IndexType = typename ImageType::IndexType;
+
+  typename ImageType::Pointer             m_Speed;
+  typename NodePairContainerType::Pointer m_Alive = NodePairContainerType::New();
+  typename NodePairContainerType::Pointer m_Trial = NodePairContainerType::New();
+  typename NodePairContainerType::Pointer m_Forbidden = NodePairContainerType::New();
+
+  // A speed image varying between 0.5 and 2, with a seed at each of the
+  // given indices: an alive point surrounded by trial points.
+  Problem(const typename ImageType::SizeType & size, const std::vector<IndexType> & seeds)
+    : m_Speed(ImageType::New())
+  {
+    m_Speed->SetRegions(size);
+    m_Speed->Allocate();
+    unsigned int state = 7;
+    for (float * pixel = m_Speed->GetBufferPointer(), *end = pixel + m_Speed->GetBufferedRegion().GetNumberOfPixels();
+         pixel != end;
+         ++pixel)
+    {
+      state = state * 1103515245u + 12345u;
+      *pixel = 0.5f + 1.5f * static_cast<float>((state >> 16) & 0xFF) / 255.0f;
+    }
+    for (const IndexType & seed : seeds)
+    {
+      m_Alive->push_back(NodePairType(seed, 0.0f));
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        for (const int side : { -1, 1 })
+        {
+          IndexType neighbor = seed;
+          neighbor[d] += side;
+          m_Trial->push_back(NodePairType(neighbor, 1.0f / m_Speed->GetPixel(seed)));
+        }
+      }
+    }
+  }
+
+  template <typename TFilter>
+  typename TFilter::Pointer
+  MakeFilter(typename TFilter::StoppingCriterionType * criterion) const
+  {
+    auto filter = TFilter::New();
+    filter->SetInput(m_Speed);
+    filter->SetAlivePoints(m_Alive);
+    filter->SetTrialPoints(m_Trial);
+    filter->SetForbiddenPoints(m_Forbidden);
+    filter->SetStoppingCriterion(criterion);
+    return filter;
+  }
+};
+
+template <typename TImage>
+void
+ExpectEqualImages(const TImage & expected, const TImage & actual)
+{
+  ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+  EXPECT_TRUE(std::equal(expected.GetBufferPointer(),
+                         expected.GetBufferPointer() + expected.GetBufferedRegion().GetNumberOfPixels(),
+                         actual.GetBufferPointer()));
+}
+} // namespace
+
+
+TEST(FastMarchingParallelImageFilterBase, MatchesHeapSolver)
+{
+  // The front stops before the border of the image, where the priority
+  // queue does not update the neighbors of the nodes.
+  using ProblemType = Problem<3>;
+  ProblemType problem({ { 41, 41, 41 } }, { { { 20, 20, 20 } }, { { 14, 26, 20 } } });
+  for (itk::IndexValueType y = 10; y < 23; ++y)
+  {
+    for (itk::IndexValueType z = 14; z < 27; ++z)
+    {
+      problem.m_Forbidden->push_back(ProblemType::NodePairType({ { 17, y, z } }, 0.0f));
+    }
+  }
+  auto criterion = itk::FastMarchingThresholdStoppingCriterion<ProblemType::ImageType, ProblemType::ImageType>::New();
+  criterion->SetThreshold(6.0f);
+
+  const auto heapFilter = problem.MakeFilter<ProblemType::HeapFilterType>(criterion);
+  heapFilter->Update();
+  const auto filter = problem.MakeFilter<ProblemType::FilterType>(criterion);
+  filter->CompareWithHeapSolverOn();
+  filter->Update();
+
+  EXPECT_GT(filter->GetNumberOfIterations(), 1u);
+  EXPECT_LT(filter->GetMaximumDifferenceFromHeapSolver(), 1e-4);
+  ExpectEqualImages(*heapFilter->GetLabelImage(), *filter->GetLabelImage());
+  EXPECT_NEAR(filter->GetTargetReachedValue(), heapFilter->GetTargetReachedValue(), 1e-4);
+
+  // The alive nodes have the same values, and so do the trial nodes around
+  // them, but for being computed from all their neighbors, not only the alive
+  // ones.
+  const auto & labels = *filter->GetLabelImage();
+  const auto & output = *filter->GetOutput();
+  for (itk::ImageRegionConstIterator<ProblemType::ImageType> it(&output, output.GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const float heapValue = heapFilter->GetOutput()->GetPixel(it.GetIndex());
+    if (labels.GetPixel(it.GetIndex()) == ProblemType::FilterType::Traits::Trial)
+    {
+      EXPECT_LE(it.Get(), heapValue + 1e-4f);
+    }
+    else
+    {
+      EXPECT_NEAR(it.Get(), heapValue, 1e-4f);
+    }
+  }
+}
+
+
+TEST(FastMarchingParallelImageFilterBase, StopsAsHeapSolver)
+{
+  using ProblemType = Problem<2>;
+  const ProblemType problem({ { 90, 70 } }, { { { 40, 30 } } });
+  auto              criterion =
+    itk::FastMarchingNumberOfElementsStoppingCriterion<ProblemType::ImageType, ProblemType::ImageType>::New();
+  criterion->SetTargetNumberOfElements(1000);
+
+  const auto heapFilter = problem.MakeFilter<ProblemType::HeapFilterType>(criterion);
+  heapFilter->CollectPointsOn();
+  heapFilter->Update();
+  const auto filter = problem.MakeFilter<ProblemType::FilterType>(criterion);
+  filter->CollectPointsOn();
+  filter->SetBlockSize(5);
+  filter->Update();
+
+  // The same nodes are accepted, in the same order but for the nodes of
+  // equal values.
+  const auto & processedPoints = *filter->GetProcessedPoints();
+  const auto & heapProcessedPoints = *heapFilter->GetProcessedPoints();
+  ASSERT_EQ(processedPoints.size(), heapProcessedPoints.size());
+  std::vector<ProblemType::IndexType> nodes;
+  std::vector<ProblemType::IndexType> heapNodes;
+  for (size_t i = 0; i < processedPoints.size(); ++i)
+  {
+    EXPECT_NEAR(processedPoints[i].GetValue(), heapProcessedPoints[i].GetValue(), 1e-4);
+    nodes.push_back(processedPoints[i].GetNode());
+    heapNodes.push_back(heapProcessedPoints[i].GetNode());
+  }
+  std::sort(nodes.begin(), nodes.end());
+  std::sort(heapNodes.begin(), heapNodes.end());
+  EXPECT_EQ(nodes, heapNodes);
+  EXPECT_NEAR(filter->GetTargetReachedValue(), heapFilter->GetTargetReachedValue(), 1e-4);
+
+  // Beyond the trial nodes, next to the alive ones, the nodes keep the large value.
+  const auto & labels = *filter->GetLabelImage();
+  const auto & output = *filter->GetOutput();
+  for (itk::ImageRegionConstIterator<ProblemType::ImageType> it(&output, output.GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const unsigned char label = labels.GetPixel(it.GetIndex());
+    EXPECT_EQ(label, heapFilter->GetLabelImage()->GetPixel(it.GetIndex()));
+    if (label == ProblemType::FilterType::Traits::Far)
+    {
+      EXPECT_EQ(it.Get(), itk::NumericTraits<float>::max());
+    }
+  }
+}
+
+
+TEST(FastMarchingParallelImageFilterBase, DoesNotDependOnNumberOfWorkUnits)
+{
+  using ProblemType = Problem<3>;
+  const ProblemType problem({ { 40, 33, 21 } }, { { { 1, 1, 1 } }, { { 35, 2, 18 } }, { { 20, 30, 10 } } });
+  auto criterion = itk::FastMarchingThresholdStoppingCriterion<ProblemType::ImageType, ProblemType::ImageType>::New();
+  criterion->SetThreshold(20.0f);
+
+  const auto filter = problem.MakeFilter<ProblemType::FilterType>(criterion);
+  filter->SetNumberOfWorkUnits(1);
+  filter->Update();
+  for (const unsigned int numberOfWorkUnits : { 3u, 16u })
+  {
+    const auto otherFilter = problem.MakeFilter<ProblemType::FilterType>(criterion);
+    otherFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    otherFilter->Update();
+    ExpectEqualImages(*filter->GetOutput(), *otherFilter->GetOutput());
+    ExpectEqualImages(*filter->GetLabelImage(), *otherFilter->GetLabelImage());
+  }
+}
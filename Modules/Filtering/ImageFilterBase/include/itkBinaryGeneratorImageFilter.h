@@ -45,6 +45,10 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * A functor that has an EvaluateSpan() member function (see
+ * Functor::HasEvaluateSpan) is evaluated on spans of contiguous pixels when
+ * the images are itk::Image of the same dimension.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter
  *
@@ -18,8 +18,12 @@
 #ifndef itkBinaryGeneratorImageFilter_hxx
 #define itkBinaryGeneratorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
+#include "itkSpanFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <vector>
 
 
 namespace itk
@@ -186,6 +190,66 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (CanEvaluateFunctorOnSpans<TFunctor, TOutputImage, TInputImage1, TInputImage2>)
+  {
+    // A constant input is repeated over a block of pixels, so that the
+    // functor is evaluated on spans of at most that many pixels.
+    const SizeValueType blockLength = std::min<SizeValueType>(outputRegionForThread.GetNumberOfPixels(), 1024);
+
+    if (inputPtr1 && inputPtr2)
+    {
+      ImageAlgorithm::ForEachContiguousSpan(
+        outputRegionForThread,
+        [&functor, &progress](SizeValueType                numberOfPixels,
+                              const Input1ImagePixelType * input1,
+                              const Input2ImagePixelType * input2,
+                              OutputImagePixelType *       output) {
+          functor.EvaluateSpan(input1, input2, output, numberOfPixels);
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+    if (inputPtr1)
+    {
+      const std::vector<Input2ImagePixelType> input2Values(blockLength, this->GetConstant2());
+      ImageAlgorithm::ForEachContiguousSpan(
+        outputRegionForThread,
+        [&functor, &progress, &input2Values, blockLength](
+          SizeValueType numberOfPixels, const Input1ImagePixelType * input1, OutputImagePixelType * output) {
+          for (SizeValueType i = 0; i < numberOfPixels; i += blockLength)
+          {
+            functor.EvaluateSpan(
+              input1 + i, input2Values.data(), output + i, std::min(blockLength, numberOfPixels - i));
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr1,
+        outputPtr);
+      return;
+    }
+    if (inputPtr2)
+    {
+      const std::vector<Input1ImagePixelType> input1Values(blockLength, this->GetConstant1());
+      ImageAlgorithm::ForEachContiguousSpan(
+        outputRegionForThread,
+        [&functor, &progress, &input1Values, blockLength](
+          SizeValueType numberOfPixels, const Input2ImagePixelType * input2, OutputImagePixelType * output) {
+          for (SizeValueType i = 0; i < numberOfPixels; i += blockLength)
+          {
+            functor.EvaluateSpan(
+              input1Values.data(), input2 + i, output + i, std::min(blockLength, numberOfPixels - i));
+          }
+          progress.Completed(numberOfPixels);
+        },
+        inputPtr2,
+        outputPtr);
+      return;
+    }
+  }
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -54,6 +54,15 @@ public:
   {
     return static_cast<TOutput>(A);
   }
+
+  void
+  EvaluateSpan(const TInput * A, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = static_cast<TOutput>(A[i]);
+    }
+  }
 };
 } // namespace Functor
 #endif
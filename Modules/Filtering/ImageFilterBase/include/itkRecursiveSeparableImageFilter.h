@@ -45,6 +45,15 @@ namespace itk
  * Filters". J Math Imaging Vis 26, 293–299 (2006).
  * https://doi.org/10.1007/s10851-006-8464-z
  *
+ * When the images are itk::Image of scalar pixels, the lines are filtered by
+ * blocks of NumberOfLinesPerBlock lines that are adjacent along another
+ * dimension. The samples of a block are gathered in a tile, interleaved so
+ * that the recursion runs on all the lines of the block at once, which the
+ * compiler vectorizes. Along any dimension but the first one, the lines of
+ * a block are read and written by contiguous runs of pixels, instead of one
+ * cache line per pixel. The results are those of filtering the lines one by
+ * one.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -84,6 +93,9 @@ public:
   /** Type of the output image */
   using OutputImageType = TOutputImage;
 
+  /** The number of lines filtered at once, when the images are itk::Image of scalar pixels. */
+  static constexpr unsigned int NumberOfLinesPerBlock = 16;
+
   /** Get the direction in which the filter is to be applied. */
   itkGetConstMacro(Direction, unsigned int);
 
@@ -140,6 +152,13 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Apply the Recursive Filter to a block of NumberOfLinesPerBlock lines of
+   * scalar data, the sample i of the line j being at i * NumberOfLinesPerBlock + j,
+   * in the arrays outs, data and scratch alike. Each line is filtered as by
+   * FilterDataArray(). */
+  void
+  FilterDataBlock(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0{};
@@ -252,6 +271,10 @@ protected:
   }
 
 private:
+  /** Filters the lines of the region by blocks, when the images are itk::Image of scalar pixels. */
+  void
+  FilterLinesByBlocks(const OutputImageRegionType & outputRegionForThread);
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
@@ -20,7 +20,12 @@
 
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkSpanFunctorTraits.h"
+
+#include <algorithm>
+#include <type_traits>
 
 namespace itk
 {
@@ -165,6 +170,95 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to a block of interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln) const
+{
+  // The operations on each line are exactly those of FilterDataArray(), and
+  // the loops over the lines of the block are the innermost ones.
+  constexpr OffsetValueType B = NumberOfLinesPerBlock;
+
+  RealType * const scratch1 = outs;
+  RealType * const scratch2 = scratch;
+
+  /**
+   * Causal direction pass
+   */
+  for (OffsetValueType j = 0; j < B; ++j)
+  {
+    const RealType * const d = data + j;
+    RealType * const       s1 = scratch1 + j;
+    const RealType         outV1 = d[0];
+
+    MathEMAMAMAM(s1[0], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(s1[B], d[B], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(s1[2 * B], d[2 * B], m_N0, d[B], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(s1[3 * B], d[3 * B], m_N0, d[2 * B], m_N1, d[B], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(s1[0], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(s1[B], s1[0], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(s1[2 * B], s1[B], m_D1, s1[0], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(s1[3 * B], s1[2 * B], m_D1, s1[B], m_D2, s1[0], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    const RealType * const d = data + i * B;
+    RealType * const       s1 = scratch1 + i * B;
+    for (OffsetValueType j = 0; j < B; ++j)
+    {
+      MathEMAMAMAM(s1[j], d[j], m_N0, d[j - B], m_N1, d[j - 2 * B], m_N2, d[j - 3 * B], m_N3);
+      MathSMAMAMAM(s1[j], s1[j - B], m_D1, s1[j - 2 * B], m_D2, s1[j - 3 * B], m_D3, s1[j - 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * B;
+  for (OffsetValueType j = 0; j < B; ++j)
+  {
+    const RealType * const d = data + last + j;
+    RealType * const       s2 = scratch2 + last + j;
+    const RealType         outV2 = d[0];
+
+    MathEMAMAMAM(s2[0], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(s2 - B), d[0], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(s2 - 2 * B), *(d - B), m_M1, d[0], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(*(s2 - 3 * B), *(d - 2 * B), m_M1, *(d - B), m_M2, d[0], m_M3, outV2, m_M4);
+
+    MathSMAMAMAM(s2[0], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(s2 - B), s2[0], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(s2 - 2 * B), *(s2 - B), m_D1, s2[0], m_D2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(*(s2 - 3 * B), *(s2 - 2 * B), m_D1, *(s2 - B), m_D2, s2[0], m_D3, outV2, m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    const RealType * const d = data + i * B;
+    RealType * const       s2 = scratch2 + (i - 1) * B;
+    for (OffsetValueType j = 0; j < B; ++j)
+    {
+      MathEMAMAMAM(s2[j], d[j], m_M1, d[j + B], m_M2, d[j + 2 * B], m_M3, d[j + 3 * B], m_M4);
+      MathSMAMAMAM(s2[j], s2[j + B], m_D1, s2[j + 2 * B], m_D2, s2[j + 3 * B], m_D3, s2[j + 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * B; ++i)
+  {
+    outs[i] += scratch2[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -263,6 +357,13 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
 {
   using OutputPixelType = typename TOutputImage::PixelType;
 
+  if constexpr (std::is_arithmetic_v<RealType> && TInputImage::ImageDimension > 1 &&
+                IsContiguousPixelImage<TInputImage> && IsContiguousPixelImage<TOutputImage>)
+  {
+    this->FilterLinesByBlocks(outputRegionForThread);
+    return;
+  }
+
   using InputConstIteratorType = ImageLinearConstIteratorWithIndex<TInputImage>;
   using OutputIteratorType = ImageLinearIteratorWithIndex<TOutputImage>;
 
@@ -311,6 +412,73 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterLinesByBlocks(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  constexpr unsigned int B = NumberOfLinesPerBlock;
+
+  const typename TInputImage::ConstPointer inputImage(this->GetInputImage());
+  const typename TOutputImage::Pointer     outputImage(this->GetOutput());
+
+  // The lines of a block are adjacent along the first dimension, or along the
+  // second one when filtering along the first one.
+  const unsigned int  direction = this->m_Direction;
+  const unsigned int  blockDirection = direction == 0 ? 1 : 0;
+  const SizeValueType ln = outputRegionForThread.GetSize(direction);
+  const SizeValueType numberOfLines = outputRegionForThread.GetSize(blockDirection);
+
+  const OffsetValueType inputStride = inputImage->GetOffsetTable()[direction];
+  const OffsetValueType inputLineStride = inputImage->GetOffsetTable()[blockDirection];
+  const OffsetValueType outputStride = outputImage->GetOffsetTable()[direction];
+  const OffsetValueType outputLineStride = outputImage->GetOffsetTable()[blockDirection];
+
+  const auto inps = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto outs = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto scratch = make_unique_for_overwrite<RealType[]>(ln * B);
+
+  OutputImageRegionType firstLinesRegion = outputRegionForThread;
+  firstLinesRegion.SetSize(direction, 1);
+  firstLinesRegion.SetSize(blockDirection, 1);
+
+  for (const auto & index : ImageRegionIndexRange<TOutputImage::ImageDimension>(firstLinesRegion))
+  {
+    const InputPixelType * const inputLines = inputImage->GetBufferPointer() + inputImage->ComputeOffset(index);
+    OutputPixelType * const      outputLines = outputImage->GetBufferPointer() + outputImage->ComputeOffset(index);
+
+    for (SizeValueType firstLine = 0; firstLine < numberOfLines; firstLine += B)
+    {
+      const auto blockSize = static_cast<unsigned int>(std::min<SizeValueType>(B, numberOfLines - firstLine));
+
+      // Gather the block, padded with zero lines.
+      for (SizeValueType i = 0; i < ln; ++i)
+      {
+        const InputPixelType * const input = inputLines + firstLine * inputLineStride + i * inputStride;
+        RealType * const             inp = inps.get() + i * B;
+        for (unsigned int j = 0; j < blockSize; ++j)
+        {
+          inp[j] = static_cast<RealType>(input[j * inputLineStride]);
+        }
+        std::fill(inp + blockSize, inp + B, RealType{});
+      }
+
+      this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln);
+
+      for (SizeValueType i = 0; i < ln; ++i)
+      {
+        OutputPixelType * const output = outputLines + firstLine * outputLineStride + i * outputStride;
+        const RealType * const  out = outs.get() + i * B;
+        for (unsigned int j = 0; j < blockSize; ++j)
+        {
+          output[j * outputLineStride] = static_cast<OutputPixelType>(out[j]);
+        }
+      }
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
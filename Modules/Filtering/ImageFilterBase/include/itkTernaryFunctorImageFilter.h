@@ -30,6 +30,10 @@ namespace itk
  * and the type of the output image.  It is also parameterized by the
  * operation to be applied, using a Functor style.
  *
+ * A functor that has an EvaluateSpan() member function (see
+ * Functor::HasEvaluateSpan) is evaluated on spans of contiguous pixels when
+ * the images are itk::Image of the same dimension.
+ *
  * \sa BinaryFunctorImageFilter UnaryFunctorImageFilter
  *
  * \ingroup IntensityImageFilters MultiThreaded
@@ -18,7 +18,9 @@
 #ifndef itkTernaryFunctorImageFilter_hxx
 #define itkTernaryFunctorImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
+#include "itkSpanFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -130,6 +132,25 @@ TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (CanEvaluateFunctorOnSpans<FunctorType, TOutputImage, TInputImage1, TInputImage2, TInputImage3>)
+  {
+    ImageAlgorithm::ForEachContiguousSpan(
+      outputRegionForThread,
+      [this, &progress](SizeValueType                numberOfPixels,
+                        const Input1ImagePixelType * input1,
+                        const Input2ImagePixelType * input2,
+                        const Input3ImagePixelType * input3,
+                        OutputImagePixelType *       output) {
+        m_Functor.EvaluateSpan(input1, input2, input3, output, numberOfPixels);
+        progress.Completed(numberOfPixels);
+      },
+      inputPtr1.GetPointer(),
+      inputPtr2.GetPointer(),
+      inputPtr3.GetPointer(),
+      outputPtr.GetPointer());
+    return;
+  }
+
   ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
   ImageScanlineConstIterator inputIt2(inputPtr2, outputRegionForThread);
   ImageScanlineConstIterator inputIt3(inputPtr3, outputRegionForThread);
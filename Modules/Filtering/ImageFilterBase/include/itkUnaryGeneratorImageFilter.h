@@ -94,6 +94,9 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedPixelsFunction = [this, f](const OutputImageRegionType & region, OutputImagePixelType * buffer) {
+      return this->GenerateFusedPixelsWithFunctor(f, region, buffer);
+    };
 
     this->Modified();
   }
@@ -103,6 +106,9 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedPixelsFunction = [this, f](const OutputImageRegionType & region, OutputImagePixelType * buffer) {
+      return this->GenerateFusedPixelsWithFunctor(f, region, buffer);
+    };
 
     this->Modified();
   }
@@ -118,6 +124,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedPixelsFunction = [this, funcPointer](const OutputImageRegionType & region,
+                                                        OutputImagePixelType *        buffer) {
+      return this->GenerateFusedPixelsWithFunctor(funcPointer, region, buffer);
+    };
 
     this->Modified();
   }
@@ -127,6 +137,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedPixelsFunction = [this, funcPointer](const OutputImageRegionType & region,
+                                                        OutputImagePixelType *        buffer) {
+      return this->GenerateFusedPixelsWithFunctor(funcPointer, region, buffer);
+    };
 
     this->Modified();
   }
@@ -146,11 +160,24 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, functor](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(functor, outputRegionForThread);
     };
+    m_GenerateFusedPixelsFunction = [this, functor](const OutputImageRegionType & region,
+                                                    OutputImagePixelType *        buffer) {
+      return this->GenerateFusedPixelsWithFunctor(functor, region, buffer);
+    };
 
     this->Modified();
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** UnaryGeneratorImageFilter can compute its output pixels on the fly for
+   * a downstream filter, once a functor is set, when its input and output
+   * have the same dimension.
+   * \sa ImageToImageFilter::SetFusion() */
+  bool
+  CanGenerateFusedPixels() const override;
+  void
+  GenerateFusedPixels(const OutputImageRegionType & region, OutputImagePixelType * buffer) override;
+
 protected:
   UnaryGeneratorImageFilter();
   ~UnaryGeneratorImageFilter() override = default;
@@ -183,8 +210,24 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Computes the output pixels of a region into a buffer, for a
+   * downstream filter that fuses with this one. */
+  template <typename TFunctor>
+  void
+  GenerateFusedPixelsWithFunctor(const TFunctor &, const OutputImageRegionType & region, OutputImagePixelType * buffer);
+
+  /** The input may be computed on the fly by a fused source, when the input
+   * and output have the same dimension. */
+  bool
+  SupportsFusedInput() const override
+  {
+    return static_cast<unsigned int>(Superclass::InputImageDimension) ==
+           static_cast<unsigned int>(Superclass::OutputImageDimension);
+  }
+
 private:
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction{};
+  std::function<void(const OutputImageRegionType &, OutputImagePixelType *)> m_GenerateFusedPixelsFunction{};
 };
 } // end namespace itk
 
@@ -21,6 +21,7 @@
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
+#include <vector>
 
 namespace itk
 {
@@ -86,6 +87,31 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (ImageSource<TInputImage> * fusedSource = this->GetFusedInputSource())
+  {
+    // The input pixels are computed on the fly, one scanline at a time.
+    std::vector<InputImagePixelType> inputLine(regionSize[0]);
+    ImageScanlineIterator            outputIt(outputPtr, outputRegionForThread);
+    auto                             lineSize = OutputImageRegionType::SizeType::Filled(1);
+    lineSize[0] = regionSize[0];
+
+    while (!outputIt.IsAtEnd())
+    {
+      InputImageRegionType inputLineRegion;
+      this->CallCopyOutputRegionToInputRegion(inputLineRegion, OutputImageRegionType(outputIt.GetIndex(), lineSize));
+      fusedSource->GenerateFusedPixels(inputLineRegion, inputLine.data());
+
+      for (const InputImagePixelType & inputPixel : inputLine)
+      {
+        outputIt.Set(functor(inputPixel));
+        ++outputIt;
+      }
+      progress.Completed(regionSize[0]);
+      outputIt.NextLine();
+    }
+    return;
+  }
+
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -110,6 +136,59 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
     outputIt.NextLine();
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::CanGenerateFusedPixels() const
+{
+  return m_GenerateFusedPixelsFunction && this->SupportsFusedInput() && this->GetNumberOfInputs() == 1 &&
+         this->GetInput() != nullptr;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateFusedPixels(const OutputImageRegionType & region,
+                                                                          OutputImagePixelType *        buffer)
+{
+  m_GenerateFusedPixelsFunction(region, buffer);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunctor>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateFusedPixelsWithFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & region,
+  OutputImagePixelType *        buffer)
+{
+  InputImageRegionType inputRegion;
+  this->CallCopyOutputRegionToInputRegion(inputRegion, region);
+
+  if (ImageSource<TInputImage> * fusedSource = this->GetFusedInputSource())
+  {
+    std::vector<InputImagePixelType> inputPixels(inputRegion.GetNumberOfPixels());
+    fusedSource->GenerateFusedPixels(inputRegion, inputPixels.data());
+    for (const InputImagePixelType & inputPixel : inputPixels)
+    {
+      *buffer++ = functor(inputPixel);
+    }
+    return;
+  }
+
+  ImageScanlineConstIterator inputIt(this->GetInput(), inputRegion);
+  while (!inputIt.IsAtEnd())
+  {
+    while (!inputIt.IsAtEndOfLine())
+    {
+      *buffer++ = functor(inputIt.Get());
+      ++inputIt;
+    }
+    inputIt.NextLine();
+  }
+}
 } // end namespace itk
 
 #endif
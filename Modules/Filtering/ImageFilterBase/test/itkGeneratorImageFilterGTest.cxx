@@ -19,6 +19,7 @@
 #include "itkUnaryGeneratorImageFilter.h"
 #include "itkBinaryGeneratorImageFilter.h"
 #include "itkTernaryGeneratorImageFilter.h"
+#include "itkUnaryFunctorImageFilter.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
 
@@ -91,6 +92,28 @@ struct Utilities
 };
 
 
+// Functor for UnaryFunctorImageFilter, doubling its argument.
+struct DoubleFunctor
+{
+  bool
+  operator==(const DoubleFunctor &) const
+  {
+    return true;
+  }
+  bool
+  operator!=(const DoubleFunctor &) const
+  {
+    return false;
+  }
+
+  float
+  operator()(const float & value) const
+  {
+    return 2.0f * value;
+  }
+};
+
+
 } // namespace
 
 
@@ -439,3 +462,58 @@ TEST(TernaryGeneratorImageFilter, Constants)
 
   EXPECT_NEAR(103.0, outputImage->GetPixel(idx), 1e-8);
 }
+
+
+// Tests that a chain of pixel-wise filters with Fusion enabled produces the same output as the unfused chain, without
+// allocating the intermediate images.
+TEST(UnaryGeneratorImageFilter, Fusion)
+{
+  using Utils = Utilities<3, float>;
+  using OutputImageType = itk::Image<short, 3>;
+
+  auto image = Utils::CreateImage();
+  image->FillBuffer(0.0f);
+  float value = 0.0f;
+  for (itk::ImageRegionIterator<Utils::ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(value);
+    value += 0.5f;
+  }
+
+  const auto addFilter = itk::UnaryGeneratorImageFilter<Utils::ImageType, Utils::ImageType>::New();
+  addFilter->SetInput(image);
+  addFilter->SetFunctor([](const float & v) { return v + 1.0f; });
+
+  const auto multiplyFilter = itk::UnaryFunctorImageFilter<Utils::ImageType, Utils::ImageType, DoubleFunctor>::New();
+  multiplyFilter->SetInput(addFilter->GetOutput());
+
+  const auto castFilter = itk::UnaryGeneratorImageFilter<Utils::ImageType, OutputImageType>::New();
+  castFilter->SetInput(multiplyFilter->GetOutput());
+  castFilter->SetFunctor([](const float & v) { return static_cast<short>(v - 3.0f); });
+
+  EXPECT_FALSE(castFilter->GetFusion());
+  castFilter->Update();
+  const OutputImageType::Pointer unfusedOutput = castFilter->GetOutput();
+  unfusedOutput->DisconnectPipeline();
+  EXPECT_NE(addFilter->GetOutput()->GetBufferPointer(), nullptr);
+
+  addFilter->GetOutput()->Initialize();
+  multiplyFilter->GetOutput()->Initialize();
+  multiplyFilter->FusionOn();
+  castFilter->FusionOn();
+  castFilter->Update();
+  const OutputImageType * fusedOutput = castFilter->GetOutput();
+
+  // The intermediate images are neither computed nor allocated.
+  EXPECT_EQ(addFilter->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_EQ(multiplyFilter->GetOutput()->GetBufferPointer(), nullptr);
+
+  ASSERT_EQ(fusedOutput->GetBufferedRegion(), unfusedOutput->GetBufferedRegion());
+  for (itk::ImageRegionConstIterator<OutputImageType> it(fusedOutput, fusedOutput->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_EQ(it.Get(), unfusedOutput->GetPixel(it.GetIndex()));
+  }
+  EXPECT_EQ(fusedOutput->GetPixel(Utils::IndexType{ { 1, 0, 0 } }), static_cast<short>((0.5f + 1.0f) * 2.0f - 3.0f));
+}
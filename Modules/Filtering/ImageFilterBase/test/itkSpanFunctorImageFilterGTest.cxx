@@ -0,0 +1,223 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkTernaryFunctorImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+#include <algorithm>
+#include <atomic>
+
+
+namespace
+{
+using ShortImageType = itk::Image<short, 3>;
+using FloatImageType = itk::Image<float, 3>;
+
+std::atomic<itk::SizeValueType> numberOfSpanPixels{ 0 };
+
+// Functor that evaluates spans, and counts the pixels of the spans.
+struct AffineFunctor
+{
+  bool
+  operator==(const AffineFunctor &) const
+  {
+    return true;
+  }
+  bool
+  operator!=(const AffineFunctor &) const
+  {
+    return false;
+  }
+
+  float
+  operator()(const short & value) const
+  {
+    return 0.5f * value + 1.0f;
+  }
+
+  void
+  EvaluateSpan(const short * input, float * output, itk::SizeValueType numberOfPixels) const
+  {
+    for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = (*this)(input[i]);
+    }
+    numberOfSpanPixels += numberOfPixels;
+  }
+};
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 37, 13, 9 } });
+  image->Allocate();
+  typename TImage::PixelType * const buffer = image->GetBufferPointer();
+  for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    buffer[i] = static_cast<typename TImage::PixelType>(static_cast<int>((i * 7 + seed) % 251) - 100);
+  }
+  return image;
+}
+
+// Expects the output pixels within the region to be the function of their index.
+template <typename TImage, typename TFunction>
+void
+ExpectPixels(const TImage & output, const typename TImage::RegionType & region, TFunction function)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(&output, region); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), function(it.GetIndex())) << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(SpanFunctorImageFilter, Traits)
+{
+  static_assert(itk::Functor::HasEvaluateSpan<AffineFunctor, float, std::tuple<short>>::value);
+  static_assert(!itk::Functor::HasEvaluateSpan<AffineFunctor, double, std::tuple<short>>::value);
+  static_assert(
+    itk::Functor::HasEvaluateSpan<itk::Functor::Add2<short, short, short>, short, std::tuple<short, short>>::value);
+  static_assert(
+    !itk::Functor::HasEvaluateSpan<itk::Functor::Div<short, short, short>, short, std::tuple<short, short>>::value);
+  static_assert(itk::CanEvaluateFunctorOnSpans<AffineFunctor, FloatImageType, ShortImageType>);
+  static_assert(!itk::CanEvaluateFunctorOnSpans<AffineFunctor, itk::Image<float, 2>, ShortImageType>);
+  static_assert(!itk::CanEvaluateFunctorOnSpans<itk::Functor::Add2<float, float, float>,
+                                                itk::VectorImage<float, 3>,
+                                                itk::VectorImage<float, 3>,
+                                                itk::VectorImage<float, 3>>);
+}
+
+
+TEST(SpanFunctorImageFilter, UnaryFunctorImageFilter)
+{
+  const auto input = MakeImage<ShortImageType>(3);
+  const auto filter = itk::UnaryFunctorImageFilter<ShortImageType, FloatImageType, AffineFunctor>::New();
+  filter->SetInput(input);
+
+  numberOfSpanPixels = 0;
+  filter->Update();
+  EXPECT_EQ(numberOfSpanPixels, input->GetBufferedRegion().GetNumberOfPixels());
+  ExpectPixels(*filter->GetOutput(), input->GetBufferedRegion(), [&input](const ShortImageType::IndexType & index) {
+    return AffineFunctor{}(input->GetPixel(index));
+  });
+
+  // A requested region that is not contiguous in the buffer of the input.
+  const ShortImageType::RegionType requestedRegion({ { 3, 2, 1 } }, { { 20, 7, 5 } });
+  const auto regionFilter = itk::UnaryFunctorImageFilter<ShortImageType, FloatImageType, AffineFunctor>::New();
+  regionFilter->SetInput(input);
+  regionFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  numberOfSpanPixels = 0;
+  regionFilter->Update();
+  EXPECT_EQ(numberOfSpanPixels, requestedRegion.GetNumberOfPixels());
+  ExpectPixels(*regionFilter->GetOutput(), requestedRegion, [&input](const ShortImageType::IndexType & index) {
+    return AffineFunctor{}(input->GetPixel(index));
+  });
+}
+
+
+TEST(SpanFunctorImageFilter, AddImageFilter)
+{
+  const auto input1 = MakeImage<ShortImageType>(1);
+  const auto input2 = MakeImage<ShortImageType>(2);
+  const auto add = [](short a, short b) { return static_cast<short>(a + b); };
+
+  using FilterType = itk::AddImageFilter<ShortImageType>;
+  {
+    const auto filter = FilterType::New();
+    filter->SetInput1(input1);
+    filter->SetInput2(input2);
+    filter->Update();
+    ExpectPixels(*filter->GetOutput(), input1->GetBufferedRegion(), [&](const ShortImageType::IndexType & index) {
+      return add(input1->GetPixel(index), input2->GetPixel(index));
+    });
+  }
+  {
+    const auto filter = FilterType::New();
+    filter->SetInput1(input1);
+    filter->SetConstant2(-7);
+    filter->Update();
+    ExpectPixels(*filter->GetOutput(), input1->GetBufferedRegion(), [&](const ShortImageType::IndexType & index) {
+      return add(input1->GetPixel(index), -7);
+    });
+  }
+  {
+    const auto filter = FilterType::New();
+    filter->SetConstant1(11);
+    filter->SetInput2(input2);
+    filter->Update();
+    ExpectPixels(*filter->GetOutput(), input2->GetBufferedRegion(), [&](const ShortImageType::IndexType & index) {
+      return add(11, input2->GetPixel(index));
+    });
+  }
+  {
+    // In place, where the output is the buffer of the first input.
+    const auto         inPlaceInput = MakeImage<ShortImageType>(1);
+    const auto * const inputBuffer = inPlaceInput->GetBufferPointer();
+    const auto         filter = FilterType::New();
+    filter->SetInput1(inPlaceInput);
+    filter->SetInput2(input2);
+    filter->InPlaceOn();
+    filter->Update();
+    EXPECT_EQ(filter->GetOutput()->GetBufferPointer(), inputBuffer);
+    ExpectPixels(*filter->GetOutput(), input1->GetBufferedRegion(), [&](const ShortImageType::IndexType & index) {
+      return add(input1->GetPixel(index), input2->GetPixel(index));
+    });
+  }
+}
+
+
+TEST(SpanFunctorImageFilter, ClampImageFilter)
+{
+  const auto input = MakeImage<FloatImageType>(5);
+  const auto filter = itk::ClampImageFilter<FloatImageType, ShortImageType>::New();
+  filter->SetInput(input);
+  filter->SetBounds(-20, 30);
+  filter->Update();
+  ExpectPixels(*filter->GetOutput(), input->GetBufferedRegion(), [&](const FloatImageType::IndexType & index) {
+    return static_cast<short>(std::clamp(input->GetPixel(index), -20.0f, 30.0f));
+  });
+}
+
+
+TEST(SpanFunctorImageFilter, TernaryFunctorImageFilter)
+{
+  const auto input1 = MakeImage<FloatImageType>(1);
+  const auto input2 = MakeImage<FloatImageType>(2);
+  const auto input3 = MakeImage<FloatImageType>(3);
+
+  using FunctorType = itk::Functor::Add3<float, float, float, float>;
+  const auto filter =
+    itk::TernaryFunctorImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, FunctorType>::New();
+  filter->SetInput1(input1);
+  filter->SetInput2(input2);
+  filter->SetInput3(input3);
+  filter->Update();
+  ExpectPixels(*filter->GetOutput(), input1->GetBufferedRegion(), [&](const FloatImageType::IndexType & index) {
+    return input1->GetPixel(index) + input2->GetPixel(index) + input3->GetPixel(index);
+  });
+}
@@ -29,6 +29,7 @@
 
 #include <algorithm>   // For max.
 #include <type_traits> // For is_same.
+#include <vector>
 
 namespace itk
 {
@@ -464,6 +465,14 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // The input indices of a scan line, and the interpolated values of those
+  // inside the buffer, which are evaluated in runs by a single call to the
+  // interpolator. For an axis-aligned transform, the indices of a scan line
+  // only differ along the first dimension, which interpolators may exploit.
+  const SizeValueType                   lineLength = outputRegionForThread.GetSize(0);
+  std::vector<ContinuousInputIndexType> inputIndices(lineLength);
+  std::vector<InterpolatorOutputType>   values(lineLength);
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -479,24 +488,36 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
     IndexValueType scanlineIndex = outIt.GetIndex()[0];
 
-
-    while (!outIt.IsAtEndOfLine())
+    for (auto & inputIndex : inputIndices)
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-      ContinuousInputIndexType inputIndex(startIndex);
+      inputIndex = startIndex;
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
+      ++scanlineIndex;
+    }
 
+    SizeValueType i = 0;
+    while (i < lineLength)
+    {
       // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      if (m_Interpolator->IsInsideBuffer(inputIndices[i]))
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        SizeValueType end = i + 1;
+        while (end < lineLength && m_Interpolator->IsInsideBuffer(inputIndices[end]))
+        {
+          ++end;
+        }
+        m_Interpolator->EvaluateAtContinuousIndices(&inputIndices[i], &values[i], end - i);
+        for (; i < end; ++i, ++outIt)
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(values[i]));
+        }
       }
       else
       {
@@ -506,12 +527,11 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
         }
         else
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[i])));
         }
+        ++outIt;
+        ++i;
       }
-
-      ++outIt;
-      ++scanlineIndex;
     }
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
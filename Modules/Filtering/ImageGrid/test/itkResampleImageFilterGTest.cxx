@@ -19,7 +19,11 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
 #include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkLinearInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -172,3 +176,55 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+// Tests that the output of an axis-aligned resampling, whose scan lines are
+// interpolated in runs of indices that only differ along the first dimension,
+// is the value of the interpolator at each mapped point, or the default
+// value outside of the input.
+TEST(ResampleImageFilter, AxisAlignedResamplingInterpolatesEachPixel)
+{
+  using ImageType = itk::Image<float, 3>;
+  using InterpolatorType = itk::LinearInterpolateImageFunction<ImageType>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 12, 10, 8 } });
+  image->Allocate();
+  std::default_random_engine randomEngine;
+  for (auto && pixel : itk::ImageBufferRange<ImageType>(*image))
+  {
+    pixel = std::uniform_real_distribution<float>{ 0.0f, 100.0f }(randomEngine);
+  }
+
+  const auto transform = itk::AffineTransform<double, 3>::New();
+  transform->Scale(itk::MakeVector(0.7, 0.9, 1.1));
+  transform->Translate(itk::MakeVector(-1.3, 0.6, 0.25));
+
+  const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetSize(ImageType::SizeType{ { 21, 11, 7 } });
+  filter->SetDefaultPixelValue(-1.0f);
+  filter->Update();
+
+  const auto interpolator = InterpolatorType::New();
+  interpolator->SetInputImage(image);
+
+  const ImageType * const output = filter->GetOutput();
+  itk::SizeValueType      numberOfInsidePixels = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto point = transform->TransformPoint(output->TransformIndexToPhysicalPoint<double>(it.GetIndex()));
+    if (interpolator->IsInsideBuffer(point))
+    {
+      EXPECT_NEAR(it.Get(), interpolator->Evaluate(point), 1e-4) << "index " << it.GetIndex();
+      ++numberOfInsidePixels;
+    }
+    else
+    {
+      EXPECT_EQ(it.Get(), -1.0f) << "index " << it.GetIndex();
+    }
+  }
+  EXPECT_GT(numberOfInsidePixels, 0u);
+  EXPECT_LT(numberOfInsidePixels, output->GetBufferedRegion().GetNumberOfPixels());
+}
@@ -46,6 +46,15 @@ public:
   {
     return static_cast<TOutput>(A + B);
   }
+
+  void
+  EvaluateSpan(const TInput1 * A, const TInput2 * B, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = static_cast<TOutput>(A[i] + B[i]);
+    }
+  }
 };
 
 
@@ -71,6 +80,19 @@ public:
   {
     return static_cast<TOutput>(A + B + C);
   }
+
+  void
+  EvaluateSpan(const TInput1 * A,
+               const TInput2 * B,
+               const TInput3 * C,
+               TOutput *       output,
+               SizeValueType   numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = static_cast<TOutput>(A[i] + B[i] + C[i]);
+    }
+  }
 };
 
 
@@ -96,6 +118,15 @@ public:
   {
     return static_cast<TOutput>(A - B);
   }
+
+  void
+  EvaluateSpan(const TInput1 * A, const TInput2 * B, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = static_cast<TOutput>(A[i] - B[i]);
+    }
+  }
 };
 
 
@@ -121,6 +152,15 @@ public:
   {
     return static_cast<TOutput>(A * B);
   }
+
+  void
+  EvaluateSpan(const TInput1 * A, const TInput2 * B, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = static_cast<TOutput>(A[i] * B[i]);
+    }
+  }
 };
 
 
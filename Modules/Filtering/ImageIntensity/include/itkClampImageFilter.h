@@ -75,6 +75,9 @@ public:
   OutputType
   operator()(const InputType & A) const;
 
+  void
+  EvaluateSpan(const InputType * A, OutputType * output, SizeValueType numberOfPixels) const;
+
   itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputType, OutputType>));
   itkConceptMacro(InputConvertibleToDoubleCheck, (Concept::Convertible<InputType, double>));
   itkConceptMacro(DoubleLessThanComparableToOutputCheck, (Concept::LessThanComparable<double, OutputType>));
@@ -105,6 +108,22 @@ Clamp<TInput, TOutput>::operator()(const InputType & A) const -> OutputType
   return static_cast<OutputType>(A);
 }
 
+
+template <typename TInput, typename TOutput>
+void
+Clamp<TInput, TOutput>::EvaluateSpan(const InputType * A, OutputType * output, SizeValueType numberOfPixels) const
+{
+  // Copies of the bounds, so that the compiler knows that they are not
+  // modified by writing the output.
+  const OutputType lowerBound = m_LowerBound;
+  const OutputType upperBound = m_UpperBound;
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    const auto dA = static_cast<double>(A[i]);
+    output[i] = dA < lowerBound ? lowerBound : (dA > upperBound ? upperBound : static_cast<OutputType>(A[i]));
+  }
+}
+
 } // end namespace Functor
 
 
@@ -89,3 +89,40 @@ TEST(ArithmeticOpsTest, UnaryMinus)
   EXPECT_EQ(-1, op1(1));
   EXPECT_EQ(2, op1(-2));
 }
+
+
+TEST(ArithmeticOpsTest, EvaluateSpan)
+{
+  const short A[] = { 1, -2, 300, 4, 5 };
+  const short B[] = { 7, 8, -9, 10, 11 };
+  const short C[] = { 100, 200, 300, 400, 500 };
+  short       output[5];
+
+  const itk::Functor::Add2<short, short, short> add;
+  add.EvaluateSpan(A, B, output, 5);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(output[i], add(A[i], B[i]));
+  }
+
+  const itk::Functor::Sub2<short, short, short> sub;
+  sub.EvaluateSpan(A, B, output, 5);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(output[i], sub(A[i], B[i]));
+  }
+
+  const itk::Functor::Mult<short, short, short> mult;
+  mult.EvaluateSpan(A, B, output, 5);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(output[i], mult(A[i], B[i]));
+  }
+
+  const itk::Functor::Add3<short, short, short, short> add3;
+  add3.EvaluateSpan(A, B, C, output, 5);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(output[i], add3(A[i], B[i], C[i]));
+  }
+}
@@ -110,6 +110,7 @@ public:
   using OutputSizeType = typename TOutputImage::SizeType;
   using OutputOffsetType = typename TOutputImage::OffsetType;
   using OutputImagePixelType = typename TOutputImage::PixelType;
+  using LabelObjectType = typename TOutputImage::LabelObjectType;
 
   /**
    * Set/Get whether the connected components are defined strictly by
@@ -125,18 +125,39 @@ BinaryImageToLabelMapFilter<TInputImage, TOutputImage>::GenerateData()
                                             << ").");
   }
 
+  // The labels are consecutive, so the label objects are kept in a flat
+  // container indexed by label, rather than looked up in the label map for
+  // each line, and their lines are counted first to be stored without reallocation.
+  std::vector<SizeValueType> numberOfLinesOfLabel(static_cast<SizeValueType>(m_NumberOfObjects) + 1, 0);
+  for (const LineEncodingType & line : this->m_LineMap)
+  {
+    for (const RunLength & run : line)
+    {
+      ++numberOfLinesOfLabel[static_cast<SizeValueType>(this->m_Consecutive[this->LookupSet(run.label)])];
+    }
+  }
+
+  std::vector<LabelObjectType *> labelObjects(numberOfLinesOfLabel.size(), nullptr);
+  for (SizeValueType lab = 0; lab < numberOfLinesOfLabel.size(); ++lab)
+  {
+    if (numberOfLinesOfLabel[lab] > 0)
+    {
+      const auto labelObject = LabelObjectType::New();
+      labelObject->SetLabel(static_cast<OutputPixelType>(lab));
+      labelObject->ReserveLines(numberOfLinesOfLabel[lab]);
+      output->AddLabelObject(labelObject);
+      labelObjects[lab] = labelObject;
+    }
+  }
+
   for (SizeValueType thisIdx = 0; thisIdx < linecount; ++thisIdx)
   {
     // now fill the labelled sections
-    auto       cIt = this->m_LineMap[thisIdx].begin();
-    const auto cEnd = this->m_LineMap[thisIdx].end();
-
-    while (cIt != cEnd)
+    for (const RunLength & run : this->m_LineMap[thisIdx])
     {
-      const InternalLabelType Ilab = this->LookupSet(cIt->label);
+      const InternalLabelType Ilab = this->LookupSet(run.label);
       const OutputPixelType   lab = this->m_Consecutive[Ilab];
-      output->SetLine(cIt->where, cIt->length, lab);
-      ++cIt;
+      labelObjects[static_cast<SizeValueType>(lab)]->AddLine(run.where, run.length);
     }
     progress.CompletedPixel();
   }
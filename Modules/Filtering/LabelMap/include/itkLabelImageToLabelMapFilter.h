@@ -33,6 +33,13 @@ namespace itk
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
+ * Each work unit collects the runs of its region, which are then merged
+ * into the label objects. When the labels are integers in a range that is
+ * not much larger than the number of runs, the runs are counted and moved
+ * into a flat container indexed by label, and each label object is filled in
+ * parallel with its lines, in a single allocation. Otherwise the runs are
+ * added to the output one by one.
+ *
  * This implementation was taken from the Insight Journal paper:
  * https://doi.org/10.54294/q6auw4
  *
@@ -72,6 +79,7 @@ public:
   using OutputImagePixelType = typename OutputImageType::PixelType;
   using LabelObjectType = typename OutputImageType::LabelObjectType;
   using LengthType = typename LabelObjectType::LengthType;
+  using LineType = typename LabelObjectType::LineType;
 
   /** ImageDimension constants */
   static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
@@ -126,7 +134,20 @@ protected:
 private:
   OutputImagePixelType m_BackgroundValue{};
 
-  typename std::vector<OutputImagePointer> m_TemporaryImages{};
+  /** A run of pixels of the same label, along the dimension 0. */
+  struct LabelRun
+  {
+    OutputImagePixelType label;
+    LineType             line;
+  };
+
+  /** Adds the runs to their label objects in the output, through a flat
+   * container indexed by the label minus the minimum label. */
+  void
+  MergeRunsByLabel(OutputImagePixelType minimumLabel, SizeValueType numberOfLabels, SizeValueType numberOfRuns);
+
+  /** The runs found by each work unit, in the order of the scan. */
+  std::vector<std::vector<LabelRun>> m_Runs{};
 }; // end of class
 } // end namespace itk
 
@@ -21,6 +21,7 @@
 #include "itkNumericTraits.h"
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -58,25 +59,10 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  // init the temp images - one per thread
-  m_TemporaryImages.resize(this->GetNumberOfWorkUnits());
+  this->GetOutput()->SetBackgroundValue(m_BackgroundValue);
 
-  for (ThreadIdType i = 0; i < this->GetNumberOfWorkUnits(); ++i)
-  {
-    if (i == 0)
-    {
-      // the first one is the output image
-      m_TemporaryImages[0] = this->GetOutput();
-    }
-    else
-    {
-      // the other must be created
-      m_TemporaryImages[i] = OutputImageType::New();
-    }
-
-    // set the minimum data needed to create the objects properly
-    m_TemporaryImages[i]->SetBackgroundValue(m_BackgroundValue);
-  }
+  // one container of runs per work unit
+  m_Runs.assign(this->GetNumberOfWorkUnits(), std::vector<LabelRun>());
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -91,6 +77,8 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
   InputLineIteratorType it(this->GetInput(), regionForThread);
   it.SetDirection(0);
 
+  std::vector<LabelRun> & runs = m_Runs[threadId];
+
   for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
   {
     it.GoToBeginOfLine();
@@ -111,8 +99,12 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
           ++length;
           ++it;
         }
-        // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        // keep the run, unless its label is the background of the label map
+        const auto label = static_cast<OutputImagePixelType>(value);
+        if (label != m_BackgroundValue)
+        {
+          runs.push_back({ label, LineType(idx, length) });
+        }
       }
       else
       {
@@ -130,34 +122,155 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData
 {
   OutputImageType * output = this->GetOutput();
 
-  // merge the lines from the temporary images in the output image
-  // don't use the first image - that's the output image
-  for (ThreadIdType i = 1; i < this->GetNumberOfWorkUnits(); ++i)
+  SizeValueType numberOfRuns = 0;
+  for (const std::vector<LabelRun> & runs : m_Runs)
+  {
+    numberOfRuns += runs.size();
+  }
+
+  if constexpr (std::is_integral_v<OutputImagePixelType>)
   {
-    for (typename OutputImageType::Iterator it(m_TemporaryImages[i]); !it.IsAtEnd(); ++it)
+    if (numberOfRuns > 0)
     {
-      LabelObjectType * labelObject = it.GetLabelObject();
-      if (output->HasLabel(labelObject->GetLabel()))
+      OutputImagePixelType minimumLabel = NumericTraits<OutputImagePixelType>::max();
+      OutputImagePixelType maximumLabel = NumericTraits<OutputImagePixelType>::NonpositiveMin();
+      for (const std::vector<LabelRun> & runs : m_Runs)
       {
-        // merge the lines in the output's object
-        LabelObjectType *                           lo = output->GetLabelObject(labelObject->GetLabel());
-        typename LabelObjectType::ConstLineIterator lit(labelObject);
-        while (!lit.IsAtEnd())
+        for (const LabelRun & run : runs)
         {
-          lo->AddLine(lit.GetLine());
-          ++lit;
+          minimumLabel = std::min(minimumLabel, run.label);
+          maximumLabel = std::max(maximumLabel, run.label);
         }
       }
-      else
+
+      // the flat container is used when its size is of the order of the number of runs
+      const SizeValueType labelRange =
+        static_cast<SizeValueType>(maximumLabel) - static_cast<SizeValueType>(minimumLabel);
+      if (labelRange < 4 * numberOfRuns + (SizeValueType{ 1 } << 20))
+      {
+        this->MergeRunsByLabel(minimumLabel, labelRange + 1, numberOfRuns);
+        return;
+      }
+    }
+  }
+
+  // add the runs one by one, in the order of the work units
+  for (const std::vector<LabelRun> & runs : m_Runs)
+  {
+    for (const LabelRun & run : runs)
+    {
+      output->SetLine(run.line.GetIndex(), run.line.GetLength(), run.label);
+    }
+  }
+
+  // release the runs
+  m_Runs.clear();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+LabelImageToLabelMapFilter<TInputImage, TOutputImage>::MergeRunsByLabel(OutputImagePixelType minimumLabel,
+                                                                        SizeValueType        numberOfLabels,
+                                                                        SizeValueType        numberOfRuns)
+{
+  OutputImageType * output = this->GetOutput();
+
+  const auto labelIndex = [minimumLabel](OutputImagePixelType label) {
+    return static_cast<SizeValueType>(label) - static_cast<SizeValueType>(minimumLabel);
+  };
+
+  // The work units are gathered in consecutive groups, with one count per
+  // label and per group, so that the counts take about as much memory as the runs.
+  const auto          numberOfWorkUnits = static_cast<SizeValueType>(m_Runs.size());
+  const SizeValueType numberOfGroups =
+    std::clamp<SizeValueType>((4 * numberOfRuns + (SizeValueType{ 1 } << 20)) / numberOfLabels, 1, numberOfWorkUnits);
+  const auto firstWorkUnitOfGroup = [numberOfWorkUnits, numberOfGroups](SizeValueType group) {
+    return group * numberOfWorkUnits / numberOfGroups;
+  };
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // count the runs of each label in each group
+  std::vector<SizeValueType> positions(numberOfGroups * numberOfLabels, 0);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfGroups,
+    [&](SizeValueType group) {
+      SizeValueType * counts = positions.data() + group * numberOfLabels;
+      for (SizeValueType w = firstWorkUnitOfGroup(group); w < firstWorkUnitOfGroup(group + 1); ++w)
+      {
+        for (const LabelRun & run : m_Runs[w])
+        {
+          ++counts[labelIndex(run.label)];
+        }
+      }
+    },
+    nullptr);
+
+  // turn the counts into the positions of the runs in the flat container,
+  // where the lines of a label are in the order of the groups
+  std::vector<SizeValueType> firstLineOfLabel(numberOfLabels + 1);
+  SizeValueType              position = 0;
+  for (SizeValueType l = 0; l < numberOfLabels; ++l)
+  {
+    firstLineOfLabel[l] = position;
+    for (SizeValueType group = 0; group < numberOfGroups; ++group)
+    {
+      SizeValueType &     count = positions[group * numberOfLabels + l];
+      const SizeValueType numberOfLinesInGroup = count;
+      count = position;
+      position += numberOfLinesInGroup;
+    }
+  }
+  firstLineOfLabel[numberOfLabels] = position;
+
+  // move the lines to the flat container
+  std::vector<LineType> lines(numberOfRuns);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfGroups,
+    [&](SizeValueType group) {
+      SizeValueType * nextPositions = positions.data() + group * numberOfLabels;
+      for (SizeValueType w = firstWorkUnitOfGroup(group); w < firstWorkUnitOfGroup(group + 1); ++w)
       {
-        // simply take the object
-        output->AddLabelObject(labelObject);
+        for (const LabelRun & run : m_Runs[w])
+        {
+          lines[nextPositions[labelIndex(run.label)]++] = run.line;
+        }
       }
+    },
+    nullptr);
+  m_Runs.clear();
+
+  // create the label objects, in the order of the labels
+  std::vector<LabelObjectType *> labelObjects;
+  std::vector<SizeValueType>     labelIndices;
+  for (SizeValueType l = 0; l < numberOfLabels; ++l)
+  {
+    if (firstLineOfLabel[l + 1] > firstLineOfLabel[l])
+    {
+      const auto labelObject = LabelObjectType::New();
+      labelObject->SetLabel(static_cast<OutputImagePixelType>(static_cast<SizeValueType>(minimumLabel) + l));
+      output->AddLabelObject(labelObject);
+      labelObjects.push_back(labelObject);
+      labelIndices.push_back(l);
     }
   }
 
-  // release the data in the temp images
-  m_TemporaryImages.clear();
+  // and fill them with their lines
+  multiThreader->ParallelizeArray(
+    0,
+    labelObjects.size(),
+    [&](SizeValueType i) {
+      const SizeValueType l = labelIndices[i];
+      labelObjects[i]->ReserveLines(firstLineOfLabel[l + 1] - firstLineOfLabel[l]);
+      for (SizeValueType j = firstLineOfLabel[l]; j < firstLineOfLabel[l + 1]; ++j)
+      {
+        labelObjects[i]->AddLine(lines[j]);
+      }
+    },
+    nullptr);
 }
 
 template <typename TInputImage, typename TOutputImage>
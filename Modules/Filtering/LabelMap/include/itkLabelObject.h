@@ -18,7 +18,7 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -142,6 +142,13 @@ public:
   void
   AddLine(const LineType & line);
 
+  /**
+   * Reserve the memory of the given number of lines, so that as many lines
+   * are then added without reallocating the line container.
+   */
+  void
+  ReserveLines(SizeValueType numberOfLines);
+
   SizeValueType
   GetNumberOfLines() const;
 
@@ -278,7 +285,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -376,7 +383,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     void
     NextValidLine()
@@ -404,7 +411,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  using LineContainerType = typename std::vector<LineType>;
 
   LineContainerType m_LineContainer{};
   LabelType         m_Label{};
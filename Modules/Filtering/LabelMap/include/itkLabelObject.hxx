@@ -188,6 +188,13 @@ LabelObject<TLabel, VImageDimension>::AddLine(const LineType & line)
   m_LineContainer.push_back(line);
 }
 
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::ReserveLines(SizeValueType numberOfLines)
+{
+  m_LineContainer.reserve(numberOfLines);
+}
+
 template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetNumberOfLines() const -> SizeValueType
@@ -266,6 +273,7 @@ LabelObject<TLabel, VImageDimension>::CopyLinesFrom(const TSourceLabelObject * s
   itkAssertOrThrowMacro((src != nullptr), "Null Pointer");
   // clear original lines and copy lines
   m_LineContainer.clear();
+  m_LineContainer.reserve(src->GetNumberOfLines());
   for (size_t i = 0; i < src->GetNumberOfLines(); ++i)
   {
     this->AddLine(src->GetLine(static_cast<SizeValueType>(i)));
@@ -305,9 +313,10 @@ LabelObject<TLabel, VImageDimension>::Optimize()
 {
   if (!m_LineContainer.empty())
   {
-    // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
+    // first move the lines to another container, and make room for as many in the current one
+    LineContainerType lineContainer;
+    lineContainer.swap(m_LineContainer);
+    m_LineContainer.reserve(lineContainer.size());
 
     // reorder the lines
     const typename Functor::LabelObjectLineComparator<LineType> comparator;
@@ -31,6 +31,10 @@ namespace itk
  * A line is formed of and index and a length in the dimension 0.
  * It is used in a run-length encoding
  *
+ * LabelObjectLine has no virtual methods, so that a line takes no more
+ * memory than its index and its length, and the lines of a LabelObject
+ * are stored contiguously.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -52,7 +56,7 @@ public:
 
   LabelObjectLine();
   LabelObjectLine(const IndexType & idx, const LengthType & length);
-  virtual ~LabelObjectLine() = default;
+  ~LabelObjectLine() = default;
 
   /**
    * Set/Get Index
@@ -90,13 +94,13 @@ protected:
    * including superclasses. Typically not called by the user (use Print()
    * instead) but used in the hierarchical print process to combine the
    * output of several classes.  */
-  virtual void
+  void
   PrintSelf(std::ostream & os, Indent indent) const;
 
-  virtual void
+  void
   PrintHeader(std::ostream & os, Indent indent) const;
 
-  virtual void
+  void
   PrintTrailer(std::ostream & os, Indent indent) const;
 
 private:
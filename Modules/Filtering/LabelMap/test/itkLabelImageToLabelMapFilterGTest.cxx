@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkBinaryImageToLabelMapFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkGTest.h"
+
+namespace
+{
+
+template <typename TPixel>
+typename itk::Image<TPixel, 3>::Pointer
+MakeLabelImage(const std::vector<TPixel> & labels)
+{
+  // Blocks of labels that are cut into several runs on a line, and that
+  // are spread over the regions of several work units.
+  using ImageType = itk::Image<TPixel, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::SizeType{ { 37, 23, 19 } });
+  image->Allocate();
+  unsigned int state = 12345;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & idx = it.GetIndex();
+    state = state * 1103515245u + 12345u;
+    const auto block = static_cast<size_t>(idx[0] / 5 + 3 * (idx[1] / 4) + 7 * (idx[2] / 6));
+    it.Set((state >> 16) % 9 == 0 ? labels[0] : labels[block % labels.size()]);
+  }
+  return image;
+}
+
+// Checks that the label map has exactly the pixels of the label image that are
+// not of the background, and that the lines of each object are in the order of the scan.
+template <typename TImage, typename TLabelMap>
+void
+ExpectSameLabels(const TImage & image, const TLabelMap & labelMap, typename TImage::PixelType backgroundValue)
+{
+  auto painted = TImage::New();
+  painted->CopyInformation(&image);
+  painted->SetRegions(image.GetBufferedRegion());
+  painted->Allocate();
+  painted->FillBuffer(backgroundValue);
+
+  for (typename TLabelMap::ConstIterator it(&labelMap); !it.IsAtEnd(); ++it)
+  {
+    const auto * labelObject = it.GetLabelObject();
+    EXPECT_NE(labelObject->GetLabel(), backgroundValue);
+    EXPECT_GT(labelObject->GetNumberOfLines(), 0u);
+    for (itk::SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i)
+    {
+      const auto & line = labelObject->GetLine(i);
+      if (i > 0)
+      {
+        const auto & previous = labelObject->GetLine(i - 1).GetIndex();
+        auto         idx = line.GetIndex();
+        EXPECT_TRUE(std::lexicographical_compare(previous.rbegin(), previous.rend(), idx.rbegin(), idx.rend()));
+      }
+      auto idx = line.GetIndex();
+      for (itk::SizeValueType j = 0; j < line.GetLength(); ++j, ++idx[0])
+      {
+        ASSERT_EQ(painted->GetPixel(idx), backgroundValue);
+        painted->SetPixel(idx, labelObject->GetLabel());
+      }
+    }
+  }
+
+  itk::ImageRegionConstIterator<TImage> expectedIt(&image, image.GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> actualIt(painted, image.GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    ASSERT_EQ(expectedIt.Get(), actualIt.Get());
+  }
+}
+
+template <typename TPixel>
+void
+CheckLabelImageToLabelMap(const std::vector<TPixel> & labels, TPixel backgroundValue)
+{
+  using ImageType = itk::Image<TPixel, 3>;
+  const auto image = MakeLabelImage(labels);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 8, 40 })
+  {
+    SCOPED_TRACE(numberOfWorkUnits);
+    const auto filter = itk::LabelImageToLabelMapFilter<ImageType>::New();
+    filter->SetInput(image);
+    filter->SetBackgroundValue(backgroundValue);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+    ExpectSameLabels(*image, *filter->GetOutput(), backgroundValue);
+  }
+}
+
+} // namespace
+
+
+TEST(LabelImageToLabelMapFilter, ConsecutiveLabels)
+{
+  CheckLabelImageToLabelMap<unsigned char>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, 0);
+}
+
+
+TEST(LabelImageToLabelMapFilter, SparseSignedLabels)
+{
+  CheckLabelImageToLabelMap<short>({ -32768, 32767, -3, 0, 1000, -1000, 17 }, -3);
+}
+
+
+TEST(LabelImageToLabelMapFilter, LabelsOfLargeRange)
+{
+  CheckLabelImageToLabelMap<unsigned int>({ 0, 4000000000u, 1, 123456789u, 2 }, 0);
+  CheckLabelImageToLabelMap<long long>(
+    { -1, std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max() }, -1);
+}
+
+
+TEST(LabelImageToLabelMapFilter, FloatingPointLabels)
+{
+  CheckLabelImageToLabelMap<float>({ 0.0f, 0.5f, -2.25f, 1e30f }, 0.0f);
+}
+
+
+TEST(BinaryImageToLabelMapFilter, ConsecutiveLabelsOfObjects)
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+  const auto image = MakeLabelImage<unsigned char>({ 0, 1, 0, 0, 1, 0, 1 });
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 5 })
+  {
+    const auto filter = itk::BinaryImageToLabelMapFilter<ImageType>::New();
+    filter->SetInput(image);
+    filter->SetInputForegroundValue(1);
+    filter->SetOutputBackgroundValue(2);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+    const auto * labelMap = filter->GetOutput();
+    ASSERT_GT(filter->GetNumberOfObjects(), 1u);
+    ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), filter->GetNumberOfObjects());
+
+    // the objects cover the foreground, with consecutive labels that skip the background
+    auto labels = ImageType::New();
+    labels->SetRegions(image->GetBufferedRegion());
+    labels->Allocate();
+    labels->FillBuffer(0);
+    itk::SizeValueType expectedLabel = 0;
+    for (itk::SizeValueType i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i, ++expectedLabel)
+    {
+      const auto * labelObject = labelMap->GetNthLabelObject(i);
+      expectedLabel += (expectedLabel == 2);
+      EXPECT_EQ(labelObject->GetLabel(), expectedLabel);
+      for (itk::SizeValueType j = 0; j < labelObject->GetNumberOfLines(); ++j)
+      {
+        const auto & line = labelObject->GetLine(j);
+        auto         idx = line.GetIndex();
+        for (itk::SizeValueType k = 0; k < line.GetLength(); ++k, ++idx[0])
+        {
+          ASSERT_EQ(labels->GetPixel(idx), 0);
+          labels->SetPixel(idx, 1);
+        }
+      }
+    }
+    itk::ImageRegionConstIterator<ImageType> expectedIt(image, image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> actualIt(labels, image->GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      ASSERT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+}
@@ -53,11 +53,24 @@ GrayscaleDilateImageFilter<TInputImage, TOutputImage, TKernel>::SetKernel(const
 {
   const auto * flatKernel = dynamic_cast<const FlatKernelType *>(&kernel);
 
+  if (flatKernel != nullptr && !flatKernel->GetDecomposable())
+  {
+    // the VHGW filter splits the kernel into chords
+    m_VHGWFilter->SetKernel(*flatKernel);
+  }
+
   if (flatKernel != nullptr && flatKernel->GetDecomposable())
   {
     m_AnchorFilter->SetKernel(*flatKernel);
     m_Algorithm = AlgorithmEnum::ANCHOR;
   }
+  else if (flatKernel != nullptr && 2 * m_VHGWFilter->GetNumberOfChords() < flatKernel->Size())
+  {
+    // the cost of a chord doesn't depend on its length, so the chords are
+    // cheaper than the pixels of the kernel, or than the histogram, unless the
+    // kernel is made of many short chords
+    m_Algorithm = AlgorithmEnum::VHGW;
+  }
   else if (m_HistogramFilter->GetUseVectorBasedAlgorithm())
   {
     // histogram based filter is as least as good as the basic one, so always
@@ -122,7 +135,7 @@ GrayscaleDilateImageFilter<TInputImage, TOutputImage, TKernel>::SetAlgorithm(Alg
     {
       m_AnchorFilter->SetKernel(*flatKernel);
     }
-    else if (flatKernel != nullptr && flatKernel->GetDecomposable() && algo == AlgorithmEnum::VHGW)
+    else if (flatKernel != nullptr && algo == AlgorithmEnum::VHGW)
     {
       m_VHGWFilter->SetKernel(*flatKernel);
     }
@@ -41,6 +41,11 @@ namespace itk
  * values (zero or one). Only elements of the structuring element
  * having values > 0 are candidates for affecting the center pixel.
  *
+ * SetKernel() selects the algorithm: ANCHOR for a decomposable flat
+ * structuring element, VHGW, which applies the structuring element by its
+ * chords, for any other flat structuring element that is not made of too many
+ * short chords, such as a ball, and otherwise BASIC or HISTO.
+ *
  * \sa MorphologyImageFilter, GrayscaleFunctionErodeImageFilter, BinaryErodeImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  * \ingroup ITKMathematicalMorphology
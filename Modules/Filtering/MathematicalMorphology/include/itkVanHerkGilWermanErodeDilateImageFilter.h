@@ -21,6 +21,7 @@
 #include "itkKernelImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkBresenhamLine.h"
+#include <vector>
 
 namespace itk
 {
@@ -36,6 +37,23 @@ class KernelImageFilter;
  * The SetBoundary facility isn't necessary for operation of the
  * anchor method but is included for compatibility with other
  * morphology classes in itk.
+ *
+ * A decomposable structuring element is applied line after line, as
+ * described by van Herk and by Gil and Werman. Any other flat structuring
+ * element, such as a ball, is split into chords: the runs of its pixels along
+ * the dimension 0. The extremum of the input over each distinct chord length
+ * is computed along each input line with the van Herk algorithm, at a cost
+ * that does not depend on the length, and the output is the extremum of these
+ * values at the positions of the chords. The cost per pixel is therefore
+ * proportional to the number of chords of the structuring element, instead
+ * of to its number of pixels. The decomposition into chords is that of Urbach
+ * and Wilkinson.
+ *
+ * Reference:
+ * E. R. Urbach and M. H. F. Wilkinson, "Efficient 2-D Grayscale Morphological
+ * Transformations With Arbitrary Flat Structuring Elements", IEEE Transactions
+ * on Image Processing, 17(1): 1-8, 2008.
+ *
  * \ingroup ITKMathematicalMorphology
  */
 template <typename TImage, typename TKernel, typename TFunction1>
@@ -61,6 +79,7 @@ public:
   using InputImagePixelType = typename InputImageType::PixelType;
   using IndexType = typename TImage::IndexType;
   using SizeType = typename TImage::SizeType;
+  using OffsetType = typename TImage::OffsetType;
 
   /** ImageDimension constants */
   static constexpr unsigned int InputImageDimension = TImage::ImageDimension;
@@ -76,6 +95,14 @@ public:
   itkSetMacro(Boundary, InputImagePixelType);
   itkGetConstMacro(Boundary, InputImagePixelType);
 
+  /** Set the kernel, and split it into chords when it is not decomposable. */
+  void
+  SetKernel(const KernelType & kernel) override;
+
+  /** Get the number of chords of the kernel, or 0 when it is decomposable.
+   * The cost of the filter per pixel is proportional to this number. */
+  itkGetConstMacro(NumberOfChords, SizeValueType);
+
 protected:
   VanHerkGilWermanErodeDilateImageFilter();
   ~VanHerkGilWermanErodeDilateImageFilter() override = default;
@@ -86,6 +113,11 @@ protected:
   void
   DynamicThreadedGenerateData(const InputImageRegionType & outputRegionForThread) override;
 
+  /** Computes the output by the chords of a structuring element that is
+   * not decomposable. */
+  void
+  GenerateDataByChords(const InputImageRegionType & outputRegionForThread);
+
 
   // should be set by the meta filter
   InputImagePixelType m_Boundary{};
@@ -93,6 +125,27 @@ protected:
 private:
   using BresType = BresenhamLine<Self::InputImageDimension>;
 
+  /** A run of the structuring element along the dimension 0, which starts at
+   * begin relative to the center of the structuring element. */
+  struct Chord
+  {
+    OffsetValueType begin;
+    SizeValueType   length;
+  };
+
+  /** The chords of a line of the structuring element along the dimension 0,
+   * sorted by length, and the range they cover along that line. */
+  struct ChordLine
+  {
+    OffsetType         offset;
+    OffsetValueType    begin;
+    OffsetValueType    end;
+    std::vector<Chord> chords;
+  };
+
+  std::vector<ChordLine> m_ChordLines{};
+  SizeValueType          m_NumberOfChords{};
+
 }; // end of class
 } // end namespace itk
 
@@ -19,8 +19,11 @@
 #define itkVanHerkGilWermanErodeDilateImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 
 #include "itkVanHerkGilWermanUtilities.h"
+#include <algorithm>
+#include <memory>
 
 namespace itk
 {
@@ -32,15 +35,65 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::VanHerkGilW
   this->ThreaderUpdateProgressOff();
 }
 
+template <typename TImage, typename TKernel, typename TFunction1>
+void
+VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::SetKernel(const KernelType & kernel)
+{
+  Superclass::SetKernel(kernel);
+
+  m_ChordLines.clear();
+  m_NumberOfChords = 0;
+  if (kernel.GetDecomposable())
+  {
+    return;
+  }
+
+  const auto lineLength = static_cast<OffsetValueType>(kernel.GetSize(0));
+  const auto radius = static_cast<OffsetValueType>(kernel.GetRadius(0));
+  for (SizeValueType start = 0; start < kernel.Size(); start += lineLength)
+  {
+    ChordLine line;
+    line.offset = kernel.GetOffset(start);
+    line.offset[0] = 0;
+    for (OffsetValueType i = 0; i < lineLength;)
+    {
+      if (!kernel[start + i])
+      {
+        ++i;
+        continue;
+      }
+      OffsetValueType end = i + 1;
+      while (end < lineLength && kernel[start + end])
+      {
+        ++end;
+      }
+      line.chords.push_back({ i - radius, static_cast<SizeValueType>(end - i) });
+      i = end;
+    }
+    if (line.chords.empty())
+    {
+      continue;
+    }
+    line.begin = line.chords.front().begin;
+    line.end = line.chords.back().begin + static_cast<OffsetValueType>(line.chords.back().length);
+    // chords of the same length share their extrema
+    std::stable_sort(line.chords.begin(), line.chords.end(), [](const Chord & a, const Chord & b) {
+      return a.length < b.length;
+    });
+    m_NumberOfChords += line.chords.size();
+    m_ChordLines.push_back(std::move(line));
+  }
+}
+
 template <typename TImage, typename TKernel, typename TFunction1>
 void
 VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenerateData(
   const InputImageRegionType & outputRegionForThread)
 {
-  // check that we are using a decomposable kernel
   if (!this->GetKernel().GetDecomposable())
   {
-    itkExceptionMacro("VanHerkGilWerman morphology only works with decomposable structuring elements");
+    this->GenerateDataByChords(outputRegionForThread);
+    return;
   }
 
   // TFunction1 will be < for erosions
@@ -114,12 +167,128 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
   ImageAlgorithm::Copy(input.GetPointer(), this->GetOutput(), OReg, OReg);
 }
 
+template <typename TImage, typename TKernel, typename TFunction1>
+void
+VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::GenerateDataByChords(
+  const InputImageRegionType & outputRegionForThread)
+{
+  const InputImageType *     input = this->GetInput();
+  InputImageType *           output = this->GetOutput();
+  const InputImageRegionType inputRegion = input->GetRequestedRegion();
+  const InputImagePixelType  boundary = m_Boundary;
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  // the input under a line of the structuring element is loaded in buffer,
+  // and the forward and reverse extrema are computed in blocks of the length
+  // of a chord: the extremum over the chord at each pixel of the output line
+  // is that of the reverse extremum at its first pixel and of the forward
+  // extremum at its last pixel
+  const SizeValueType  numberOfPixels = outputRegionForThread.GetSize(0);
+  const IndexValueType inputBegin = inputRegion.GetIndex(0);
+  const IndexValueType inputEnd = inputBegin + static_cast<IndexValueType>(inputRegion.GetSize(0));
+  const SizeValueType  bufferLength = numberOfPixels + this->GetKernel().GetSize(0);
+
+  const auto                  buffers = std::make_unique<InputImagePixelType[]>(3 * bufferLength + numberOfPixels);
+  InputImagePixelType * const buffer = buffers.get();
+  InputImagePixelType * const forward = buffer + bufferLength;
+  InputImagePixelType * const reverse = forward + bufferLength;
+  InputImagePixelType * const result = reverse + bufferLength;
+  std::fill(result, result + numberOfPixels, boundary);
+  TFunction1 m_TF;
+
+  ImageScanlineIterator<InputImageType> outputIt(output, outputRegionForThread);
+  while (!outputIt.IsAtEnd())
+  {
+    const IndexType index = outputIt.GetIndex();
+    bool            first = true;
+    for (const ChordLine & line : m_ChordLines)
+    {
+      IndexType lineIndex = index + line.offset;
+      lineIndex[0] = inputBegin;
+      if (!inputRegion.IsInside(lineIndex))
+      {
+        // the whole line of the structuring element is out of the input
+        for (SizeValueType j = 0; j < numberOfPixels; ++j)
+        {
+          result[j] = first ? boundary : m_TF(result[j], boundary);
+        }
+        first = false;
+        continue;
+      }
+
+      // load the input under the line of the structuring element, padded
+      // with the boundary value
+      const IndexValueType        loadBegin = index[0] + line.begin;
+      const IndexValueType        loadEnd = index[0] + static_cast<IndexValueType>(numberOfPixels) + line.end - 1;
+      const IndexValueType        copyBegin = std::clamp(loadBegin, inputBegin, inputEnd);
+      const IndexValueType        copyEnd = std::clamp(loadEnd, inputBegin, inputEnd);
+      const InputImagePixelType * inputLine = input->GetBufferPointer() + input->ComputeOffset(lineIndex);
+      std::fill(buffer, buffer + (copyBegin - loadBegin), boundary);
+      std::copy(
+        inputLine + (copyBegin - inputBegin), inputLine + (copyEnd - inputBegin), buffer + (copyBegin - loadBegin));
+      std::fill(buffer + (copyEnd - loadBegin), buffer + (loadEnd - loadBegin), boundary);
+      const auto loadLength = static_cast<SizeValueType>(loadEnd - loadBegin);
+
+      SizeValueType length = 0;
+      for (const Chord & chord : line.chords)
+      {
+        if (chord.length != length)
+        {
+          length = chord.length;
+          for (SizeValueType blockBegin = 0; blockBegin < loadLength; blockBegin += length)
+          {
+            const SizeValueType blockEnd = std::min(blockBegin + length, loadLength);
+            forward[blockBegin] = buffer[blockBegin];
+            for (SizeValueType i = blockBegin + 1; i < blockEnd; ++i)
+            {
+              forward[i] = m_TF(forward[i - 1], buffer[i]);
+            }
+            reverse[blockEnd - 1] = buffer[blockEnd - 1];
+            for (SizeValueType i = blockEnd - 1; i > blockBegin; --i)
+            {
+              reverse[i - 1] = m_TF(reverse[i], buffer[i - 1]);
+            }
+          }
+        }
+
+        const InputImagePixelType * const begins = reverse + (chord.begin - line.begin);
+        const InputImagePixelType * const ends = forward + (chord.begin - line.begin) + (length - 1);
+        if (first)
+        {
+          for (SizeValueType j = 0; j < numberOfPixels; ++j)
+          {
+            result[j] = m_TF(begins[j], ends[j]);
+          }
+          first = false;
+        }
+        else
+        {
+          for (SizeValueType j = 0; j < numberOfPixels; ++j)
+          {
+            result[j] = m_TF(result[j], m_TF(begins[j], ends[j]));
+          }
+        }
+      }
+    }
+
+    for (SizeValueType j = 0; j < numberOfPixels; ++j)
+    {
+      outputIt.Set(result[j]);
+      ++outputIt;
+    }
+    outputIt.NextLine();
+    progress.Completed(numberOfPixels);
+  }
+}
+
 template <typename TImage, typename TKernel, typename TFunction1>
 void
 VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Boundary: " << m_Boundary << std::endl;
+  os << indent << "NumberOfChords: " << m_NumberOfChords << std::endl;
 }
 
 } // end namespace itk
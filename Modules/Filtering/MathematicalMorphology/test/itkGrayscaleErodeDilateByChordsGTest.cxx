@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkGTest.h"
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int state = 12345;
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    state = state * 1103515245u + 12345u;
+    it.Set(static_cast<typename TImage::PixelType>((state >> 16) % 200));
+  }
+  return image;
+}
+
+// Runs the morphology filter with the given algorithm, on several work units.
+template <typename TFilter>
+typename TFilter::OutputImageType::Pointer
+Run(const typename TFilter::InputImageType *      image,
+    const typename TFilter::KernelType &          kernel,
+    typename TFilter::AlgorithmEnum               algorithm,
+    const typename TFilter::RegionType & requestedRegion)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetKernel(kernel);
+  filter->SetAlgorithm(algorithm);
+  filter->SetNumberOfWorkUnits(3);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+template <typename TImage>
+void
+ExpectEqualPixels(const TImage & expected, const TImage & actual)
+{
+  ASSERT_EQ(expected.GetRequestedRegion(), actual.GetRequestedRegion());
+  itk::ImageRegionConstIterator<TImage> expectedIt(&expected, expected.GetRequestedRegion());
+  itk::ImageRegionConstIterator<TImage> actualIt(&actual, actual.GetRequestedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    ASSERT_EQ(expectedIt.Get(), actualIt.Get()) << "at " << expectedIt.GetIndex();
+  }
+}
+
+// Compares the chords with the basic algorithm, over the whole image and over
+// a part of it.
+template <typename TFilter>
+void
+CheckChords(const typename TFilter::InputImageType * image, const typename TFilter::KernelType & kernel)
+{
+  using RegionType = typename TFilter::RegionType;
+  ASSERT_FALSE(kernel.GetDecomposable());
+
+  RegionType partial = image->GetLargestPossibleRegion();
+  partial.ShrinkByRadius(3);
+  partial.SetIndex(0, partial.GetIndex(0) + 2);
+  for (const RegionType & region : { image->GetLargestPossibleRegion(), partial })
+  {
+    const auto expected = Run<TFilter>(image, kernel, TFilter::AlgorithmEnum::BASIC, region);
+    const auto actual = Run<TFilter>(image, kernel, TFilter::AlgorithmEnum::VHGW, region);
+    ExpectEqualPixels(*expected, *actual);
+  }
+}
+
+} // namespace
+
+
+TEST(GrayscaleErodeDilateByChords, Balls2D)
+{
+  using ImageType = itk::Image<short, 2>;
+  using KernelType = itk::FlatStructuringElement<2>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 61, 47 } });
+
+  for (const itk::SizeValueType radius : { 1, 2, 5, 9 })
+  {
+    SCOPED_TRACE(radius);
+    const auto kernel = KernelType::Ball(KernelType::RadiusType::Filled(radius));
+    CheckChords<itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+    CheckChords<itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+  }
+}
+
+
+TEST(GrayscaleErodeDilateByChords, Balls3D)
+{
+  using ImageType = itk::Image<float, 3>;
+  using KernelType = itk::FlatStructuringElement<3>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 23, 19, 17 } });
+
+  for (const itk::SizeValueType radius : { 1, 4 })
+  {
+    SCOPED_TRACE(radius);
+    const auto kernel = KernelType::Ball(KernelType::RadiusType::Filled(radius));
+    CheckChords<itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+    CheckChords<itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+  }
+}
+
+
+TEST(GrayscaleErodeDilateByChords, ArbitraryShapes)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using KernelType = itk::FlatStructuringElement<2>;
+  const auto image = MakeImage<ImageType>(ImageType::SizeType{ { 40, 33 } });
+
+  // not symmetric, with several chords of different lengths on some lines,
+  // and lines without chords
+  KernelType::RadiusType radius;
+  radius[0] = 4;
+  radius[1] = 3;
+  const auto annulus = KernelType::Annulus(radius, 2);
+  CheckChords<itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>>(image, annulus);
+
+  KernelType kernel = KernelType::Box(radius);
+  kernel.SetDecomposable(false);
+  for (itk::SizeValueType i = 0; i < kernel.Size(); ++i)
+  {
+    kernel[i] = (i * 7) % 5 < 2 && i / kernel.GetSize(0) != 2;
+  }
+  CheckChords<itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+  CheckChords<itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>>(image, kernel);
+}
+
+
+TEST(GrayscaleErodeDilateByChords, SelectedForLargeBalls)
+{
+  using ImageType = itk::Image<short, 3>;
+  using KernelType = itk::FlatStructuringElement<3>;
+  using FilterType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+
+  auto filter = FilterType::New();
+  filter->SetKernel(KernelType::Ball(KernelType::RadiusType::Filled(8)));
+  EXPECT_EQ(filter->GetAlgorithm(), FilterType::AlgorithmEnum::VHGW);
+
+  // decomposable structuring elements still use the anchor algorithm
+  filter->SetKernel(KernelType::Polygon(KernelType::RadiusType::Filled(8), 7));
+  EXPECT_EQ(filter->GetAlgorithm(), FilterType::AlgorithmEnum::ANCHOR);
+}
@@ -36,7 +36,13 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For images of 8-bit and 16-bit integers and large enough neighborhoods,
+ * the median is computed by a TieredHistogramRankCalculator, at a cost per
+ * pixel which barely depends on the radius, rather than by sorting the pixels
+ * of each neighborhood. Both compute the same output.
+ *
  * \sa Image
+ * \sa TieredHistogramRankCalculator
  * \sa Neighborhood
  * \sa NeighborhoodOperator
  * \sa NeighborhoodIterator
@@ -84,6 +90,11 @@ public:
 
   using InputSizeType = typename InputImageType::SizeType;
 
+  /** Tells whether the median is computed from histograms by a
+   * TieredHistogramRankCalculator, which depends on the pixel type and the radius. */
+  bool
+  GetUseHistogramAlgorithm() const;
+
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
   itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputPixelType, OutputPixelType>));
   itkConceptMacro(InputLessThanComparableCheck, (Concept::LessThanComparable<InputPixelType>));
@@ -25,6 +25,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkShapedImageNeighborhoodRange.h"
+#include "itkTieredHistogramRankCalculator.h"
 #include "itkTotalProgressReporter.h"
 
 #include <vector>
@@ -39,6 +40,26 @@ MedianImageFilter<TInputImage, TOutputImage>::MedianImageFilter()
   this->ThreaderUpdateProgressOff();
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+MedianImageFilter<TInputImage, TOutputImage>::GetUseHistogramAlgorithm() const
+{
+  if constexpr (TieredHistogramRankCalculator<InputImageType>::IsSupportedImageType)
+  {
+    // The neighborhood size above which the histograms are faster than
+    // sorting, which depends on the number of bins.
+    const SizeValueType minimumNeighborhoodSize = sizeof(InputPixelType) == 1 ? 9 : 49;
+    SizeValueType       neighborhoodSize = 1;
+    for (const SizeValueType radius : this->GetRadius())
+    {
+      neighborhoodSize *= 2 * radius + 1;
+    }
+    return neighborhoodSize >= minimumNeighborhoodSize;
+  }
+  return false;
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
@@ -50,6 +71,27 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 
   const auto radius = this->GetRadius();
 
+  if constexpr (TieredHistogramRankCalculator<InputImageType>::IsSupportedImageType)
+  {
+    if (this->GetUseHistogramAlgorithm())
+    {
+      TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+      TieredHistogramRankCalculator<InputImageType> calculator(*input, radius);
+      SizeValueType                                 neighborhoodSize = 1;
+      for (const SizeValueType radiusValue : radius)
+      {
+        neighborhoodSize *= 2 * radiusValue + 1;
+      }
+      calculator.Compute(
+        outputRegionForThread, neighborhoodSize / 2, [output, &progress](const auto & index, const auto value) {
+          output->SetPixel(index, static_cast<OutputPixelType>(value));
+          progress.CompletedPixel();
+        });
+      return;
+    }
+  }
+
   // Find the data-set boundary "faces" and the center non-boundary subregion.
   const auto calculatorResult =
     NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTieredHistogramRankCalculator_h
+#define itkTieredHistogramRankCalculator_h
+
+#include "itkImage.h"
+#include "itkSpanFunctorTraits.h"
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/** \class TieredHistogramRankCalculator
+ *
+ * \brief Computes ranks (like the median) of box neighborhoods of 8-bit and
+ * 16-bit integer images, at a cost per pixel which barely depends on the radius.
+ *
+ * This is the algorithm of Perreault and Hebert, "Median Filtering in
+ * Constant Time" (IEEE TIP 2007), extended to N dimensions. The histogram of
+ * the neighborhood of a pixel is the sum of the histograms of the "slabs" of
+ * the neighborhood, which are its (N-1)-dimensional slices orthogonal to the
+ * first dimension. Along a line of the first dimension, the histogram is
+ * updated by adding one slab and removing another. From one line to the next
+ * one, the histogram of each slab is updated by adding and removing the
+ * (N-2)-dimensional faces of the slab, that is just two pixels in 2D. The
+ * histograms are tiered: a coarse histogram of the high half of the bits of
+ * the values, which locates the bin of the rank, and a fine histogram of all
+ * the bits, of which only the bins under the coarse bin of the rank are
+ * updated, lazily.
+ *
+ * The image is extended beyond its buffered region by replicating its
+ * border, as ZeroFluxNeumannBoundaryCondition does, so that the ranks are
+ * those computed from a ShapedImageNeighborhoodRange with its default
+ * boundary condition.
+ *
+ * The histograms of the slabs take (2^8 + 2^16) * 4 bytes each for 16-bit
+ * pixels, so the regions are processed by tiles along the first dimension,
+ * of which the histograms take at most MaximumHistogramSizeInBytes.
+ *
+ * \sa MedianImageFilter
+ *
+ * \ingroup ITKSmoothing
+ */
+template <typename TInputImage>
+class ITK_TEMPLATE_EXPORT TieredHistogramRankCalculator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(TieredHistogramRankCalculator);
+
+  using ImageType = TInputImage;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using SizeType = typename ImageType::SizeType;
+  using RegionType = typename ImageType::RegionType;
+  using OffsetType = typename ImageType::OffsetType;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  /** Tells whether the calculator supports the image type: itk::Image of
+   * (non-boolean) integers of 8 or 16 bits. */
+  static constexpr bool IsSupportedImageType = std::is_integral_v<PixelType> && !std::is_same_v<PixelType, bool> &&
+                                               sizeof(PixelType) <= 2 && IsContiguousPixelImage<ImageType>;
+
+  /** The number of bits of the fine bins per coarse bin, half the bits of the pixel values. */
+  static constexpr unsigned int FineBits = 4 * sizeof(PixelType);
+  static constexpr unsigned int NumberOfCoarseBins = 1u << FineBits;
+  static constexpr unsigned int NumberOfFineBinsPerCoarseBin = 1u << FineBits;
+  static constexpr unsigned int NumberOfBins = NumberOfCoarseBins * NumberOfFineBinsPerCoarseBin;
+
+  /** The maximum size of the histograms of the slabs of a tile. */
+  static constexpr SizeValueType MaximumHistogramSizeInBytes = SizeValueType{ 16 } << 20;
+
+  /** Prepares the calculation of the ranks of the box neighborhoods of the
+   * given radius, within the buffered region of the image. */
+  TieredHistogramRankCalculator(const ImageType & image, const SizeType & radius);
+
+  /** Calls function(index, value) for each index of the region, in the order
+   * of the tiles of the region, and then of ImageRegionIndexRange within a
+   * tile, where value is the pixel value of the given rank (from 0 to the
+   * number of pixels of a neighborhood, minus one) of the neighborhood of
+   * the index. */
+  template <typename TFunction>
+  void
+  Compute(const RegionType & region, SizeValueType rank, TFunction && function);
+
+private:
+  using CountType = uint32_t;
+
+  static unsigned int
+  ToBin(PixelType value)
+  {
+    return static_cast<unsigned int>(static_cast<int>(value) - static_cast<int>(NumericTraits<PixelType>::min()));
+  }
+
+  static PixelType
+  FromBin(unsigned int bin)
+  {
+    return static_cast<PixelType>(static_cast<int>(bin) + static_cast<int>(NumericTraits<PixelType>::min()));
+  }
+
+  /** The offset in the buffer of the index, clamped to the buffered region,
+   * not counting the first dimension. */
+  OffsetValueType
+  ComputeClampedOffsetOfLine(const IndexType & index) const;
+
+  /** Tells whether the line follows the previous one along the second dimension. */
+  static bool
+  IsNextLine(const IndexType & previousLineIndex, const IndexType & lineIndex)
+  {
+    if constexpr (ImageDimension > 1)
+    {
+      return lineIndex[1] == previousLineIndex[1] + 1;
+    }
+    return false;
+  }
+
+  /** Adds (or removes, for a delta of -1) the pixels of the line at the given
+   * offset to the histograms of the slabs. */
+  void
+  AddLineToSlabs(OffsetValueType lineOffset, int delta);
+
+  /** Adds (or removes) all the pixels of the slabs of the line. */
+  void
+  AddSlabs(const IndexType & lineIndex, int delta);
+
+  /** Moves the slabs of a line to the next line along the second dimension. */
+  void
+  MoveSlabsToNextLine(const IndexType & lineIndex);
+
+  const PixelType * m_Buffer;
+  IndexType         m_BufferedRegionIndex;
+  IndexType         m_BufferedRegionUpperIndex;
+  OffsetValueType   m_OffsetTable[ImageDimension + 1];
+  SizeType          m_Radius;
+
+  // The offsets of the pixels of a slab, and of a face of a slab, from the
+  // center of the slab; their first component is zero.
+  std::vector<OffsetType> m_SlabOffsets;
+  std::vector<OffsetType> m_FaceOffsets;
+
+  // The clamped offsets, along the first dimension, of the slabs of the current tile.
+  std::vector<OffsetValueType> m_SlabOffsetsAlongLine;
+
+  std::vector<CountType> m_SlabCoarseHistograms;
+  std::vector<CountType> m_SlabFineHistograms;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkTieredHistogramRankCalculator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,268 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTieredHistogramRankCalculator_hxx
+#define itkTieredHistogramRankCalculator_hxx
+
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+
+#include <algorithm>
+
+namespace itk
+{
+template <typename TInputImage>
+TieredHistogramRankCalculator<TInputImage>::TieredHistogramRankCalculator(const ImageType & image,
+                                                                           const SizeType &  radius)
+  : m_Buffer(image.GetBufferPointer())
+  , m_BufferedRegionIndex(image.GetBufferedRegion().GetIndex())
+  , m_BufferedRegionUpperIndex(image.GetBufferedRegion().GetUpperIndex())
+  , m_Radius(radius)
+{
+  static_assert(IsSupportedImageType, "TieredHistogramRankCalculator supports images of 8-bit and 16-bit integers.");
+  std::copy_n(image.GetOffsetTable(), ImageDimension + 1, m_OffsetTable);
+
+  SizeType slabRadius = radius;
+  slabRadius[0] = 0;
+  m_SlabOffsets = GenerateRectangularImageNeighborhoodOffsets(slabRadius);
+  SizeType faceRadius = slabRadius;
+  if constexpr (ImageDimension > 1)
+  {
+    faceRadius[1] = 0;
+  }
+  m_FaceOffsets = GenerateRectangularImageNeighborhoodOffsets(faceRadius);
+}
+
+
+template <typename TInputImage>
+OffsetValueType
+TieredHistogramRankCalculator<TInputImage>::ComputeClampedOffsetOfLine(const IndexType & index) const
+{
+  OffsetValueType offset = 0;
+  for (unsigned int i = 1; i < ImageDimension; ++i)
+  {
+    const IndexValueType clampedIndex =
+      std::clamp(index[i], m_BufferedRegionIndex[i], m_BufferedRegionUpperIndex[i]) - m_BufferedRegionIndex[i];
+    offset += clampedIndex * m_OffsetTable[i];
+  }
+  return offset;
+}
+
+
+template <typename TInputImage>
+void
+TieredHistogramRankCalculator<TInputImage>::AddLineToSlabs(OffsetValueType lineOffset, int delta)
+{
+  const auto        countDelta = static_cast<CountType>(delta);
+  const PixelType * line = m_Buffer + lineOffset;
+  CountType *       coarseHistogram = m_SlabCoarseHistograms.data();
+  CountType *       fineHistogram = m_SlabFineHistograms.data();
+  for (const OffsetValueType offsetAlongLine : m_SlabOffsetsAlongLine)
+  {
+    const unsigned int bin = ToBin(line[offsetAlongLine]);
+    coarseHistogram[bin >> FineBits] += countDelta;
+    fineHistogram[bin] += countDelta;
+    coarseHistogram += NumberOfCoarseBins;
+    fineHistogram += NumberOfBins;
+  }
+}
+
+
+template <typename TInputImage>
+void
+TieredHistogramRankCalculator<TInputImage>::AddSlabs(const IndexType & lineIndex, int delta)
+{
+  for (const OffsetType & offset : m_SlabOffsets)
+  {
+    this->AddLineToSlabs(this->ComputeClampedOffsetOfLine(lineIndex + offset), delta);
+  }
+}
+
+
+template <typename TInputImage>
+void
+TieredHistogramRankCalculator<TInputImage>::MoveSlabsToNextLine(const IndexType & lineIndex)
+{
+  // The slabs of the previous line lose their face at lineIndex[1] - radius[1] - 1,
+  // and gain one at lineIndex[1] + radius[1].
+  if constexpr (ImageDimension > 1)
+  {
+    const auto radius1 = static_cast<IndexValueType>(m_Radius[1]);
+    for (const OffsetType & offset : m_FaceOffsets)
+    {
+      IndexType faceIndex = lineIndex + offset;
+      faceIndex[1] -= radius1 + 1;
+      this->AddLineToSlabs(this->ComputeClampedOffsetOfLine(faceIndex), -1);
+      faceIndex[1] += 2 * radius1 + 1;
+      this->AddLineToSlabs(this->ComputeClampedOffsetOfLine(faceIndex), 1);
+    }
+  }
+}
+
+
+template <typename TInputImage>
+template <typename TFunction>
+void
+TieredHistogramRankCalculator<TInputImage>::Compute(const RegionType & region,
+                                                    SizeValueType      rank,
+                                                    TFunction &&       function)
+{
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const auto           radius0 = static_cast<IndexValueType>(m_Radius[0]);
+  const SizeValueType  kernelWidth = 2 * m_Radius[0] + 1;
+  const SizeValueType  regionWidth = region.GetSize(0);
+  const IndexValueType regionBegin = region.GetIndex(0);
+
+  // The tiles are at least 16 pixels wide, even when their slabs exceed the maximum size.
+  const SizeValueType slabSizeInBytes = (NumberOfCoarseBins + NumberOfBins) * sizeof(CountType);
+  const SizeValueType maximumNumberOfSlabs = MaximumHistogramSizeInBytes / slabSizeInBytes;
+  const SizeValueType tileWidth =
+    std::min(regionWidth,
+             std::max<SizeValueType>(16, maximumNumberOfSlabs > kernelWidth ? maximumNumberOfSlabs - kernelWidth + 1 : 0));
+
+  std::vector<CountType> kernelCoarseHistogram(NumberOfCoarseBins);
+  std::vector<CountType> kernelFineHistogram(NumberOfBins);
+  // The position along the line at which the fine bins of each coarse bin of
+  // the kernel histogram were last updated.
+  std::vector<IndexValueType> fineHistogramPositions(NumberOfCoarseBins);
+
+  RegionType lineRegion = region;
+  lineRegion.SetSize(0, 1);
+
+  for (SizeValueType tileBegin = 0; tileBegin < regionWidth; tileBegin += tileWidth)
+  {
+    const SizeValueType  width = std::min(tileWidth, regionWidth - tileBegin);
+    const SizeValueType  numberOfSlabs = width + kernelWidth - 1;
+    const IndexValueType firstSlabIndex = regionBegin + static_cast<IndexValueType>(tileBegin) - radius0;
+
+    m_SlabOffsetsAlongLine.resize(numberOfSlabs);
+    for (SizeValueType slab = 0; slab < numberOfSlabs; ++slab)
+    {
+      m_SlabOffsetsAlongLine[slab] = std::clamp(firstSlabIndex + static_cast<IndexValueType>(slab),
+                                                m_BufferedRegionIndex[0],
+                                                m_BufferedRegionUpperIndex[0]) -
+                                     m_BufferedRegionIndex[0];
+    }
+    m_SlabCoarseHistograms.assign(numberOfSlabs * NumberOfCoarseBins, 0);
+    m_SlabFineHistograms.assign(numberOfSlabs * NumberOfBins, 0);
+
+    bool      hasPreviousLine = false;
+    IndexType previousLineIndex{};
+    for (IndexType lineIndex : ImageRegionIndexRange<ImageDimension>(lineRegion))
+    {
+      if (!hasPreviousLine)
+      {
+        this->AddSlabs(lineIndex, 1);
+      }
+      else if (IsNextLine(previousLineIndex, lineIndex))
+      {
+        this->MoveSlabsToNextLine(lineIndex);
+      }
+      else
+      {
+        this->AddSlabs(previousLineIndex, -1);
+        this->AddSlabs(lineIndex, 1);
+      }
+      hasPreviousLine = true;
+      previousLineIndex = lineIndex;
+
+      // The kernel of the i-th pixel of the tile covers the slabs i to i + kernelWidth - 1.
+      std::fill(kernelCoarseHistogram.begin(), kernelCoarseHistogram.end(), 0);
+      for (SizeValueType slab = 0; slab < kernelWidth; ++slab)
+      {
+        const CountType * const slabHistogram = &m_SlabCoarseHistograms[slab * NumberOfCoarseBins];
+        for (unsigned int bin = 0; bin < NumberOfCoarseBins; ++bin)
+        {
+          kernelCoarseHistogram[bin] += slabHistogram[bin];
+        }
+      }
+      std::fill(fineHistogramPositions.begin(), fineHistogramPositions.end(), -1);
+
+      for (SizeValueType i = 0; i < width; ++i)
+      {
+        if (i > 0)
+        {
+          const CountType * const addedHistogram = &m_SlabCoarseHistograms[(i + kernelWidth - 1) * NumberOfCoarseBins];
+          const CountType * const removedHistogram = &m_SlabCoarseHistograms[(i - 1) * NumberOfCoarseBins];
+          for (unsigned int bin = 0; bin < NumberOfCoarseBins; ++bin)
+          {
+            kernelCoarseHistogram[bin] += addedHistogram[bin] - removedHistogram[bin];
+          }
+        }
+
+        SizeValueType remainingRank = rank;
+        unsigned int  coarseBin = 0;
+        while (remainingRank >= kernelCoarseHistogram[coarseBin])
+        {
+          remainingRank -= kernelCoarseHistogram[coarseBin];
+          ++coarseBin;
+        }
+
+        // Update the fine bins of the coarse bin, either incrementally, or
+        // from scratch when that is cheaper.
+        CountType * const    fineHistogram = &kernelFineHistogram[coarseBin * NumberOfFineBinsPerCoarseBin];
+        const IndexValueType position = static_cast<IndexValueType>(i);
+        IndexValueType &     lastPosition = fineHistogramPositions[coarseBin];
+        const SizeValueType  fineBinOffset = coarseBin * NumberOfFineBinsPerCoarseBin;
+        if (lastPosition >= 0 && 2 * static_cast<SizeValueType>(position - lastPosition) < kernelWidth)
+        {
+          for (auto step = static_cast<SizeValueType>(lastPosition + 1); step <= i; ++step)
+          {
+            const CountType * const addedHistogram =
+              &m_SlabFineHistograms[(step + kernelWidth - 1) * NumberOfBins + fineBinOffset];
+            const CountType * const removedHistogram = &m_SlabFineHistograms[(step - 1) * NumberOfBins + fineBinOffset];
+            for (unsigned int bin = 0; bin < NumberOfFineBinsPerCoarseBin; ++bin)
+            {
+              fineHistogram[bin] += addedHistogram[bin] - removedHistogram[bin];
+            }
+          }
+        }
+        else
+        {
+          std::fill_n(fineHistogram, NumberOfFineBinsPerCoarseBin, 0);
+          for (SizeValueType slab = i; slab < i + kernelWidth; ++slab)
+          {
+            const CountType * const slabHistogram = &m_SlabFineHistograms[slab * NumberOfBins + fineBinOffset];
+            for (unsigned int bin = 0; bin < NumberOfFineBinsPerCoarseBin; ++bin)
+            {
+              fineHistogram[bin] += slabHistogram[bin];
+            }
+          }
+        }
+        lastPosition = position;
+
+        unsigned int fineBin = 0;
+        while (remainingRank >= fineHistogram[fineBin])
+        {
+          remainingRank -= fineHistogram[fineBin];
+          ++fineBin;
+        }
+
+        lineIndex[0] = regionBegin + static_cast<IndexValueType>(tileBegin + i);
+        function(static_cast<const IndexType &>(lineIndex), FromBin(fineBinOffset + fineBin));
+      }
+    }
+  }
+}
+} // end namespace itk
+
+#endif
@@ -19,10 +19,13 @@
 // First include the header file to be tested:
 #include "itkMedianImageFilter.h"
 
+#include "itkCastImageFilter.h"
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkIndexRange.h"
 
 #include <numeric> // For iota.
+#include <random>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -92,6 +95,61 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+
+// Expects that the median computed from histograms equals the one computed by sorting the pixels as integers.
+template <typename TImage>
+void
+Expect_histogram_algorithm_computes_same_median_as_sorting(const typename TImage::SizeType & imageSize,
+                                                           const typename TImage::SizeType & radius,
+                                                           const int                         minimumValue,
+                                                           const int                         maximumValue)
+{
+  using PixelType = typename TImage::PixelType;
+  using IntImageType = itk::Image<int, TImage::ImageDimension>;
+
+  const auto image = TImage::New();
+  image->SetRegions(imageSize);
+  image->Allocate();
+  std::mt19937                       randomNumberEngine(static_cast<std::mt19937::result_type>(imageSize[0] + radius[0]));
+  std::uniform_int_distribution<int> distribution(minimumValue, maximumValue);
+  for (PixelType & pixel : itk::ImageBufferRange{ *image })
+  {
+    pixel = static_cast<PixelType>(distribution(randomNumberEngine));
+  }
+
+  const auto filter = itk::MedianImageFilter<TImage, TImage>::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  EXPECT_TRUE(filter->GetUseHistogramAlgorithm());
+  filter->Update();
+
+  const auto castFilter = itk::CastImageFilter<TImage, IntImageType>::New();
+  castFilter->SetInput(image);
+  const auto sortingFilter = itk::MedianImageFilter<IntImageType, IntImageType>::New();
+  sortingFilter->SetInput(castFilter->GetOutput());
+  sortingFilter->SetRadius(radius);
+  EXPECT_FALSE(sortingFilter->GetUseHistogramAlgorithm());
+  sortingFilter->Update();
+
+  const auto outputRange = itk::MakeImageBufferRange(filter->GetOutput());
+  const auto expectedRange = itk::MakeImageBufferRange(sortingFilter->GetOutput());
+  EXPECT_TRUE(std::equal(outputRange.cbegin(), outputRange.cend(), expectedRange.cbegin(), expectedRange.cend()));
+
+  // Only a part of the image.
+  typename TImage::RegionType requestedRegion = image->GetBufferedRegion();
+  requestedRegion.ShrinkByRadius(1);
+  const auto regionFilter = itk::MedianImageFilter<TImage, TImage>::New();
+  regionFilter->SetInput(image);
+  regionFilter->SetRadius(radius);
+  regionFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  regionFilter->Update();
+  for (const auto & index : itk::ImageRegionIndexRange<TImage::ImageDimension>(requestedRegion))
+  {
+    EXPECT_EQ(static_cast<int>(regionFilter->GetOutput()->GetPixel(index)), sortingFilter->GetOutput()->GetPixel(index));
+  }
+}
+
 } // namespace
 
 
@@ -122,3 +180,26 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the histogram algorithm, selected for 8-bit and 16-bit images, computes the same median as sorting,
+// also near and beyond the border of the image, and with tiles of regions of 16-bit images.
+TEST(MedianImageFilter, HistogramAlgorithmComputesSameMedianAsSorting)
+{
+  using SizeType = itk::Size<2>;
+  using Size3Type = itk::Size<3>;
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<unsigned char>>(
+    SizeType{ { 37, 23 } }, SizeType{ { 1, 1 } }, 0, 255);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<unsigned char>>(
+    SizeType{ { 37, 23 } }, SizeType{ { 25, 3 } }, 0, 255);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<signed char, 3>>(
+    Size3Type{ { 21, 17, 13 } }, Size3Type{ { 1, 3, 2 } }, -128, 127);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<short>>(
+    SizeType{ { 90, 31 } }, SizeType{ { 12, 9 } }, -32768, 32767);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<unsigned short>>(
+    SizeType{ { 70, 20 } }, SizeType{ { 30, 4 } }, 1000, 1300);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<short, 3>>(
+    Size3Type{ { 19, 15, 11 } }, Size3Type{ { 3, 3, 3 } }, -1024, 3071);
+  Expect_histogram_algorithm_computes_same_median_as_sorting<itk::Image<unsigned char, 1>>(
+    itk::Size<1>{ { 200 } }, itk::Size<1>{ { 20 } }, 0, 255);
+}
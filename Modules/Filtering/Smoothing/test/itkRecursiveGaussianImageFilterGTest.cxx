@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkRecursiveGaussianImageFilter.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkIndexRange.h"
+#include "itkVector.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using VectorImageType = itk::Image<itk::Vector<float, 2>, 3>;
+
+// Filters the image along the direction, in the requested region of the output.
+template <typename TImage>
+typename TImage::Pointer
+Filter(const TImage &                      image,
+       const unsigned int                  direction,
+       const itk::GaussianOrderEnum        order,
+       const typename TImage::RegionType & requestedRegion)
+{
+  const auto filter = itk::RecursiveGaussianImageFilter<TImage>::New();
+  filter->SetInput(&image);
+  filter->SetDirection(direction);
+  filter->SetOrder(order);
+  filter->SetSigma(1.5);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+} // namespace
+
+
+// Tests that filtering blocks of lines of a scalar image, as done for itk::Image of scalars, gives the results of
+// filtering the lines one by one, as done for vector images.
+TEST(RecursiveGaussianImageFilter, BlocksOfLinesGiveSameResultsAsSingleLines)
+{
+  const ImageType::RegionType imageRegion(ImageType::IndexType{ { 3, -2, 5 } }, ImageType::SizeType{ { 37, 21, 9 } });
+  const auto                  image = ImageType::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  const auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(imageRegion);
+  vectorImage->Allocate();
+
+  std::mt19937                          randomNumberEngine;
+  std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+  for (const auto & index : itk::ImageRegionIndexRange<3>(imageRegion))
+  {
+    const float value = distribution(randomNumberEngine);
+    image->SetPixel(index, value);
+    vectorImage->SetPixel(index, itk::MakeVector(value, -value));
+  }
+
+  const ImageType::RegionType partOfImage(ImageType::IndexType{ { 4, 0, 7 } }, ImageType::SizeType{ { 20, 17, 2 } });
+  for (const ImageType::RegionType & requestedRegion : { imageRegion, partOfImage })
+  {
+    for (unsigned int direction = 0; direction < 3; ++direction)
+    {
+      for (const auto order : { itk::GaussianOrderEnum::ZeroOrder,
+                                itk::GaussianOrderEnum::FirstOrder,
+                                itk::GaussianOrderEnum::SecondOrder })
+      {
+        const auto output = Filter(*image, direction, order, requestedRegion);
+        const auto vectorOutput = Filter(*vectorImage, direction, order, requestedRegion);
+        ASSERT_TRUE(output->GetBufferedRegion().IsInside(requestedRegion));
+        for (const auto & index : itk::ImageRegionIndexRange<3>(requestedRegion))
+        {
+          EXPECT_FLOAT_EQ(output->GetPixel(index), vectorOutput->GetPixel(index)[0]);
+          EXPECT_FLOAT_EQ(-output->GetPixel(index), vectorOutput->GetPixel(index)[1]);
+        }
+      }
+    }
+  }
+}
@@ -119,6 +119,21 @@ public:
     return m_OutsideValue;
   }
 
+  void
+  EvaluateSpan(const TInput * A, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    // Copies of the members, so that the compiler knows that they are not
+    // modified by writing the output.
+    const TInput  lowerThreshold = m_LowerThreshold;
+    const TInput  upperThreshold = m_UpperThreshold;
+    const TOutput insideValue = m_InsideValue;
+    const TOutput outsideValue = m_OutsideValue;
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = (lowerThreshold <= A[i] && A[i] <= upperThreshold) ? insideValue : outsideValue;
+    }
+  }
+
 private:
   TInput  m_LowerThreshold;
   TInput  m_UpperThreshold;
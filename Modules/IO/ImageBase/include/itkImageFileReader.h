@@ -118,6 +118,17 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the pixel buffer of the output image may be a memory
+   * mapping of the file, instead of a copy of its contents. This is only
+   * possible when the ImageIO reports the location of the pixel data (see
+   * ImageIOBase::GetPixelDataLocation), the whole image is read, and no
+   * pixel type conversion is needed; otherwise the file is read as usual.
+   * The mapping is copy-on-write: the output image may be modified, but the
+   * file is never modified. Default is false. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -153,6 +164,11 @@ protected:
   void
   GenerateData() override;
 
+  /** Tries to set the pixel buffer of the output image to a memory mapping
+   * of the file. Returns false when the file cannot be memory mapped. */
+  bool
+  MemoryMapOutput();
+
   ImageIOBase::Pointer m_ImageIO{};
 
   bool m_UserSpecifiedImageIO{}; // keep track whether the
@@ -160,6 +176,8 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
 private:
   std::string m_ExceptionMessage{};
 
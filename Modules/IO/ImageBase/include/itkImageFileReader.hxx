@@ -24,6 +24,7 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImportImageContainer.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
@@ -50,6 +51,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -355,13 +357,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   const typename TOutputImage::Pointer output = this->GetOutput();
 
-  itkDebugMacro("ImageFileReader::GenerateData() \n"
-                << "Allocating the buffer with the EnlargedRequestedRegion \n"
-                << output->GetRequestedRegion() << '\n');
-
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -384,6 +379,19 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   itkDebugMacro("Setting imageIO IORegion to: " << m_ActualIORegion);
   m_ImageIO->SetIORegion(m_ActualIORegion);
 
+  if (m_UseMemoryMapping && this->MemoryMapOutput())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  itkDebugMacro("ImageFileReader::GenerateData() \n"
+                << "Allocating the buffer with the EnlargedRequestedRegion \n"
+                << output->GetRequestedRegion() << '\n');
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
   // (as opposed to the sizes of the output)
@@ -440,6 +448,69 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MemoryMapOutput()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using MappedPixelContainerType =
+    MemoryMappedImportImageContainer<typename PixelContainerType::ElementIdentifier, OutputImagePixelType>;
+
+  if constexpr (std::is_base_of_v<PixelContainerType, MappedPixelContainerType>)
+  {
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    if (m_ImageIO->GetComponentType() != ioType ||
+        (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents()))
+    {
+      return false;
+    }
+
+    // Only the pixels of the whole file can be mapped, as the output buffer.
+    const typename TOutputImage::Pointer output = this->GetOutput();
+    const ImageRegionType                requestedRegion = output->GetRequestedRegion();
+
+    SizeValueType numberOfPixelsInFile = 1;
+    for (unsigned int i = 0; i < m_ImageIO->GetNumberOfDimensions(); ++i)
+    {
+      numberOfPixelsInFile *= m_ImageIO->GetDimensions(i);
+    }
+    if (m_ActualIORegion.GetNumberOfPixels() != numberOfPixelsInFile ||
+        requestedRegion.GetNumberOfPixels() != numberOfPixelsInFile)
+    {
+      return false;
+    }
+
+    const auto            numberOfBytes = static_cast<SizeValueType>(m_ImageIO->GetImageSizeInBytes());
+    std::string           fileName;
+    ImageIOBase::SizeType offset = 0;
+    if (numberOfBytes == 0 || numberOfBytes % sizeof(OutputImagePixelType) != 0 ||
+        !m_ImageIO->GetPixelDataLocation(fileName, offset) || offset < 0)
+    {
+      return false;
+    }
+
+    const auto pixelContainer = MappedPixelContainerType::New();
+    try
+    {
+      pixelContainer->MapFile(
+        fileName, static_cast<SizeValueType>(offset), numberOfBytes / sizeof(OutputImagePixelType));
+    }
+    catch (const ExceptionObject & err)
+    {
+      itkDebugMacro("Reading the file instead of memory mapping it: " << err.GetDescription());
+      return false;
+    }
+
+    output->SetBufferedRegion(requestedRegion);
+    output->SetPixelContainer(pixelContainer);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
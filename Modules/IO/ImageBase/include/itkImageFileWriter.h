@@ -172,6 +172,14 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum number of bytes that the upstream pipeline is to
+   * allocate to generate a piece of the image to write. When it is not zero,
+   * the number of pieces is the smallest one, supported by the ImageIO, whose
+   * estimate by PipelineMemoryPlanner is within it, and
+   * NumberOfStreamDivisions is ignored. Defaults to zero. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void
@@ -224,6 +232,10 @@ protected:
   GenerateData() override;
 
 private:
+  /** Returns the number of pieces within the memory budget. */
+  unsigned int
+  PlanNumberOfStreamDivisions(const ImageIORegion & pasteIORegion, const ImageIORegion & largestIORegion);
+
   std::string m_FileName{};
 
   ImageIOBase::Pointer m_ImageIO{};
@@ -231,6 +243,7 @@ private:
 
   ImageIORegion m_PasteIORegion{ TInputImage::ImageDimension };
   unsigned int  m_NumberOfStreamDivisions{ 1 };
+  SizeValueType m_MemoryBudget{ 0 };
   bool          m_UserSpecifiedIORegion{ false };
 
   bool m_FactorySpecifiedImageIO{ false }; // did factory mechanism set the ImageIO?
@@ -31,7 +31,9 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include "itkPipelineMemoryPlanner.h"
 #include <complex>
+#include <limits>
 
 namespace itk
 {
@@ -219,11 +221,6 @@ ImageFileWriter<TInputImage>::Write()
   // Notify start event observers
   this->InvokeEvent(StartEvent());
 
-  if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion)
-  {
-    m_ImageIO->SetUseStreamedWriting(true);
-  }
-
   ImageIORegion largestIORegion(TInputImage::ImageDimension);
   ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(largestRegion, largestIORegion, largestRegion.GetIndex());
 
@@ -246,13 +243,25 @@ ImageFileWriter<TInputImage>::Write()
                       << pasteIORegion << "Largest possible region: " << largestRegion);
   }
 
+  // Determine the requested number of divisions of the input, which keeps
+  // the upstream pipeline within the memory budget, if there is one
+  unsigned int numberOfStreamDivisions = m_NumberOfStreamDivisions;
+  if (m_MemoryBudget > 0)
+  {
+    numberOfStreamDivisions = this->PlanNumberOfStreamDivisions(pasteIORegion, largestIORegion);
+    m_ImageIO->SetUseStreamedWriting(numberOfStreamDivisions > 1 || m_UserSpecifiedIORegion);
+  }
+  else if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion)
+  {
+    m_ImageIO->SetUseStreamedWriting(true);
+  }
+
   // Determine the actual number of divisions of the input. This is determined
   // by what the ImageIO can do
   unsigned int numDivisions;
 
   // this may fail and throw an exception if the configuration is not supported
-  numDivisions =
-    m_ImageIO->GetActualNumberOfSplitsForWriting(m_NumberOfStreamDivisions, pasteIORegion, largestIORegion);
+  numDivisions = m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfStreamDivisions, pasteIORegion, largestIORegion);
 
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
@@ -322,6 +331,60 @@ ImageFileWriter<TInputImage>::Write()
   this->ReleaseInputs();
 }
 
+//---------------------------------------------------------
+template <typename TInputImage>
+unsigned int
+ImageFileWriter<TInputImage>::PlanNumberOfStreamDivisions(const ImageIORegion & pasteIORegion,
+                                                          const ImageIORegion & largestIORegion)
+{
+  auto *                     nonConstInput = const_cast<InputImageType *>(this->GetInput());
+  const InputImageRegionType largestRegion = nonConstInput->GetLargestPossibleRegion();
+
+  // The pieces are those of the ImageIO when it streams, of which the size
+  // of the largest one is estimated.
+  m_ImageIO->SetUseStreamedWriting(true);
+  const auto estimateSizeInBytes = [this, nonConstInput, &largestRegion, &pasteIORegion, &largestIORegion](
+                                     unsigned int numberOfDivisions) {
+    const unsigned int actualNumberOfDivisions =
+      m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfDivisions, pasteIORegion, largestIORegion);
+    ImageIORegion largestStreamIORegion(TInputImage::ImageDimension);
+    for (unsigned int piece = 0; piece < actualNumberOfDivisions; ++piece)
+    {
+      const ImageIORegion streamIORegion =
+        m_ImageIO->GetSplitRegionForWriting(piece, actualNumberOfDivisions, pasteIORegion, largestIORegion);
+      if (streamIORegion.GetNumberOfPixels() > largestStreamIORegion.GetNumberOfPixels())
+      {
+        largestStreamIORegion = streamIORegion;
+      }
+    }
+    InputImageRegionType streamRegion;
+    ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+      largestStreamIORegion, streamRegion, largestRegion.GetIndex());
+    nonConstInput->SetRequestedRegion(streamRegion);
+    return PipelineMemoryPlanner::EstimateUpdateSizeInBytes(nonConstInput);
+  };
+
+  // The largest number of pieces to consider, which keeps the splitters'
+  // arithmetic within the range of unsigned int.
+  const auto numberOfPixels = static_cast<unsigned int>(
+    std::min<SizeValueType>(pasteIORegion.GetNumberOfPixels(), std::numeric_limits<unsigned int>::max() / 2));
+  SizeValueType      estimatedSizeInBytes = 0;
+  const unsigned int numberOfStreamDivisions = PipelineMemoryPlanner::ComputeNumberOfDivisions(
+    m_MemoryBudget,
+    m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfPixels, pasteIORegion, largestIORegion),
+    estimateSizeInBytes,
+    estimatedSizeInBytes);
+  if (estimatedSizeInBytes > m_MemoryBudget)
+  {
+    itkWarningMacro("The upstream pipeline is estimated to allocate " << estimatedSizeInBytes
+                                                                      << " bytes per piece, over the memory budget of "
+                                                                      << m_MemoryBudget << " bytes.");
+  }
+  itkDebugMacro("Streaming in " << numberOfStreamDivisions << " pieces of an estimated " << estimatedSizeInBytes
+                                << " bytes.");
+  return numberOfStreamDivisions;
+}
+
 //---------------------------------------------------------
 template <typename TInputImage>
 void
@@ -346,7 +409,7 @@ ImageFileWriter<TInputImage>::GenerateData()
   // before this test, bad stuff would happened when they don't match
   if (bufferedRegion != ioRegion)
   {
-    if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion)
+    if (m_ImageIO->GetUseStreamedWriting())
     {
       itkDebugMacro("Requested stream region does not match generated output");
       itkDebugMacro("input filter may not support streaming well");
@@ -390,6 +453,7 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "PasteIORegion: " << m_PasteIORegion << std::endl;
   os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   itkPrintSelfBooleanMacro(UseCompression);
   itkPrintSelfBooleanMacro(UseInputMetaDataDictionary);
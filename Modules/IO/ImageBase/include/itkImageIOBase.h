@@ -440,6 +440,19 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine if the pixel data of the whole image is stored contiguously
+   * in a single file, uncompressed and in the native byte order, so that the
+   * pixel buffer may be memory mapped instead of read. If so, returns true
+   * and sets the name of the file and the byte offset of the first pixel.
+   * Default is false. This may only be queried after the header of the file
+   * has been read.
+   * \sa ImageFileReader::SetUseMemoryMapping */
+  virtual bool
+  GetPixelDataLocation(std::string & itkNotUsed(fileName), SizeType & itkNotUsed(offset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
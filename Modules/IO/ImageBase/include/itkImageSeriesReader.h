@@ -173,6 +173,18 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** Set/Get the maximum number of files that are read concurrently, on
+   * the threads of the ThreadPool. The files that follow the one being
+   * processed are prefetched directly into the output buffer, while the
+   * meta data of the files is still processed in order. Default is 1, which
+   * reads the files one after another on the calling thread.
+   *
+   * When an ImageIO is specified, each concurrent read uses its own
+   * instance of the ImageIO class, created by CreateAnother(). Settings of
+   * the specified ImageIO instance are then not used for reading. */
+  itkSetClampMacro(NumberOfConcurrentReads, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfConcurrentReads, unsigned int);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -215,6 +227,8 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  unsigned int m_NumberOfConcurrentReads{ 1 };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
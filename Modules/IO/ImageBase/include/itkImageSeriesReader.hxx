@@ -25,7 +25,10 @@
 #include "itkMath.h"
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include "itkThreadPool.h"
 #include <cstddef> // For ptrdiff_t.
+#include <deque>
+#include <future>
 #include <iomanip>
 
 namespace itk
@@ -55,6 +58,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "NumberOfConcurrentReads: " << m_NumberOfConcurrentReads << std::endl;
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -289,7 +293,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
   typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
   const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
@@ -297,23 +300,20 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  const auto getSliceStartIndex = [this, &requestedRegion](int i) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
+    return sliceStartIndex;
+  };
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
-
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
-    {
-      continue;
-    }
+  // Reads the pixels of the i-th slice into the output buffer, or only the information of the file when the slice is
+  // outside the requested region. Slices may be read concurrently, as each one is written to its own part of the
+  // output buffer.
+  const auto readSlice = [&](int i, bool insideRequestedRegion, ImageIOBase * imageIO) {
+    const int iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
 
     // configure reader
     auto reader = ReaderType::New();
@@ -321,9 +321,9 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
     TOutputImage * readerOutput = reader->GetOutput();
 
-    if (m_ImageIO)
+    if (imageIO)
     {
-      reader->SetImageIO(m_ImageIO);
+      reader->SetImageIO(imageIO);
     }
     reader->SetUseStreaming(m_UseStreaming);
     readerOutput->SetRequestedRegion(sliceRegionToRequest);
@@ -332,141 +332,205 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     if (!insideRequestedRegion)
     {
       reader->UpdateOutputInformation();
+      return reader;
     }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
 
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
+    // read the meta data information
+    readerOutput->UpdateOutputInformation();
 
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
+    // propagate the requested region to determine what the region
+    // will actually be read
+    readerOutput->PropagateRequestedRegion();
 
-      // get the size of the region to be read
-      const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+    // check that the size of each slice is the same
+    if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+    {
+      itkExceptionMacro("Size mismatch! The size of  "
+                        << m_FileNames[iFileName].c_str() << " is " << readerOutput->GetLargestPossibleRegion().GetSize()
+                        << " and does not match the required size " << validSize << " from file "
+                        << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+    }
 
-      if (readSize == sliceRegionToRequest.GetSize())
-      {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
+    // get the size of the region to be read
+    const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
 
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+    if (readSize == sliceRegionToRequest.GetSize())
+    {
+      // if the buffer of the ImageReader is going to match that of
+      // ourselves, then set the ImageReader's buffer to a section
+      // of ours
 
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
 
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
 
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
 
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
+      const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                      ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                      : 0;
 
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+      const ptrdiff_t numberOfPixelComponentsUpToSlice =
+        numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+      const bool bufferDelete = false;
 
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
+      typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+
+      if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+      {
+        // if the input image type is a vector image then the number
+        // of components needs to be set for the size
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer,
+          static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+          bufferDelete);
       }
       else
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
+        // otherwise the actual number of pixels needs to be passed
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+      }
+      readerOutput->UpdateOutputData();
+    }
+    else
+    {
+      // the read region isn't going to match exactly what we need
+      // to update to buffer created by the reader, then copy
 
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
+      reader->Update();
 
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
+      // output of buffer copy
+      ImageRegionType outRegion = requestedRegion;
+      outRegion.SetIndex(getSliceStartIndex(i));
 
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+      // set the moving dimension to a size of 1
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
       }
 
-      // verify that slice spacing is the expected one
-      // since we can be skipping some slices because they are outside of requested region
-      // I am using additional variable
-      if (prevSliceIsValid)
+      ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+    }
+    return reader;
+  };
+
+  // When files are read concurrently, the reads of the slices inside the requested region are queued ahead of the
+  // slice being processed, in order, up to the specified number of concurrent reads.
+  using ReaderFutureType = std::future<typename ReaderType::Pointer>;
+  std::deque<ReaderFutureType> pendingReads;
+  int                          nextSliceToQueue = 0;
+  ThreadPool * const           threadPool = m_NumberOfConcurrentReads > 1 ? ThreadPool::GetInstance() : nullptr;
+
+  try
+  {
+    for (int i = 0; i != numberOfFiles; ++i)
+    {
+      const bool insideRequestedRegion = requestedRegion.IsInside(getSliceStartIndex(i));
+      bool       nonUniformSampling = false;
+      double     spacingDeviation = 0.0;
+
+      // check if we need this slice
+      if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
-        using SpacingScalarType = typename TOutputImage::SpacingValueType;
-        Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
-        for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
-        {
-          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
-        }
-        const SpacingScalarType dirNnorm = dirN.GetNorm();
+        continue;
+      }
 
-        if (this->m_SpacingDefined &&
-            !Math::AlmostEquals(
-              dirNnorm,
-              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+      typename ReaderType::Pointer reader;
+      if (insideRequestedRegion && threadPool)
+      {
+        while (nextSliceToQueue < numberOfFiles && pendingReads.size() < m_NumberOfConcurrentReads)
         {
-          nonUniformSampling = true;
-          spacingDeviation = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
-          if (spacingDeviation > maxSpacingDeviation)
+          if (requestedRegion.IsInside(getSliceStartIndex(nextSliceToQueue)))
           {
-            maxSpacingDeviation = spacingDeviation;
+            // ImageIO instances cannot be shared between concurrent reads.
+            ImageIOBase::Pointer imageIO;
+            if (m_ImageIO)
+            {
+              imageIO = dynamic_cast<ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+            }
+            pendingReads.push_back(threadPool->AddWork(
+              [&readSlice, nextSliceToQueue, imageIO]() { return readSlice(nextSliceToQueue, true, imageIO); }));
           }
-
-          needToUpdateMetaDataDictionaryArray = true;
+          ++nextSliceToQueue;
         }
-        prevSliceOrigin = sliceOrigin;
+        ReaderFutureType pendingRead = std::move(pendingReads.front());
+        pendingReads.pop_front();
+        reader = pendingRead.get();
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
-        prevSliceIsValid = true;
+        reader = readSlice(i, insideRequestedRegion, m_ImageIO);
       }
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
+      if (insideRequestedRegion)
+      {
+        TOutputImage * readerOutput = reader->GetOutput();
 
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
-    {
-      auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      if (nonUniformSampling)
+        // verify that slice spacing is the expected one
+        // since we can be skipping some slices because they are outside of requested region
+        // I am using additional variable
+        if (prevSliceIsValid)
+        {
+          typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+          using SpacingScalarType = typename TOutputImage::SpacingValueType;
+          Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
+          for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
+          {
+            dirN[j] =
+              static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
+          }
+          const SpacingScalarType dirNnorm = dirN.GetNorm();
+
+          if (this->m_SpacingDefined &&
+              !Math::AlmostEquals(
+                dirNnorm,
+                outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+          {
+            nonUniformSampling = true;
+            spacingDeviation = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
+            if (spacingDeviation > maxSpacingDeviation)
+            {
+              maxSpacingDeviation = spacingDeviation;
+            }
+
+            needToUpdateMetaDataDictionaryArray = true;
+          }
+          prevSliceOrigin = sliceOrigin;
+        }
+        else
+        {
+          prevSliceOrigin = readerOutput->GetOrigin();
+          prevSliceIsValid = true;
+        }
+
+        // report progress for read slices
+        progress.CompletedPixel();
+      } // end insideRequestedRegion
+
+      // Deep copy the MetaDataDictionary into the array
+      if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
       {
-        // slice-specific information
-        EncapsulateMetaData<double>(*newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        auto newDictionary = new DictionaryType;
+        *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+        if (nonUniformSampling)
+        {
+          // slice-specific information
+          EncapsulateMetaData<double>(*newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        }
+        m_MetaDataDictionaryArray.push_back(newDictionary);
       }
-      m_MetaDataDictionaryArray.push_back(newDictionary);
+    } // end per slice loop
+  }
+  catch (...)
+  {
+    // The queued reads write into the output buffer, and refer to local variables.
+    for (const auto & pendingRead : pendingReads)
+    {
+      pendingRead.wait();
     }
-  } // end per slice loop
+    throw;
+  }
 
 
   if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage &&
@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFile
+ *
+ * \brief Maps a range of bytes of a file into memory.
+ *
+ * The mapping is private (copy-on-write): the mapped bytes are read from
+ * the file on demand and the pages are shared, through the page cache, with
+ * every other process that maps or reads the same file. Writing to the
+ * mapped memory is allowed, but only modifies a private copy of the
+ * touched pages, never the file itself.
+ *
+ * The mapping is released when the object is destroyed.
+ *
+ * \sa MemoryMappedImportImageContainer
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedFile
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Maps numberOfBytes bytes of the file, starting at the specified
+   * offset. Throws an ExceptionObject when the file cannot be opened, is too
+   * small, or cannot be mapped. */
+  MemoryMappedFile(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes);
+
+  ~MemoryMappedFile();
+
+  /** Returns the address of the byte at the offset passed to the constructor. */
+  void *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Returns the number of mapped bytes, as passed to the constructor. */
+  SizeValueType
+  GetNumberOfBytes() const
+  {
+    return m_NumberOfBytes;
+  }
+
+private:
+  // The mapping itself starts at a page boundary, at or before m_Data.
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+  void *        m_Data{ nullptr };
+  SizeValueType m_NumberOfBytes{ 0 };
+};
+} // end namespace itk
+
+#endif // itkMemoryMappedFile_h
@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImportImageContainer_h
+#define itkMemoryMappedImportImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+#include <memory>
+
+namespace itk
+{
+/** \class MemoryMappedImportImageContainer
+ *  \brief An ImportImageContainer whose elements are the bytes of a memory mapped file.
+ *
+ * The elements are not copied from the file: the pages of the file are
+ * loaded lazily when they are first accessed, and are shared with any other
+ * process that maps the same file. The mapping is copy-on-write, so the
+ * elements may be modified without modifying the file.
+ *
+ * The mapping is released when the container is destroyed, or when its
+ * memory is reallocated, for example by Reserve() or Initialize().
+ *
+ * \sa MemoryMappedFile
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ITKIOImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImportImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImportImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImportImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Save the template parameters. */
+  using typename Superclass::ElementIdentifier;
+  using typename Superclass::Element;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImportImageContainer);
+
+  /** Maps numberOfElements elements of the specified file, starting at the
+   * specified byte offset, and imports them into the container. The offset
+   * must be a multiple of the alignment of TElement. Throws an
+   * ExceptionObject when the file cannot be mapped. */
+  void
+  MapFile(const std::string & fileName, SizeValueType offset, ElementIdentifier numberOfElements)
+  {
+    if (offset % alignof(TElement) != 0)
+    {
+      itkExceptionMacro("The offset " << offset << " of the data in " << fileName
+                                      << " is not suitably aligned for the element type.");
+    }
+    auto mappedFile = std::make_unique<MemoryMappedFile>(fileName, offset, numberOfElements * sizeof(TElement));
+    this->Initialize();
+    this->Superclass::SetImportPointer(static_cast<TElement *>(mappedFile->GetData()), numberOfElements, false);
+    m_MappedFile = std::move(mappedFile);
+  }
+
+  /** Tells whether the elements of the container are currently mapped from a file. */
+  bool
+  IsMapped() const
+  {
+    return m_MappedFile != nullptr;
+  }
+
+protected:
+  MemoryMappedImportImageContainer() = default;
+  ~MemoryMappedImportImageContainer() override = default;
+
+  void
+  DeallocateManagedMemory() override
+  {
+    Superclass::DeallocateManagedMemory();
+    m_MappedFile.reset();
+  }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "Mapped: " << (this->IsMapped() ? "true" : "false") << std::endl;
+  }
+
+private:
+  std::unique_ptr<MemoryMappedFile> m_MappedFile{};
+};
+} // end namespace itk
+
+#endif
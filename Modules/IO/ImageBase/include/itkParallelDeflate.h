@@ -0,0 +1,59 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelDeflate_h
+#define itkParallelDeflate_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelDeflate
+ *
+ * \brief Compresses data with the deflate algorithm, by blocks compressed in parallel.
+ *
+ * The data is split into blocks of BlockSize bytes, which are compressed
+ * concurrently by a MultiThreaderBase, so with the global default number of
+ * threads. As done by pigz, each block is primed with the last 32 KiB of the
+ * block before it, and the compressed blocks are joined into a single zlib
+ * or gzip stream. The result is decompressed by any zlib inflater or gzip
+ * reader, and is barely larger than when the data is compressed serially.
+ *
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ParallelDeflate
+{
+public:
+  /** The number of bytes of data per block compressed in parallel. */
+  static constexpr SizeValueType BlockSize = SizeValueType{ 1 } << 20;
+
+  /** Compresses the data into a zlib stream (RFC 1950), as zlib's compress2()
+   * does. The compression level ranges from 0 to 9, or is -1 for the default
+   * level of zlib. Throws an ExceptionObject when the data cannot be compressed. */
+  static std::vector<char>
+  CompressToZlib(const void * data, SizeValueType numberOfBytes, int compressionLevel);
+
+  /** Compresses the data into a gzip member (RFC 1952), as gzip does. */
+  static std::vector<char>
+  CompressToGzip(const void * data, SizeValueType numberOfBytes, int compressionLevel);
+};
+} // end namespace itk
+
+#endif
@@ -13,8 +13,11 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
   ITKCommon
+  PRIVATE_DEPENDS
+  ITKZLIB
   TEST_DEPENDS
   ITKTestKernel
+  ITKZLIB
   ITKIOGDCM
   ITKIOMeta
   ITKImageIntensity
@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+#include "itksys/SystemTools.hxx"
+
+#if defined(_WIN32)
+#  include "itksys/Encoding.hxx"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::MemoryMappedFile(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes)
+  : m_NumberOfBytes(numberOfBytes)
+{
+  if (numberOfBytes == 0)
+  {
+    itkGenericExceptionMacro("Cannot map zero bytes of file " << fileName);
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeValueType granularity = systemInfo.dwAllocationGranularity;
+  const SizeValueType mappedOffset = offset - offset % granularity;
+  m_MappedLength = offset - mappedOffset + numberOfBytes;
+
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping.");
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeValueType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    itkGenericExceptionMacro("File " << fileName << " is smaller than the " << numberOfBytes
+                                     << " bytes to be mapped at offset " << offset);
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    itkGenericExceptionMacro("Cannot create a file mapping for " << fileName);
+  }
+  const auto mappedOffset64 = static_cast<unsigned long long>(mappedOffset);
+  m_MappedAddress = MapViewOfFile(mapping,
+                                  FILE_MAP_COPY,
+                                  static_cast<DWORD>(mappedOffset64 >> 32),
+                                  static_cast<DWORD>(mappedOffset64 & 0xFFFFFFFFu),
+                                  static_cast<SIZE_T>(m_MappedLength));
+  // The view keeps the mapping object alive.
+  CloseHandle(mapping);
+  if (m_MappedAddress == nullptr)
+  {
+    itkGenericExceptionMacro("Cannot map " << fileName << " into memory.");
+  }
+#else
+  const auto          pageSize = static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+  const SizeValueType mappedOffset = offset - offset % pageSize;
+  m_MappedLength = offset - mappedOffset + numberOfBytes;
+
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping: "
+                                            << itksys::SystemTools::GetLastSystemError());
+  }
+  struct stat fileStatus
+  {};
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeValueType>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    itkGenericExceptionMacro("File " << fileName << " is smaller than the " << numberOfBytes
+                                     << " bytes to be mapped at offset " << offset);
+  }
+  void * const address = mmap(
+    nullptr, static_cast<size_t>(m_MappedLength), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(mappedOffset));
+  // The mapping remains valid after the file descriptor is closed.
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkGenericExceptionMacro("Cannot map " << fileName << " into memory: " << itksys::SystemTools::GetLastSystemError());
+  }
+  m_MappedAddress = address;
+#endif
+
+  m_Data = static_cast<char *>(m_MappedAddress) + (offset - mappedOffset);
+}
+
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(_WIN32)
+  UnmapViewOfFile(m_MappedAddress);
+#else
+  munmap(m_MappedAddress, static_cast<size_t>(m_MappedLength));
+#endif
+}
+
+} // end namespace itk
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkParallelDeflate.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace itk
+{
+namespace
+{
+// The size of the window of deflate, by which a block may refer to the data before it.
+constexpr SizeValueType WindowSize = SizeValueType{ 1 } << 15;
+
+struct CompressedBlock
+{
+  std::vector<unsigned char> bytes;
+  uLong                      checksum{};
+};
+
+// Compresses one block of the data into raw deflate data, which is ended by
+// a sync flush (so that it ends on a byte boundary), unless it is the last
+// block, which ends the deflate stream.
+bool
+CompressBlock(const unsigned char * data,
+              SizeValueType         numberOfBytes,
+              SizeValueType         begin,
+              SizeValueType         end,
+              int                   compressionLevel,
+              CompressedBlock &     block)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  const SizeValueType dictionarySize = std::min(begin, WindowSize);
+  if (dictionarySize > 0 &&
+      deflateSetDictionary(&stream, data + begin - dictionarySize, static_cast<uInt>(dictionarySize)) != Z_OK)
+  {
+    deflateEnd(&stream);
+    return false;
+  }
+
+  const bool isLast = end == numberOfBytes;
+  const int  flush = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+  block.bytes.resize(deflateBound(&stream, static_cast<uLong>(end - begin)) + 16);
+  stream.next_in = const_cast<unsigned char *>(data + begin);
+  stream.avail_in = static_cast<uInt>(end - begin);
+  stream.next_out = block.bytes.data();
+  stream.avail_out = static_cast<uInt>(block.bytes.size());
+  for (;;)
+  {
+    const int result = deflate(&stream, flush);
+    if (result == Z_STREAM_ERROR || (result == Z_BUF_ERROR && stream.avail_out > 0))
+    {
+      deflateEnd(&stream);
+      return false;
+    }
+    if (isLast ? result == Z_STREAM_END : (stream.avail_in == 0 && stream.avail_out > 0))
+    {
+      break;
+    }
+    // Unlikely, as the output is as large as the bound of deflate.
+    const size_t used = block.bytes.size() - stream.avail_out;
+    block.bytes.resize(2 * block.bytes.size());
+    stream.next_out = block.bytes.data() + used;
+    stream.avail_out = static_cast<uInt>(block.bytes.size() - used);
+  }
+  block.bytes.resize(block.bytes.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return true;
+}
+
+// Compresses the data by blocks, in parallel, into a raw deflate stream that
+// is appended to the output. Returns the checksum of the data, either its
+// CRC-32 or its Adler-32 checksum.
+uLong
+Compress(const void *        data,
+         SizeValueType       numberOfBytes,
+         int                 compressionLevel,
+         bool                useCRC32,
+         std::vector<char> & output)
+{
+  const auto *        bytes = static_cast<const unsigned char *>(data);
+  const SizeValueType numberOfBlocks = std::max<SizeValueType>(
+    1, (numberOfBytes + ParallelDeflate::BlockSize - 1) / ParallelDeflate::BlockSize);
+  std::vector<CompressedBlock> blocks(numberOfBlocks);
+  std::atomic<bool>            failed{ false };
+
+  const auto compressBlock = [&](SizeValueType i) {
+    const SizeValueType begin = i * ParallelDeflate::BlockSize;
+    const SizeValueType end = std::min(begin + ParallelDeflate::BlockSize, numberOfBytes);
+    if (!CompressBlock(bytes, numberOfBytes, begin, end, compressionLevel, blocks[i]))
+    {
+      failed = true;
+      return;
+    }
+    const auto length = static_cast<uInt>(end - begin);
+    blocks[i].checksum = useCRC32 ? crc32(crc32(0, nullptr, 0), bytes + begin, length)
+                                  : adler32(adler32(0, nullptr, 0), bytes + begin, length);
+  };
+  if (numberOfBlocks == 1)
+  {
+    compressBlock(0);
+  }
+  else
+  {
+    MultiThreaderBase::New()->ParallelizeArray(0, numberOfBlocks, compressBlock, nullptr);
+  }
+  if (failed)
+  {
+    itkGenericExceptionMacro("Failed to compress " << numberOfBytes << " bytes with deflate.");
+  }
+
+  uLong         checksum = blocks[0].checksum;
+  SizeValueType compressedSize = output.size() + blocks[0].bytes.size();
+  for (SizeValueType i = 1; i < numberOfBlocks; ++i)
+  {
+    const auto length =
+      static_cast<z_off_t>(std::min(ParallelDeflate::BlockSize, numberOfBytes - i * ParallelDeflate::BlockSize));
+    checksum = useCRC32 ? crc32_combine(checksum, blocks[i].checksum, length)
+                        : adler32_combine(checksum, blocks[i].checksum, length);
+    compressedSize += blocks[i].bytes.size();
+  }
+  output.reserve(compressedSize + 8);
+  for (const CompressedBlock & block : blocks)
+  {
+    output.insert(output.end(), block.bytes.cbegin(), block.bytes.cend());
+  }
+  return checksum;
+}
+
+void
+AppendLittleEndian32(uLong value, std::vector<char> & output)
+{
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    output.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+} // namespace
+
+
+std::vector<char>
+ParallelDeflate::CompressToZlib(const void * data, SizeValueType numberOfBytes, int compressionLevel)
+{
+  // The header: deflate with a 32 KiB window, the compression level, and a check of the header.
+  const unsigned int level = compressionLevel < 0 ? 6 : static_cast<unsigned int>(compressionLevel);
+  const unsigned int levelFlag = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+  unsigned int       flags = levelFlag << 6;
+  flags += 31 - (0x78 * 256 + flags) % 31;
+  std::vector<char> output{ static_cast<char>(0x78), static_cast<char>(flags) };
+
+  const uLong adler = Compress(data, numberOfBytes, compressionLevel, false, output);
+  for (int i = 3; i >= 0; --i)
+  {
+    output.push_back(static_cast<char>((adler >> (8 * i)) & 0xFF));
+  }
+  return output;
+}
+
+
+std::vector<char>
+ParallelDeflate::CompressToGzip(const void * data, SizeValueType numberOfBytes, int compressionLevel)
+{
+  // The header: deflate, no flags, no modification time, the extra flags of
+  // the compression level, and an unknown operating system.
+  const char extraFlags = compressionLevel == 9 ? 2 : compressionLevel == 1 ? 4 : 0;
+  std::vector<char> output{ static_cast<char>(0x1f), static_cast<char>(0x8b), 8, 0, 0, 0, 0, 0, extraFlags,
+                            static_cast<char>(0xff) };
+
+  const uLong crc = Compress(data, numberOfBytes, compressionLevel, true, output);
+  AppendLittleEndian32(crc, output);
+  AppendLittleEndian32(static_cast<uLong>(numberOfBytes & 0xFFFFFFFFu), output);
+  return output;
+}
+
+} // end namespace itk
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMemoryMappedImportImageContainer.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMappingTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  MakeImage()
+  {
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::SizeType{ { 5, 4, 3 } });
+    image->Allocate();
+    typename TImage::PixelType * const buffer = image->GetBufferPointer();
+    for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      buffer[i] = static_cast<typename TImage::PixelType>(i);
+    }
+    return image;
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  Read(const std::string & fileName, bool useMemoryMapping)
+  {
+    const auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->SetUseMemoryMapping(useMemoryMapping);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  template <typename TImage>
+  static bool
+  IsMemoryMapped(const TImage & image)
+  {
+    using MappedContainerType = itk::MemoryMappedImportImageContainer<itk::SizeValueType, typename TImage::PixelType>;
+    const auto * const container = dynamic_cast<const MappedContainerType *>(image.GetPixelContainer());
+    return container != nullptr && container->IsMapped();
+  }
+
+  template <typename TImage>
+  static void
+  ExpectEqualPixels(const TImage & expected, const TImage & actual)
+  {
+    ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+    itk::ImageRegionConstIterator<TImage> expectedIt(&expected, expected.GetBufferedRegion());
+    itk::ImageRegionConstIterator<TImage> actualIt(&actual, actual.GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, UseMemoryMappingIsOffByDefault)
+{
+  using ImageType = itk::Image<float, 3>;
+  const std::string fileName = "ITKImageFileReaderMemoryMappingTest_Default.mhd";
+  itk::WriteImage(MakeImage<ImageType>(), fileName);
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  EXPECT_FALSE(reader->GetUseMemoryMapping());
+  reader->SetFileName(fileName);
+  reader->Update();
+  EXPECT_FALSE(IsMemoryMapped(*reader->GetOutput()));
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, DetachedMetaImage)
+{
+  using ImageType = itk::Image<float, 3>;
+  const std::string fileName = "ITKImageFileReaderMemoryMappingTest_Detached.mhd";
+  const auto        image = MakeImage<ImageType>();
+  itk::WriteImage(image, fileName);
+
+  const auto mappedImage = Read<ImageType>(fileName, true);
+  EXPECT_TRUE(IsMemoryMapped(*mappedImage));
+  ExpectEqualPixels(*image, *mappedImage);
+
+  // The mapping is copy-on-write: modifying the image does not modify the file.
+  mappedImage->FillBuffer(-1.0f);
+  ExpectEqualPixels(*image, *Read<ImageType>(fileName, false));
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, LocalMetaImage)
+{
+  // A single byte pixel type, so that the pixel data is suitably aligned, whatever the size of the header.
+  using ImageType = itk::Image<unsigned char, 3>;
+  const std::string fileName = "ITKImageFileReaderMemoryMappingTest_Local.mha";
+  const auto        image = MakeImage<ImageType>();
+  itk::WriteImage(image, fileName);
+
+  const auto mappedImage = Read<ImageType>(fileName, true);
+  EXPECT_TRUE(IsMemoryMapped(*mappedImage));
+  ExpectEqualPixels(*image, *mappedImage);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, CompressedMetaImageIsRead)
+{
+  using ImageType = itk::Image<short, 3>;
+  const std::string fileName = "ITKImageFileReaderMemoryMappingTest_Compressed.mha";
+  const auto        image = MakeImage<ImageType>();
+  itk::WriteImage(image, fileName, true);
+
+  const auto readImage = Read<ImageType>(fileName, true);
+  EXPECT_FALSE(IsMemoryMapped(*readImage));
+  ExpectEqualPixels(*image, *readImage);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, PixelTypeConversionIsRead)
+{
+  const std::string fileName = "ITKImageFileReaderMemoryMappingTest_Conversion.mhd";
+  itk::WriteImage(MakeImage<itk::Image<float, 3>>(), fileName);
+
+  using ImageType = itk::Image<double, 3>;
+  const auto readImage = Read<ImageType>(fileName, true);
+  EXPECT_FALSE(IsMemoryMapped(*readImage));
+  EXPECT_EQ(readImage->GetPixel({ { 1, 1, 1 } }), 26.0);
+}
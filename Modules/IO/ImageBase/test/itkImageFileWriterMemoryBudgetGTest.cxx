@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileWriter.h"
+#include "itkImageFileReader.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileWriterMemoryBudgetTest : public ::testing::Test
+{
+  using ImageType = itk::Image<float, 3>;
+  using MonitorType = itk::PipelineMonitorImageFilter<ImageType>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  using WriterType = itk::ImageFileWriter<ImageType>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    // 800 bytes per slice.
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::SizeType{ { 20, 10, 8 } });
+    m_Image->Allocate();
+    float * const buffer = m_Image->GetBufferPointer();
+    for (itk::SizeValueType i = 0; i < m_Image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      buffer[i] = static_cast<float>(i);
+    }
+    const std::string inputFileName = "ITKImageFileWriterMemoryBudgetTest_Input.mha";
+    itk::WriteImage(m_Image, inputFileName);
+
+    // A pipeline that streams, from a reader.
+    m_Reader = ReaderType::New();
+    m_Reader->SetFileName(inputFileName);
+    m_Monitor = MonitorType::New();
+    m_Monitor->SetInput(m_Reader->GetOutput());
+  }
+
+  void
+  ExpectEqualToFile(const std::string & fileName) const
+  {
+    const auto                               readImage = itk::ReadImage<ImageType>(fileName);
+    itk::ImageRegionConstIterator<ImageType> expectedIt(m_Image, m_Image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> actualIt(readImage, readImage->GetBufferedRegion());
+    ASSERT_EQ(m_Image->GetBufferedRegion(), readImage->GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      ASSERT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+
+  ImageType::Pointer   m_Image;
+  ReaderType::Pointer  m_Reader;
+  MonitorType::Pointer m_Monitor;
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileWriterMemoryBudgetTest, NoMemoryBudget)
+{
+  const std::string fileName = "ITKImageFileWriterMemoryBudgetTest_None.mha";
+  const auto        writer = WriterType::New();
+  EXPECT_EQ(writer->GetMemoryBudget(), 0u);
+  writer->SetInput(m_Monitor->GetOutput());
+  writer->SetFileName(fileName);
+  writer->Update();
+  EXPECT_EQ(m_Monitor->GetNumberOfUpdates(), 1u);
+  ExpectEqualToFile(fileName);
+}
+
+
+TEST_F(ITKImageFileWriterMemoryBudgetTest, StreamsWithinMemoryBudget)
+{
+  const std::string fileName = "ITKImageFileWriterMemoryBudgetTest_Streamed.mha";
+  const auto        writer = WriterType::New();
+  writer->SetInput(m_Monitor->GetOutput());
+  writer->SetFileName(fileName);
+  writer->SetNumberOfStreamDivisions(2);
+  writer->SetMemoryBudget(5000);
+  writer->Update();
+
+  // Three slices per piece, read by the reader and passed by the monitor.
+  EXPECT_EQ(m_Monitor->GetNumberOfUpdates(), 3u);
+  for (const auto & region : m_Monitor->GetUpdatedRequestedRegions())
+  {
+    EXPECT_LE(2 * region.GetNumberOfPixels() * sizeof(float), 5000u);
+  }
+  ExpectEqualToFile(fileName);
+}
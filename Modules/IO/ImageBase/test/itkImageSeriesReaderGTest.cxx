@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaImageIO.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageSeriesReaderTest : public ::testing::Test
+{
+  using SliceType = itk::Image<short, 2>;
+  using ImageType = itk::Image<short, 3>;
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+  static constexpr unsigned int NumberOfSlices = 12;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    // Write a series of slices, each filled with its own slice number.
+    for (unsigned int i = 0; i < NumberOfSlices; ++i)
+    {
+      auto slice = SliceType::New();
+      slice->SetRegions(SliceType::SizeType{ { 7, 5 } });
+      slice->Allocate();
+      for (short y = 0; y < 5; ++y)
+      {
+        for (short x = 0; x < 7; ++x)
+        {
+          slice->SetPixel({ { x, y } }, static_cast<short>(100 * i + 10 * y + x));
+        }
+      }
+      const std::string fileName = "ITKImageSeriesReaderTest_" + std::to_string(i) + ".mha";
+      itk::WriteImage(slice, fileName);
+      m_FileNames.push_back(fileName);
+    }
+  }
+
+  static void
+  ExpectEqualImages(const ImageType & expected, const ImageType & actual)
+  {
+    ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+    EXPECT_EQ(expected.GetSpacing(), actual.GetSpacing());
+    itk::ImageRegionConstIterator<ImageType> expectedIt(&expected, expected.GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> actualIt(&actual, actual.GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+
+  ReaderType::FileNamesContainer m_FileNames;
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderTest, NumberOfConcurrentReads)
+{
+  const auto reader = ReaderType::New();
+  EXPECT_EQ(reader->GetNumberOfConcurrentReads(), 1u);
+  reader->SetNumberOfConcurrentReads(0);
+  EXPECT_EQ(reader->GetNumberOfConcurrentReads(), 1u);
+  reader->SetNumberOfConcurrentReads(4);
+  EXPECT_EQ(reader->GetNumberOfConcurrentReads(), 4u);
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, ConcurrentReadsMatchSequentialRead)
+{
+  const auto sequentialReader = ReaderType::New();
+  sequentialReader->SetFileNames(m_FileNames);
+  sequentialReader->Update();
+  const ImageType & expected = *sequentialReader->GetOutput();
+  EXPECT_EQ(expected.GetPixel({ { 3, 2, 7 } }), 723);
+
+  for (const unsigned int numberOfConcurrentReads : { 2u, 5u, NumberOfSlices + 3 })
+  {
+    for (const bool useImageIO : { false, true })
+    {
+      const auto reader = ReaderType::New();
+      reader->SetFileNames(m_FileNames);
+      reader->SetNumberOfConcurrentReads(numberOfConcurrentReads);
+      if (useImageIO)
+      {
+        reader->SetImageIO(itk::MetaImageIO::New());
+      }
+      reader->Update();
+      ExpectEqualImages(expected, *reader->GetOutput());
+      EXPECT_EQ(reader->GetMetaDataDictionaryArray()->size(), static_cast<size_t>(NumberOfSlices));
+    }
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, ConcurrentReadsOfRequestedRegion)
+{
+  const auto reader = ReaderType::New();
+  reader->SetFileNames(m_FileNames);
+  reader->SetReverseOrder(true);
+  reader->SetNumberOfConcurrentReads(3);
+  reader->UpdateOutputInformation();
+
+  const ImageType::RegionType requestedRegion({ { 0, 0, 4 } }, { { 7, 5, 5 } });
+  reader->GetOutput()->SetRequestedRegion(requestedRegion);
+  reader->Update();
+
+  const ImageType & output = *reader->GetOutput();
+  ASSERT_TRUE(output.GetBufferedRegion().IsInside(requestedRegion));
+  for (itk::IndexValueType z = 4; z < 9; ++z)
+  {
+    EXPECT_EQ(output.GetPixel({ { 6, 4, z } }), 100 * (NumberOfSlices - 1 - z) + 46);
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, ConcurrentReadsOfMissingFileThrow)
+{
+  m_FileNames[NumberOfSlices / 2] = "ITKImageSeriesReaderTest_Missing.mha";
+
+  const auto reader = ReaderType::New();
+  reader->SetFileNames(m_FileNames);
+  reader->SetNumberOfConcurrentReads(4);
+  EXPECT_THROW(reader->Update(), itk::ExceptionObject);
+}
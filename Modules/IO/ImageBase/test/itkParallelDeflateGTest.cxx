@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkParallelDeflate.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itk_zlib.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+#include <fstream>
+#include <iterator>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+// Data that spans several blocks, and compresses, but not trivially.
+std::vector<unsigned char>
+MakeData(itk::SizeValueType numberOfBytes)
+{
+  std::vector<unsigned char> data(numberOfBytes);
+  unsigned int               state = 12345;
+  for (itk::SizeValueType i = 0; i < numberOfBytes; ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    data[i] = static_cast<unsigned char>((i / 64) % 7 + ((state >> 16) & 0x3));
+  }
+  return data;
+}
+
+// Inflates a zlib stream or a gzip member, checking its checksum.
+std::vector<unsigned char>
+Inflate(const std::vector<char> & compressed, itk::SizeValueType numberOfBytes)
+{
+  std::vector<unsigned char> data(numberOfBytes + 1);
+  z_stream                   stream{};
+  EXPECT_EQ(inflateInit2(&stream, 47), Z_OK);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  stream.next_out = data.data();
+  stream.avail_out = static_cast<uInt>(data.size());
+  EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+  EXPECT_EQ(stream.avail_in, 0u);
+  data.resize(data.size() - stream.avail_out);
+  inflateEnd(&stream);
+  return data;
+}
+
+struct ITKParallelDeflateTest : public ::testing::Test
+{
+  using ImageType = itk::Image<unsigned short, 3>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    // More than one block of data.
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 128, 96, 70 } });
+    image->Allocate();
+    const std::vector<unsigned char> data = MakeData(image->GetBufferedRegion().GetNumberOfPixels());
+    std::copy(data.cbegin(), data.cend(), image->GetBufferPointer());
+    return image;
+  }
+
+  static void
+  ExpectEqualPixels(const ImageType & expected, const ImageType & actual)
+  {
+    ASSERT_EQ(expected.GetBufferedRegion(), actual.GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> expectedIt(&expected, expected.GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> actualIt(&actual, actual.GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      ASSERT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKParallelDeflateTest, Zlib)
+{
+  for (const itk::SizeValueType numberOfBytes :
+       { itk::SizeValueType{ 0 }, itk::SizeValueType{ 1000 }, 3 * itk::ParallelDeflate::BlockSize + 12345 })
+  {
+    const std::vector<unsigned char> data = MakeData(numberOfBytes);
+    for (const int compressionLevel : { -1, 1, 9 })
+    {
+      const std::vector<char> compressed =
+        itk::ParallelDeflate::CompressToZlib(data.data(), numberOfBytes, compressionLevel);
+      ASSERT_GE(compressed.size(), 6u);
+      EXPECT_EQ(static_cast<unsigned char>(compressed[0]), 0x78);
+      EXPECT_EQ((static_cast<unsigned char>(compressed[0]) * 256 + static_cast<unsigned char>(compressed[1])) % 31, 0);
+      EXPECT_EQ(Inflate(compressed, numberOfBytes), data);
+    }
+  }
+}
+
+
+TEST_F(ITKParallelDeflateTest, Gzip)
+{
+  for (const itk::SizeValueType numberOfBytes :
+       { itk::SizeValueType{ 0 }, itk::SizeValueType{ 1000 }, 3 * itk::ParallelDeflate::BlockSize + 12345 })
+  {
+    const std::vector<unsigned char> data = MakeData(numberOfBytes);
+    const std::vector<char>          compressed = itk::ParallelDeflate::CompressToGzip(data.data(), numberOfBytes, 6);
+    ASSERT_GE(compressed.size(), 18u);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[1]), 0x8b);
+    EXPECT_EQ(Inflate(compressed, numberOfBytes), data);
+  }
+}
+
+
+TEST_F(ITKParallelDeflateTest, CompressedWritersRoundTrip)
+{
+  const auto image = MakeImage();
+  for (const char * const fileName : { "ITKParallelDeflateTest.mha",
+                                       "ITKParallelDeflateTest.mhd",
+                                       "ITKParallelDeflateTest.nii.gz",
+                                       "ITKParallelDeflateTest.nrrd",
+                                       "ITKParallelDeflateTest.nhdr" })
+  {
+    SCOPED_TRACE(fileName);
+    itk::WriteImage(image, fileName, true);
+    ExpectEqualPixels(*image, *itk::ReadImage<ImageType>(fileName));
+  }
+
+  // The data of the .nii.gz file follows its header as a second gzip member.
+  std::ifstream           file("ITKParallelDeflateTest.nii.gz", std::ios::in | std::ios::binary);
+  const std::vector<char> contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+  const std::vector<char> data = itk::ParallelDeflate::CompressToGzip(
+    image->GetBufferPointer(), image->GetBufferedRegion().GetNumberOfPixels() * sizeof(unsigned short), -1);
+  ASSERT_GT(contents.size(), data.size());
+  EXPECT_TRUE(std::equal(data.cbegin(), data.cend(), contents.cend() - data.size()));
+}
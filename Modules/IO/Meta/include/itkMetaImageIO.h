@@ -82,6 +82,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixel data can be memory mapped when it is binary, uncompressed, in
+   * the native byte order, and stored in a single file (either LOCAL, or a
+   * single ElementDataFile). */
+  bool
+  GetPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -134,20 +140,22 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Only time cannot stream read/write is if compression is used,
+   *  unless the compressed data is chunked (see UseChunkedCompression).
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
     if (m_MetaImage.CompressedData())
     {
-      return false;
+      return this->IsReadingChunkedCompressedData();
     }
     return true;
   }
 
   /** Determine if the ImageIO can stream writing to this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Only time cannot stream read/write is if compression is used,
+   *  unless the compressed data is chunked (see UseChunkedCompression).
    *  Assumes file passes a CanRead call and its pixels are of the same
    *  type as the template of the writer. Can verify by first calling
    *  CanRead and then CanStreamRead prior to calling CanStreamWrite. */
@@ -156,11 +164,28 @@ public:
   {
     if (this->GetUseCompression())
     {
-      return false;
+      return this->IsWritingChunkedCompressedData();
     }
     return true;
   }
 
+  /** Set/Get whether compressed data is written in chunks: each slice
+   *  along the last dimension is compressed independently, into its own
+   *  data file, named after the header file and the slice number. The
+   *  header refers to the data files by a numbered ElementDataFile
+   *  pattern, as defined by the MetaImage format, so that such files remain
+   *  readable by any MetaImage reader.
+   *
+   *  Chunked compressed data can be written and read region by region
+   *  (streamed), as long as each region consists of whole slices when
+   *  writing. Reading a region only decompresses the slices it touches.
+   *
+   *  Only used when compression is enabled, the data is binary, and the
+   *  header file has the ".mhd" extension. Default is false. */
+  itkSetMacro(UseChunkedCompression, bool);
+  itkGetConstMacro(UseChunkedCompression, bool);
+  itkBooleanMacro(UseChunkedCompression);
+
   /** Determining the subsampling factor in case
    *  we want a coarse version of the image/
    * \warning this is only used when streaming is on. */
@@ -197,10 +222,52 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
-  MetaImage m_MetaImage{};
+  /** Whether the data of the file is compressed slice by slice, in numbered data files. */
+  bool
+  IsReadingChunkedCompressedData() const;
+
+  /** Whether the data is to be written compressed slice by slice, in numbered data files. */
+  bool
+  IsWritingChunkedCompressedData() const;
+
+  /** Reads the slices of the chunked compressed data that intersect the IO region. */
+  void
+  ReadChunkedCompressedData(void * buffer);
+
+  /** Writes the header, and the slices of the IO region as chunked compressed data. */
+  void
+  WriteChunkedCompressedData(const void * buffer);
+
+  /** Writes the compressed data itself, compressed by blocks in parallel,
+   *  rather than letting MetaIO compress it serially. Returns false when
+   *  MetaIO is to write the data, as for a user specified data file name. */
+  bool
+  WriteParallelCompressedData(const void * buffer);
+
+  /** A MetaImage whose header may be written for binary data that is
+   *  compressed by MetaImageIO, rather than by MetaIO. */
+  class CompressibleMetaImage : public MetaImage
+  {
+  public:
+    /** Writes only the header, to the header file, for data of the specified
+     *  compressed size in the specified data file ("LOCAL" for the header file). */
+    bool
+    WriteHeaderOfCompressedData(const char * headerFileName, const char * dataFileName, std::streamoff compressedSize);
+
+  protected:
+    void
+    M_SetupWriteFields() override;
+
+  private:
+    std::streamoff m_SeparatelyCompressedDataSize{};
+  };
+
+  CompressibleMetaImage m_MetaImage{};
 
   unsigned int m_SubSamplingFactor{};
 
+  bool m_UseChunkedCompression{ false };
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
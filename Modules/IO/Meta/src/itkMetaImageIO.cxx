@@ -23,7 +23,17 @@
 #include "itkMath.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
+#include "itkParallelDeflate.h"
 #include "metaImageUtils.h"
+#include "metaUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <vector>
 
 // Function to join strings with a delimiter similar to python's ' '.join([1, 2, 3 ])
 template <typename ContainerType, typename DelimiterType, typename StreamType>
@@ -40,6 +50,123 @@ _join(const ContainerType & elements, const DelimiterType & delimiter, StreamTyp
   }
 }
 
+namespace
+{
+// The numbered data files of a MetaImage whose ElementDataFile is a pattern
+// of the form "<prefix>%[0][width]d<suffix> [first [last step]]", one file
+// per slice along the last dimension.
+struct DataFilePattern
+{
+  std::string  prefix;
+  std::string  suffix;
+  unsigned int width{ 0 };
+  bool         zeroPadded{ false };
+  long         first{ 1 };
+  long         step{ 1 };
+
+  std::string
+  GetFileName(itk::SizeValueType slice) const
+  {
+    // The number is formatted here, rather than by printf, because the
+    // pattern is read from the file.
+    std::string number = std::to_string(first + static_cast<long>(slice) * step);
+    if (number.size() < width)
+    {
+      number.insert(0, width - number.size(), zeroPadded ? '0' : ' ');
+    }
+    return prefix + number + suffix;
+  }
+};
+
+bool
+ParseDataFileNumber(const std::string & word, long & number)
+{
+  if (word.empty() || word.size() > 9 || word.find_first_not_of("0123456789") != std::string::npos)
+  {
+    return false;
+  }
+  number = std::stol(word);
+  return true;
+}
+
+// Parses the pattern of numbered data files, as MetaIO does, but only
+// accepts the patterns that MetaIO reads consistently: a file name alone,
+// with a first number, or with first and last numbers and a step.
+bool
+ParseDataFilePattern(const std::string & elementDataFile, itk::SizeValueType numberOfSlices, DataFilePattern & pattern)
+{
+  std::istringstream             stream(elementDataFile);
+  const std::vector<std::string> words{ std::istream_iterator<std::string>(stream),
+                                        std::istream_iterator<std::string>() };
+  std::string                    fileName;
+  long                           last = 0;
+  if (words.size() == 1)
+  {
+    fileName = words[0];
+    pattern.first = 1;
+    pattern.step = 1;
+    last = static_cast<long>(numberOfSlices);
+  }
+  else if (words.size() == 2)
+  {
+    fileName = words[0];
+    if (!ParseDataFileNumber(words[1], pattern.first))
+    {
+      return false;
+    }
+    pattern.step = 1;
+    last = pattern.first + static_cast<long>(numberOfSlices) - 1;
+  }
+  else if (words.size() >= 4)
+  {
+    // A file name with spaces is split into several words.
+    fileName = words[0];
+    for (size_t i = 1; i < words.size() - 3; ++i)
+    {
+      fileName += ' ' + words[i];
+    }
+    if (!ParseDataFileNumber(words[words.size() - 3], pattern.first) ||
+        !ParseDataFileNumber(words[words.size() - 2], last) ||
+        !ParseDataFileNumber(words[words.size() - 1], pattern.step) || pattern.step == 0)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  const std::string::size_type percent = fileName.find('%');
+  if (percent == std::string::npos || fileName.find('%', percent + 1) != std::string::npos)
+  {
+    return false;
+  }
+  std::string::size_type conversion = percent + 1;
+  pattern.zeroPadded = conversion < fileName.size() && fileName[conversion] == '0';
+  if (pattern.zeroPadded)
+  {
+    ++conversion;
+  }
+  pattern.width = 0;
+  while (conversion < fileName.size() && std::isdigit(static_cast<unsigned char>(fileName[conversion])) &&
+         pattern.width < 100)
+  {
+    pattern.width = 10 * pattern.width + static_cast<unsigned int>(fileName[conversion] - '0');
+    ++conversion;
+  }
+  if (conversion >= fileName.size() || fileName[conversion] != 'd')
+  {
+    return false;
+  }
+  pattern.prefix = fileName.substr(0, percent);
+  pattern.suffix = fileName.substr(conversion + 1);
+
+  // There must be a file for each slice.
+  return numberOfSlices > 0 && pattern.first + static_cast<long>(numberOfSlices - 1) * pattern.step <= last;
+}
+} // namespace
+
 namespace itk
 {
 // Explicitly set std::numeric_limits<double>::max_digits10 this will provide
@@ -83,6 +210,7 @@ MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << '\n';
+  itkPrintSelfBooleanMacro(UseChunkedCompression);
 }
 
 void
@@ -471,7 +599,15 @@ MetaImageIO::Read(void * buffer)
     largestRegion.SetSize(i, this->GetDimensions(i));
   }
 
-  if (largestRegion != m_IORegion)
+  if (largestRegion != m_IORegion && this->IsReadingChunkedCompressedData())
+  {
+    this->ReadChunkedCompressedData(buffer);
+
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(m_IORegion.GetNumberOfPixels());
+    m_MetaImage.ElementData(nullptr, false);
+  }
+  else if (largestRegion != m_IORegion)
   {
     const auto indexMin = make_unique_for_overwrite<int[]>(nDims);
     const auto indexMax = make_unique_for_overwrite<int[]>(nDims);
@@ -511,6 +647,65 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() ||
+      (this->GetComponentSize() > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()))
+  {
+    return false;
+  }
+
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  const bool        isLocal = elementDataFileName == "LOCAL" || elementDataFileName == "Local" ||
+                       elementDataFileName == "local";
+  if (isLocal)
+  {
+    fileName = m_FileName;
+  }
+  else if (elementDataFileName.compare(0, 4, "LIST") != 0 && elementDataFileName.find('%') == std::string::npos)
+  {
+    fileName = itksys::SystemTools::CollapseFullPath(elementDataFileName,
+                                                     itksys::SystemTools::GetFilenamePath(m_FileName));
+  }
+  else
+  {
+    return false;
+  }
+
+  const int headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0 || (headerSize == 0 && !isLocal))
+  {
+    offset = static_cast<SizeType>(headerSize);
+    return true;
+  }
+  if (headerSize == -1)
+  {
+    // The pixel data is at the end of the file.
+    const auto fileSize = static_cast<SizeType>(itksys::SystemTools::FileLength(fileName));
+    if (fileSize < this->GetImageSizeInBytes())
+    {
+      return false;
+    }
+    offset = fileSize - this->GetImageSizeInBytes();
+    return true;
+  }
+
+  // The local pixel data directly follows the line of the ElementDataFile field, which ends the header.
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  std::string   line;
+  while (std::getline(file, line))
+  {
+    const auto first = line.find_first_not_of(" \t");
+    if (first != std::string::npos && line.compare(first, 15, "ElementDataFile") == 0)
+    {
+      offset = static_cast<SizeType>(file.tellg());
+      return file.good();
+    }
+  }
+  return false;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -870,7 +1065,11 @@ MetaImageIO::Write(const void * buffer)
     largestRegion.SetSize(ii, this->GetDimensions(ii));
   }
 
-  if (m_UseCompression && (largestRegion != m_IORegion))
+  if (this->IsWritingChunkedCompressedData())
+  {
+    this->WriteChunkedCompressedData(buffer);
+  }
+  else if (m_UseCompression && (largestRegion != m_IORegion))
   {
     std::cout << "Compression in use: cannot stream the file writing" << std::endl;
   }
@@ -893,6 +1092,10 @@ MetaImageIO::Write(const void * buffer)
                                                        << "Reason: " << itksys::SystemTools::GetLastSystemError());
     }
   }
+  else if (this->WriteParallelCompressedData(buffer))
+  {
+    // the data was compressed by blocks, in parallel
+  }
   else
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
@@ -937,7 +1140,21 @@ MetaImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfReq
                                                const ImageIORegion & pasteRegion,
                                                const ImageIORegion & largestPossibleRegion)
 {
-  if (this->GetUseCompression())
+  if (this->IsWritingChunkedCompressedData())
+  {
+    // chunked compressed data can only be pasted by whole slices
+    const unsigned int sliceDimension = this->GetNumberOfDimensions() - 1;
+    for (unsigned int i = 0; i < sliceDimension; ++i)
+    {
+      if (pasteRegion.GetIndex(i) != largestPossibleRegion.GetIndex(i) ||
+          pasteRegion.GetSize(i) != largestPossibleRegion.GetSize(i))
+      {
+        itkExceptionMacro("Pasting and chunked compression is only supported for whole slices! Can't write:"
+                          << this->GetFileName());
+      }
+    }
+  }
+  else if (this->GetUseCompression())
   {
     // we can not stream or paste with compression
     if (pasteRegion != largestPossibleRegion)
@@ -986,8 +1203,9 @@ MetaImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfReq
     {
       // 0) Can't read file
     }
-    // 1)file is not compressed
-    else if (headerImageIOReader->m_MetaImage.CompressedData())
+    // 1)file is not compressed, unless chunked
+    else if (headerImageIOReader->m_MetaImage.CompressedData() &&
+             !(this->IsWritingChunkedCompressedData() && headerImageIOReader->IsReadingChunkedCompressedData()))
     {
       errorMessage = "File is compressed: " + m_FileName;
     }
@@ -1052,6 +1270,12 @@ MetaImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfReq
     }
   }
 
+  if (this->IsWritingChunkedCompressedData() &&
+      pasteRegion.GetSize(this->GetNumberOfDimensions() - 1) == 1)
+  {
+    // a single slice can not be split into whole slices
+    return 1;
+  }
   return GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
 }
 
@@ -1064,6 +1288,236 @@ MetaImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
   return GetSplitRegionForWritingCanStreamWrite(ithPiece, numberOfActualSplits, pasteRegion);
 }
 
+bool
+MetaImageIO::IsReadingChunkedCompressedData() const
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  DataFilePattern    pattern;
+  return m_MetaImage.CompressedData() && m_MetaImage.BinaryData() && numberOfDimensions > 1 &&
+         ParseDataFilePattern(
+           m_MetaImage.ElementDataFileName(), this->GetDimensions(numberOfDimensions - 1), pattern);
+}
+
+bool
+MetaImageIO::IsWritingChunkedCompressedData() const
+{
+  return m_UseChunkedCompression && m_UseCompression && this->GetFileType() != IOFileEnum::ASCII &&
+         this->GetNumberOfDimensions() > 1 &&
+         itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(m_FileName)) == ".mhd";
+}
+
+void
+MetaImageIO::ReadChunkedCompressedData(void * buffer)
+{
+  const unsigned int sliceDimension = this->GetNumberOfDimensions() - 1;
+  DataFilePattern    pattern;
+  ParseDataFilePattern(m_MetaImage.ElementDataFileName(), this->GetDimensions(sliceDimension), pattern);
+
+  // the region in the dimensions of the file, which may be more than those of the IO region
+  std::vector<SizeValueType> regionIndex(sliceDimension + 1, 0);
+  std::vector<SizeValueType> regionSize(sliceDimension + 1, 1);
+  for (unsigned int i = 0; i <= sliceDimension && i < m_IORegion.GetImageDimension(); ++i)
+  {
+    regionIndex[i] = static_cast<SizeValueType>(m_IORegion.GetIndex(i));
+    regionSize[i] = m_IORegion.GetSize(i);
+  }
+
+  const SizeValueType pixelSize = this->GetPixelSize();
+  SizeValueType       sliceSize = pixelSize;
+  SizeValueType       rowsPerSlice = 1;
+  for (unsigned int i = 0; i < sliceDimension; ++i)
+  {
+    sliceSize *= this->GetDimensions(i);
+    if (i > 0)
+    {
+      rowsPerSlice *= regionSize[i];
+    }
+  }
+  const SizeValueType rowSize = regionSize[0] * pixelSize;
+
+  const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+  const auto        slice = make_unique_for_overwrite<unsigned char[]>(sliceSize);
+  auto *            out = static_cast<unsigned char *>(buffer);
+  for (SizeValueType z = regionIndex[sliceDimension]; z < regionIndex[sliceDimension] + regionSize[sliceDimension]; ++z)
+  {
+    std::string fileName = pattern.GetFileName(z);
+    if (!path.empty() && !itksys::SystemTools::FileIsFullPath(fileName))
+    {
+      fileName = path + '/' + fileName;
+    }
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    const std::string compressed{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    if (!file.is_open() || compressed.empty() ||
+        !MET_PerformUncompression(reinterpret_cast<const unsigned char *>(compressed.data()),
+                                  static_cast<std::streamoff>(compressed.size()),
+                                  slice.get(),
+                                  static_cast<std::streamoff>(sliceSize)))
+    {
+      itkExceptionMacro("File cannot be read: " << fileName << " for reading." << std::endl
+                                                << "Reason: " << itksys::SystemTools::GetLastSystemError());
+    }
+
+    // copy the rows of the region, from the decompressed slice
+    for (SizeValueType row = 0; row < rowsPerSlice; ++row)
+    {
+      SizeValueType offset = regionIndex[0];
+      SizeValueType stride = this->GetDimensions(0);
+      SizeValueType remainder = row;
+      for (unsigned int i = 1; i < sliceDimension; ++i)
+      {
+        offset += (regionIndex[i] + remainder % regionSize[i]) * stride;
+        remainder /= regionSize[i];
+        stride *= this->GetDimensions(i);
+      }
+      std::copy_n(slice.get() + offset * pixelSize, rowSize, out);
+      out += rowSize;
+    }
+  }
+}
+
+void
+MetaImageIO::WriteChunkedCompressedData(const void * buffer)
+{
+  const unsigned int  sliceDimension = this->GetNumberOfDimensions() - 1;
+  const SizeValueType numberOfSlices = this->GetDimensions(sliceDimension);
+  for (unsigned int i = 0; i < sliceDimension; ++i)
+  {
+    if (m_IORegion.GetIndex(i) != 0 || m_IORegion.GetSize(i) != this->GetDimensions(i))
+    {
+      itkExceptionMacro("Chunked compressed data can only be written by whole slices: " << this->GetFileName());
+    }
+  }
+
+  // the data files are named after the header, and numbered from 1, as MetaIO does
+  DataFilePattern pattern;
+  pattern.prefix = itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + '_';
+  pattern.suffix = ".zraw";
+  pattern.width = static_cast<unsigned int>(std::to_string(numberOfSlices).size());
+  pattern.zeroPadded = true;
+  std::ostringstream elementDataFile;
+  elementDataFile << pattern.prefix << "%0" << pattern.width << 'd' << pattern.suffix << ' ' << pattern.first << ' '
+                  << pattern.first + static_cast<long>(numberOfSlices - 1) * pattern.step << ' ' << pattern.step;
+
+  // the header is the same for every region
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  m_MetaImage.ElementDataFileName(elementDataFile.str().c_str());
+  const bool headerWritten = m_MetaImage.Write(m_FileName.c_str(), nullptr, false);
+  m_MetaImage.ElementDataFileName(dataFileName.c_str());
+  if (!headerWritten)
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  SizeValueType sliceSize = this->GetPixelSize();
+  for (unsigned int i = 0; i < sliceDimension; ++i)
+  {
+    sliceSize *= this->GetDimensions(i);
+  }
+
+  const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+  const auto        getSliceFileName = [&pattern, &path](SizeValueType slice) {
+    const std::string fileName = pattern.GetFileName(slice);
+    return path.empty() ? fileName : path + '/' + fileName;
+  };
+
+  // the slices are compressed in parallel, each into its own file
+  const auto          firstSlice = static_cast<SizeValueType>(m_IORegion.GetIndex(sliceDimension));
+  const SizeValueType numberOfRegionSlices = m_IORegion.GetSize(sliceDimension);
+  const int           compressionLevel = m_MetaImage.CompressionLevel();
+  std::vector<char>   sliceWritten(numberOfRegionSlices, false);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfRegionSlices,
+    [&](SizeValueType i) {
+      std::streamoff                         compressedSize = 0;
+      const std::unique_ptr<unsigned char[]> compressed(
+        MET_PerformCompression(static_cast<const unsigned char *>(buffer) + i * sliceSize,
+                               static_cast<std::streamoff>(sliceSize),
+                               &compressedSize,
+                               compressionLevel));
+      std::ofstream file(getSliceFileName(firstSlice + i), std::ios::out | std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char *>(compressed.get()), compressedSize);
+      sliceWritten[i] = static_cast<bool>(file);
+    },
+    nullptr);
+
+  const auto notWritten = std::find(sliceWritten.cbegin(), sliceWritten.cend(), false);
+  if (notWritten != sliceWritten.cend())
+  {
+    itkExceptionMacro("File cannot be written: "
+                      << getSliceFileName(firstSlice + static_cast<SizeValueType>(notWritten - sliceWritten.cbegin()))
+                      << std::endl
+                      << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+}
+
+bool
+MetaImageIO::WriteParallelCompressedData(const void * buffer)
+{
+  if (!m_MetaImage.CompressedData() || !m_MetaImage.BinaryData() || *m_MetaImage.ElementDataFileName() != '\0')
+  {
+    return false;
+  }
+
+  // the data file is named as MetaIO names it
+  const bool        isLocal = itksys::SystemTools::GetFilenameLastExtension(m_FileName) == ".mha";
+  const std::string dataFileName =
+    isLocal ? "LOCAL" : itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + ".zraw";
+
+  const std::vector<char> compressed =
+    ParallelDeflate::CompressToZlib(buffer, this->GetImageSizeInBytes(), m_MetaImage.CompressionLevel());
+  if (!m_MetaImage.WriteHeaderOfCompressedData(
+        m_FileName.c_str(), dataFileName.c_str(), static_cast<std::streamoff>(compressed.size())))
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  // the header file may have been renamed by MetaIO
+  std::string fileName = m_MetaImage.FileName();
+  if (!isLocal)
+  {
+    const std::string path = itksys::SystemTools::GetFilenamePath(fileName);
+    fileName = path.empty() ? dataFileName : path + '/' + dataFileName;
+  }
+  std::ofstream file(fileName, std::ios::out | std::ios::binary | (isLocal ? std::ios::app : std::ios::trunc));
+  file.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be written: " << fileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  return true;
+}
+
+bool
+MetaImageIO::CompressibleMetaImage::WriteHeaderOfCompressedData(const char *   headerFileName,
+                                                                const char *   dataFileName,
+                                                                std::streamoff compressedSize)
+{
+  // MetaIO does not compress data that is not compressed, until the header
+  // is set up to tell that it is.
+  this->CompressedData(false);
+  m_SeparatelyCompressedDataSize = compressedSize;
+  const bool written = this->Write(headerFileName, dataFileName, false);
+  m_SeparatelyCompressedDataSize = 0;
+  m_CompressedDataSize = 0;
+  this->CompressedData(true);
+  return written;
+}
+
+void
+MetaImageIO::CompressibleMetaImage::M_SetupWriteFields()
+{
+  if (m_SeparatelyCompressedDataSize > 0)
+  {
+    m_CompressedData = true;
+    m_CompressedDataSize = m_SeparatelyCompressedDataSize;
+  }
+  MetaImage::M_SetupWriteFields();
+}
+
 void
 MetaImageIO::SetDefaultDoublePrecision(unsigned int precision)
 {
@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKMetaImageIOChunkedCompressionTest : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+
+  void
+  SetUp() override
+  {
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 9, 7, 12 } });
+    image->SetSpacing(itk::MakeVector(0.5, 0.75, 2.0));
+    image->Allocate();
+    short * const buffer = image->GetBufferPointer();
+    for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      buffer[i] = static_cast<short>(i % 1000 - 300);
+    }
+    return image;
+  }
+
+  static void
+  Write(const ImageType * image, const std::string & fileName, unsigned int numberOfStreamDivisions)
+  {
+    const auto imageIO = itk::MetaImageIO::New();
+    imageIO->SetUseChunkedCompression(true);
+    const auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(imageIO);
+    writer->SetFileName(fileName);
+    writer->SetUseCompression(true);
+    writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    writer->Update();
+  }
+
+  static ImageType::Pointer
+  Read(const std::string & fileName, const ImageType::RegionType * requestedRegion = nullptr)
+  {
+    const auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::MetaImageIO::New());
+    reader->SetFileName(fileName);
+    if (requestedRegion)
+    {
+      reader->UpdateOutputInformation();
+      reader->GetOutput()->SetRequestedRegion(*requestedRegion);
+    }
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  static void
+  ExpectEqualPixels(const ImageType & expected, const ImageType & actual, const ImageType::RegionType & region)
+  {
+    ASSERT_TRUE(actual.GetBufferedRegion().IsInside(region));
+    itk::ImageRegionConstIterator<ImageType> expectedIt(&expected, region);
+    itk::ImageRegionConstIterator<ImageType> actualIt(&actual, region);
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+    }
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKMetaImageIOChunkedCompressionTest, UseChunkedCompressionIsOffByDefault)
+{
+  const auto imageIO = itk::MetaImageIO::New();
+  EXPECT_FALSE(imageIO->GetUseChunkedCompression());
+  imageIO->SetUseCompression(true);
+  EXPECT_FALSE(imageIO->CanStreamWrite());
+
+  imageIO->UseChunkedCompressionOn();
+  imageIO->SetFileName("ITKMetaImageIOChunkedCompressionTest.mhd");
+  imageIO->SetNumberOfDimensions(3);
+  EXPECT_TRUE(imageIO->CanStreamWrite());
+
+  // Chunks are only written along with a detached header.
+  imageIO->SetFileName("ITKMetaImageIOChunkedCompressionTest.mha");
+  EXPECT_FALSE(imageIO->CanStreamWrite());
+}
+
+
+TEST_F(ITKMetaImageIOChunkedCompressionTest, WriteAndRead)
+{
+  const auto        image = MakeImage();
+  const std::string fileName = "ITKMetaImageIOChunkedCompressionTest_Whole.mhd";
+  Write(image, fileName, 1);
+
+  // One data file per slice, numbered from 1.
+  EXPECT_TRUE(itksys::SystemTools::FileExists("ITKMetaImageIOChunkedCompressionTest_Whole_01.zraw"));
+  EXPECT_TRUE(itksys::SystemTools::FileExists("ITKMetaImageIOChunkedCompressionTest_Whole_12.zraw"));
+
+  const auto readImage = Read(fileName);
+  EXPECT_EQ(readImage->GetSpacing(), image->GetSpacing());
+  ExpectEqualPixels(*image, *readImage, image->GetLargestPossibleRegion());
+}
+
+
+TEST_F(ITKMetaImageIOChunkedCompressionTest, StreamedWrite)
+{
+  const auto        image = MakeImage();
+  const std::string fileName = "ITKMetaImageIOChunkedCompressionTest_Streamed.mhd";
+  Write(image, fileName, 5);
+  ExpectEqualPixels(*image, *Read(fileName), image->GetLargestPossibleRegion());
+}
+
+
+TEST_F(ITKMetaImageIOChunkedCompressionTest, StreamedRead)
+{
+  const auto        image = MakeImage();
+  const std::string fileName = "ITKMetaImageIOChunkedCompressionTest_Region.mhd";
+  Write(image, fileName, 1);
+
+  const ImageType::RegionType region({ { 2, 1, 4 } }, { { 5, 4, 3 } });
+  const auto                  readImage = Read(fileName, &region);
+  EXPECT_EQ(readImage->GetBufferedRegion(), region);
+  ExpectEqualPixels(*image, *readImage, region);
+
+  // Only the slices of the requested region are needed.
+  itksys::SystemTools::RemoveFile("ITKMetaImageIOChunkedCompressionTest_Region_01.zraw");
+  ExpectEqualPixels(*image, *Read(fileName, &region), region);
+}
+
+
+TEST_F(ITKMetaImageIOChunkedCompressionTest, PastingPartialSlicesThrows)
+{
+  const auto        image = MakeImage();
+  const std::string fileName = "ITKMetaImageIOChunkedCompressionTest_Paste.mhd";
+  Write(image, fileName, 1);
+
+  const auto imageIO = itk::MetaImageIO::New();
+  imageIO->SetUseChunkedCompression(true);
+  const auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(imageIO);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(true);
+
+  itk::ImageIORegion pasteRegion(3);
+  pasteRegion.SetIndex({ 0, 0, 3 });
+  pasteRegion.SetSize({ 9, 7, 2 });
+  writer->SetIORegion(pasteRegion);
+  EXPECT_NO_THROW(writer->Update());
+  ExpectEqualPixels(*image, *Read(fileName), image->GetLargestPossibleRegion());
+
+  pasteRegion.SetSize({ 4, 7, 2 });
+  writer->SetIORegion(pasteRegion);
+  EXPECT_THROW(writer->Update(), itk::ExceptionObject);
+}
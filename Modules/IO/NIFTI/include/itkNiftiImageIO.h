@@ -149,6 +149,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixel data can be memory mapped when it is uncompressed, in the
+   * native byte order, not rescaled, and laid out as in an ITK image (that
+   * is, scalar, complex, RGB or RGBA pixels). */
+  bool
+  GetPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
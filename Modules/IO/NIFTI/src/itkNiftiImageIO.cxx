@@ -22,8 +22,10 @@
 #include <nifti1_io.h>
 #include "itkNiftiImageIOConfigurePrivate.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkParallelDeflate.h"
 #include "itksys/SystemTools.hxx"
 #include "itksys/SystemInformation.hxx"
+#include <fstream>
 
 namespace itk
 {
@@ -325,6 +327,45 @@ str_xform(unsigned int xform)
   }
   return str_xform(NIFTI_XFORM_UNKNOWN);
 }
+
+// Writes the image as nifti_image_write_status does, except for a single
+// gzip compressed file: then only the header and the extensions are
+// written by the nifti library, and the data is compressed by blocks, in
+// parallel, into a second gzip member appended to the file. Readers of
+// gzip files read concatenated members as a single stream.
+static int
+write_nifti_image(nifti_image * nim)
+{
+  if (nim->nifti_type != NIFTI_FTYPE_NIFTI1_1 || !nifti_is_gzfile(nim->fname))
+  {
+    return nifti_image_write_status(nim);
+  }
+
+  // write the header, and leave the file open at the offset of the data
+  znzFile fp = nifti_image_write_hdr_img(nim, 2, "wb");
+  if (znz_isnull(fp) || znzclose(fp) != 0)
+  {
+    return 1;
+  }
+
+  try
+  {
+    const std::vector<char> compressed =
+      itk::ParallelDeflate::CompressToGzip(nim->data, static_cast<size_t>(nim->nbyper) * nim->nvox, -1);
+    std::ofstream file(nim->fname, std::ios::out | std::ios::binary | std::ios::app);
+    file.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    if (!file)
+    {
+      return 1;
+    }
+  }
+  catch (const itk::ExceptionObject &)
+  {
+    return 1;
+  }
+  nim->byteorder = nifti_short_order();
+  return 0;
+}
 } // namespace
 
 // returns an ordering array for converting upper triangular symmetric matrix
@@ -464,6 +505,31 @@ NiftiImageIO::CanWriteFile(const char * FileNameToWrite)
   return ValidFileNameFound;
 }
 
+bool
+NiftiImageIO::GetPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (this->MustRescale() || (this->GetNumberOfComponents() > 1 && this->GetPixelType() != IOPixelEnum::COMPLEX &&
+                              this->GetPixelType() != IOPixelEnum::RGB && this->GetPixelType() != IOPixelEnum::RGBA))
+  {
+    return false;
+  }
+
+  nifti_image * const header = nifti_image_read(this->GetFileName(), false);
+  if (header == nullptr)
+  {
+    return false;
+  }
+  const bool isMappable = header->iname != nullptr && !nifti_is_gzfile(header->iname) && header->iname_offset >= 0 &&
+                          (header->swapsize <= 1 || header->byteorder == nifti_short_order());
+  if (isMappable)
+  {
+    fileName = header->iname;
+    offset = static_cast<SizeType>(header->iname_offset);
+  }
+  nifti_image_free(header);
+  return isMappable;
+}
+
 bool
 NiftiImageIO::MustRescale() const
 {
@@ -2393,7 +2459,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory
     // for writing.
     this->m_NiftiImage->data = const_cast<void *>(buffer);
-    const int nifti_write_status = nifti_image_write_status(this->m_NiftiImage);
+    const int nifti_write_status = write_nifti_image(this->m_NiftiImage);
     this->m_NiftiImage->data = nullptr; // Must free before throwing exception.
                                         // if left pointing to data buffer
                                         // nifti_image_free inside Destructor of ITKNiftiIO
@@ -2502,7 +2568,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory for
     // writing.
     this->m_NiftiImage->data = static_cast<void *>(nifti_buf.get());
-    const int nifti_write_status = nifti_image_write_status(this->m_NiftiImage);
+    const int nifti_write_status = write_nifti_image(this->m_NiftiImage);
     this->m_NiftiImage->data = nullptr; // if left pointing to data buffer
     if (nifti_write_status)
     {
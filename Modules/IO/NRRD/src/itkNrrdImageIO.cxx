@@ -22,7 +22,10 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itkParallelDeflate.h"
+#include "itksys/SystemTools.hxx"
 
+#include <fstream>
 #include <sstream>
 
 namespace itk
@@ -1141,6 +1144,12 @@ NrrdImageIO::Write(const void * buffer)
       break;
   }
 
+  // Gzip compressed data that follows the header is compressed by blocks,
+  // in parallel, rather than by the nrrd library, which only writes the header.
+  const bool compressInParallel =
+    nio->encoding == nrrdEncodingGzip && !itksys::SystemTools::StringEndsWith(this->GetFileName(), NRRD_EXT_NHDR);
+  nio->skipData = compressInParallel;
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
   {
@@ -1151,6 +1160,19 @@ NrrdImageIO::Write(const void * buffer)
   // Free the nrrd struct but don't touch nrrd->data
   nrrdNix(nrrd);
   nrrdIoStateNix(nio);
+
+  if (compressInParallel)
+  {
+    const std::vector<char> compressed =
+      ParallelDeflate::CompressToGzip(buffer, this->GetImageSizeInBytes(), this->GetCompressionLevel());
+    std::ofstream file(this->GetFileName(), std::ios::out | std::ios::binary | std::ios::app);
+    file.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    if (!file)
+    {
+      itkExceptionMacro("Write: Error writing " << this->GetFileName() << ":\n"
+                                                << itksys::SystemTools::GetLastSystemError());
+    }
+  }
 }
 
 } // end namespace itk
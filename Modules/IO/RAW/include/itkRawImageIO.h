@@ -123,6 +123,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixel data can be memory mapped when it is binary and in the
+   * native byte order. */
+  bool
+  GetPixelDataLocation(std::string & fileName, ImageIOBase::SizeType & offset) override;
+
   /** Set/Get the Data mask. */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
   void
@@ -161,6 +161,20 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+bool
+RawImageIO<TPixel, VImageDimension>::GetPixelDataLocation(std::string & fileName, ImageIOBase::SizeType & offset)
+{
+  const bool isNativeByteOrder = (m_ByteOrder == IOByteOrderEnum::BigEndian) == ByteSwapperType::SystemIsBigEndian();
+  if (m_FileType != IOFileEnum::Binary || (this->GetComponentSize() > 1 && !isNativeByteOrder))
+  {
+    return false;
+  }
+  fileName = m_FileName;
+  offset = static_cast<ImageIOBase::SizeType>(this->GetHeaderSize());
+  return true;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
@@ -191,6 +191,20 @@ protected:
     return ProcessVirtualPoint_impl(IdentityHelper<TDomainPartitioner>(), virtualIndex, virtualPoint, threadId);
   }
 
+  /** Calls \c ProcessVirtualPoint on each of the given virtual points, as the sparse threader processes its points one by one. */
+  void
+  ProcessVirtualPoints(const VirtualIndexType * virtualIndices,
+                       const VirtualPointType * virtualPoints,
+                       SizeValueType            numberOfPoints,
+                       SizeValueType            itkNotUsed(firstSample),
+                       const ThreadIdType       threadId) override
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      this->ProcessVirtualPoint(virtualIndices[i], virtualPoints[i], threadId);
+    }
+  }
+
   /* specific overloading for sparse CC metric */
   bool
   ProcessVirtualPoint_impl(IdentityHelper<ThreadedIndexedContainerPartitioner> itkNotUsed(self),
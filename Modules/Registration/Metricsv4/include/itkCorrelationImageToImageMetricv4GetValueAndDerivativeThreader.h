@@ -104,6 +104,20 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /** Calls \c ProcessVirtualPoint on each of the given virtual points. */
+  void
+  ProcessVirtualPoints(const VirtualIndexType * virtualIndices,
+                       const VirtualPointType * virtualPoints,
+                       SizeValueType            numberOfPoints,
+                       SizeValueType            itkNotUsed(firstSample),
+                       const ThreadIdType       threadId) override
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      this->ProcessVirtualPoint(virtualIndices[i], virtualPoints[i], threadId);
+    }
+  }
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -100,13 +100,13 @@ namespace itk
  * SetFixedSampledPointSet is called or SetVirtualSampledPointSet
  * along with SetUseVirtualSampledPointSet.
  * \note If the point set is sparse, the option SetUse[Fixed|Moving]ImageGradientFilter
- * typically should be disabled to avoid excessive computation. However,
- * the gradient values of the fixed image are not cached
- * when using a point set (there are plans for this in the future), so
- * depending on the number of iterations (when used during optimization)
- * and the level of sparsity, it may be more efficient to
- * use a gradient image filter for it because it will only be
- * calculated once.
+ * typically should be disabled to avoid excessive computation. The fixed
+ * image values and gradients at the points are then only computed once per
+ * Initialize() when UseFixedSampleCache is on. Otherwise, they are computed
+ * at each evaluation, so depending on the number of iterations (when used
+ * during optimization) and the level of sparsity, it may be more efficient
+ * to use a gradient image filter for the fixed image because it will only
+ * be calculated once.
  *
  * Vector Images
  *
@@ -462,6 +462,20 @@ public:
   itkGetConstReferenceMacro(UseVirtualSampledPointSet, bool);
   itkBooleanMacro(UseVirtualSampledPointSet);
 
+  /** Set/Get flag to cache the fixed image samples: the mapped fixed point,
+   * the fixed pixel value and, when the gradient source includes the fixed
+   * image, the fixed image gradient at each point of the domain. The cache is
+   * built at the first evaluation after Initialize(), which
+   * ImageRegistrationMethodv4 calls at each level, and again when the fixed
+   * image, transform, interpolator or mask is modified. Each evaluation then
+   * only maps and evaluates the moving image. It takes memory for every point
+   * of the domain, so it is meant for sparse sampling, or for small virtual
+   * domains. It is used by the metrics whose threader processes the points
+   * with ProcessPoint(). False by default. */
+  itkSetMacro(UseFixedSampleCache, bool);
+  itkGetConstReferenceMacro(UseFixedSampleCache, bool);
+  itkBooleanMacro(UseFixedSampleCache);
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** UseFixedSampledPointSet is deprecated and has been replaced
    * with UseSampledPointsSet. */
@@ -694,6 +708,19 @@ protected:
                                   MovingImagePointType &   mappedMovingPoint,
                                   MovingImagePixelType &   mappedMovingPixelValue) const;
 
+  /** Transform and evaluate points from VirtualImage domain to MovingImage
+   * domain, as TransformAndEvaluateMovingPoint does for each of them. The
+   * points are mapped by a single call of the TransformPoints method of the
+   * moving transform, and the moving image is evaluated at the valid ones by a
+   * single call of the EvaluateAtContinuousIndices method of the interpolator.
+   * \c pointsAreValid receives whether each point is valid. */
+  void
+  TransformAndEvaluateMovingPoints(const VirtualPointType * virtualPoints,
+                                   SizeValueType            numberOfPoints,
+                                   MovingImagePointType *   mappedMovingPoints,
+                                   MovingImagePixelType *   mappedMovingPixelValues,
+                                   bool *                   pointsAreValid) const;
+
   /** Compute image derivatives for a Fixed point. */
   virtual void
   ComputeFixedImageGradientAtPoint(const FixedImagePointType & mappedPoint, FixedImageGradientType & gradient) const;
@@ -733,6 +760,14 @@ protected:
   /** Get accessor for flag to calculate derivative. */
   itkGetConstMacro(ComputeDerivative, bool);
 
+  /** Set the flag to calculate derivative, for the metrics whose
+   * GetValueAndDerivativeExecute() makes more than one pass over the samples. */
+  void
+  SetComputeDerivative(bool computeDerivative) const
+  {
+    this->m_ComputeDerivative = computeDerivative;
+  }
+
   FixedImageConstPointer  m_FixedImage{};
   MovingImageConstPointer m_MovingImage{};
 
@@ -792,6 +827,30 @@ protected:
   FixedSampledPointSet */
   bool m_UseVirtualSampledPointSet{};
 
+  /** The fixed image samples of UseFixedSampleCache, as arrays indexed by the
+   * identifier of the point in the virtual sampled point set, with sparse
+   * sampling, or by the offset of the pixel in the virtual region. */
+  struct FixedSampleCacheType
+  {
+    /** The virtual indices of the points, with sparse sampling only. */
+    std::vector<VirtualIndexType>       VirtualIndices;
+    std::vector<FixedImagePointType>    Points;
+    std::vector<FixedImagePixelType>    PixelValues;
+    /** The gradients, when the gradient source includes the fixed image. */
+    std::vector<FixedImageGradientType> Gradients;
+    /** Whether the point is mapped inside the fixed image and its mask. */
+    std::vector<unsigned char>          IsValid;
+  };
+
+  bool                         m_UseFixedSampleCache{};
+  mutable FixedSampleCacheType m_FixedSampleCache{};
+  mutable TimeStamp            m_FixedSampleCacheTime{};
+
+  /** Builds the cache of the fixed image samples, when UseFixedSampleCache is
+   * on and the cache is not up to date. */
+  void
+  UpdateFixedSampleCache() const;
+
   ImageToImageMetricv4();
   ~ImageToImageMetricv4() override = default;
 
@@ -23,6 +23,7 @@
 #include "itkCompositeTransform.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkIdentityTransform.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -144,6 +145,9 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     this->MapFixedSampledPointSetToVirtual();
   }
 
+  /* The fixed image samples are cached again at the next evaluation. */
+  this->m_FixedSampleCache = FixedSampleCacheType();
+
   /* Initialize interpolators. */
   itkDebugMacro("Initialize Interpolators");
   this->m_FixedInterpolator->SetInputImage(this->m_FixedImage);
@@ -255,6 +259,8 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   GetValueAndDerivativeExecute() const
 {
+  this->UpdateFixedSampleCache();
+
   if (this->m_UseSampledPointSet) // sparse sampling
   {
     const SizeValueType numberOfPoints = this->GetNumberOfDomainPoints();
@@ -388,6 +394,67 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   return pointIsValid;
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  TransformAndEvaluateMovingPoints(const VirtualPointType * virtualPoints,
+                                   SizeValueType            numberOfPoints,
+                                   MovingImagePointType *   mappedMovingPoints,
+                                   MovingImagePixelType *   mappedMovingPixelValues,
+                                   bool *                   pointsAreValid) const
+{
+  using TransformPointType = typename MovingTransformType::OutputPointType;
+  using ContinuousIndexType = typename MovingInterpolatorType::ContinuousIndexType;
+  using InterpolatorOutputType = typename MovingInterpolatorType::OutputType;
+
+  // map the points into moving space, in the point type of the transform
+  std::vector<TransformPointType> localPoints(numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    localPoints[i].CastFrom(virtualPoints[i]);
+  }
+  this->m_MovingTransform->TransformPoints(localPoints.data(), localPoints.data(), numberOfPoints);
+
+  // Check the mapped points against the mask, if one is assigned, and the
+  // image buffer, and gather the continuous indices of the valid ones.
+  const MovingImageType * const    movingImage = this->m_MovingInterpolator->GetInputImage();
+  std::vector<ContinuousIndexType> validIndices;
+  std::vector<SizeValueType>       validPoints;
+  validIndices.reserve(numberOfPoints);
+  validPoints.reserve(numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    mappedMovingPoints[i].CastFrom(localPoints[i]);
+    mappedMovingPixelValues[i] = MovingImagePixelType{};
+    pointsAreValid[i] = false;
+    if (this->m_MovingImageMask && !this->m_MovingImageMask->IsInsideInWorldSpace(mappedMovingPoints[i]))
+    {
+      continue;
+    }
+    const ContinuousIndexType index =
+      movingImage->template TransformPhysicalPointToContinuousIndex<CoordinateRepresentationType>(
+        mappedMovingPoints[i]);
+    if (this->m_MovingInterpolator->IsInsideBuffer(index))
+    {
+      pointsAreValid[i] = true;
+      validIndices.push_back(index);
+      validPoints.push_back(i);
+    }
+  }
+
+  // Evaluate
+  std::vector<InterpolatorOutputType> values(validIndices.size());
+  this->m_MovingInterpolator->EvaluateAtContinuousIndices(validIndices.data(), values.data(), validIndices.size());
+  for (SizeValueType j = 0; j < validPoints.size(); ++j)
+  {
+    mappedMovingPixelValues[validPoints[j]] = values[j];
+  }
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -629,6 +696,93 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  UpdateFixedSampleCache() const
+{
+  if (!this->m_UseFixedSampleCache)
+  {
+    this->m_FixedSampleCache = FixedSampleCacheType();
+    return;
+  }
+  const ModifiedTimeType cacheTime = this->m_FixedSampleCacheTime.GetMTime();
+  if (!this->m_FixedSampleCache.IsValid.empty() && cacheTime > this->m_FixedImage->GetMTime() &&
+      cacheTime > this->m_FixedTransform->GetMTime() && cacheTime > this->m_FixedInterpolator->GetMTime() &&
+      (this->m_FixedImageMask.IsNull() || cacheTime > this->m_FixedImageMask->GetMTime()))
+  {
+    return;
+  }
+
+  const SizeValueType    numberOfSamples = this->GetNumberOfDomainPoints();
+  FixedSampleCacheType & cache = this->m_FixedSampleCache;
+  cache.VirtualIndices.resize(this->m_UseSampledPointSet ? numberOfSamples : 0);
+  cache.Points.resize(numberOfSamples);
+  cache.PixelValues.resize(numberOfSamples);
+  cache.Gradients.resize(this->GetGradientSourceIncludesFixed() ? numberOfSamples : 0);
+  cache.IsValid.resize(numberOfSamples);
+
+  const auto cacheSample = [this, &cache](SizeValueType sample, const VirtualPointType & virtualPoint) {
+    const bool isValid =
+      this->TransformAndEvaluateFixedPoint(virtualPoint, cache.Points[sample], cache.PixelValues[sample]);
+    cache.IsValid[sample] = isValid;
+    if (isValid && !cache.Gradients.empty())
+    {
+      this->ComputeFixedImageGradientAtPoint(cache.Points[sample], cache.Gradients[sample]);
+    }
+  };
+
+  const VirtualImageType * const virtualImage = this->GetVirtualImage();
+  if (this->m_UseSampledPointSet)
+  {
+    // By blocks of points.
+    constexpr SizeValueType blockSize = 256;
+    this->m_SparseGetValueAndDerivativeThreader->GetMultiThreader()->ParallelizeArray(
+      0,
+      (numberOfSamples + blockSize - 1) / blockSize,
+      [this, &cache, &cacheSample, virtualImage, numberOfSamples](SizeValueType block) {
+        const SizeValueType end = std::min(numberOfSamples, (block + 1) * blockSize);
+        for (SizeValueType sample = block * blockSize; sample < end; ++sample)
+        {
+          const VirtualPointType virtualPoint = this->m_VirtualSampledPointSet->GetPoint(sample);
+          cache.VirtualIndices[sample] = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+          cacheSample(sample, virtualPoint);
+        }
+      },
+      nullptr);
+  }
+  else
+  {
+    // By lines of the virtual region, in the order of the offsets of its pixels.
+    const VirtualRegionType virtualRegion = this->GetVirtualRegion();
+    const SizeValueType     lineLength = virtualRegion.GetSize(0);
+    this->m_DenseGetValueAndDerivativeThreader->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSamples / lineLength,
+      [&cacheSample, virtualImage, &virtualRegion, lineLength](SizeValueType line) {
+        VirtualIndexType virtualIndex = virtualRegion.GetIndex();
+        SizeValueType lineNumber = line;
+        for (unsigned int d = 1; d < VirtualImageDimension; ++d)
+        {
+          virtualIndex[d] += static_cast<IndexValueType>(lineNumber % virtualRegion.GetSize(d));
+          lineNumber /= virtualRegion.GetSize(d);
+        }
+        VirtualPointType virtualPoint;
+        for (SizeValueType i = 0; i < lineLength; ++i, ++virtualIndex[0])
+        {
+          virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
+          cacheSample(line * lineLength + i, virtualPoint);
+        }
+      },
+      nullptr);
+  }
+  this->m_FixedSampleCacheTime.Modified();
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -666,6 +820,7 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
      << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+  itkPrintSelfBooleanMacro(UseFixedSampleCache);
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
@@ -19,6 +19,8 @@
 #define itkImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageScanlineConstIterator.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -30,13 +32,30 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
   TImageToImageMetricv4>::ThreadedExecution(const DomainType & imageSubRegion, const ThreadIdType threadId)
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
-  using IteratorType = ImageRegionConstIteratorWithIndex<VirtualImageType>;
-  VirtualPointType virtualPoint;
-  for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
+  const typename VirtualImageType::RegionType   virtualRegion = this->m_Associate->GetVirtualRegion();
+
+  // Process the region a line at a time.
+  const SizeValueType           lineLength = imageSubRegion.GetSize(0);
+  std::vector<VirtualIndexType> virtualIndices(lineLength);
+  std::vector<VirtualPointType> virtualPoints(lineLength);
+  for (ImageScanlineConstIterator<VirtualImageType> it(virtualImage, imageSubRegion); !it.IsAtEnd(); it.NextLine())
   {
-    const VirtualIndexType & virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    VirtualIndexType virtualIndex = it.GetIndex();
+
+    // The offset of the line in the virtual region.
+    SizeValueType firstSample = 0;
+    for (unsigned int d = TImageToImageMetricv4::VirtualImageDimension; d > 0; --d)
+    {
+      firstSample = firstSample * virtualRegion.GetSize(d - 1) +
+                    static_cast<SizeValueType>(virtualIndex[d - 1] - virtualRegion.GetIndex(d - 1));
+    }
+
+    for (SizeValueType i = 0; i < lineLength; ++i, ++virtualIndex[0])
+    {
+      virtualIndices[i] = virtualIndex;
+      virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoints[i]);
+    }
+    this->ProcessVirtualPoints(virtualIndices.data(), virtualPoints.data(), lineLength, firstSample, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -53,11 +72,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
-  for (ElementIdentifierType i = begin; i <= end; ++i)
+
+  // Process the points by batches of at most PointsPerBatch points.
+  constexpr ElementIdentifierType PointsPerBatch = 256;
+  std::vector<VirtualIndexType>   virtualIndices(PointsPerBatch);
+  std::vector<VirtualPointType>   virtualPoints(PointsPerBatch);
+  for (ElementIdentifierType batchBegin = begin; batchBegin <= end; batchBegin += PointsPerBatch)
   {
-    const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
-    const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    const ElementIdentifierType numberOfPoints = std::min(PointsPerBatch, end - batchBegin + 1);
+    for (ElementIdentifierType i = 0; i < numberOfPoints; ++i)
+    {
+      virtualPoints[i] = virtualSampledPointSet->GetPoint(batchBegin + i);
+      virtualIndices[i] = this->m_Associate->m_UseFixedSampleCache
+                            ? this->m_Associate->m_FixedSampleCache.VirtualIndices[batchBegin + i]
+                            : virtualImage->TransformPhysicalPointToIndex(virtualPoints[i]);
+    }
+    this->ProcessVirtualPoints(virtualIndices.data(), virtualPoints.data(), numberOfPoints, batchBegin, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -122,6 +122,22 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** Method called by the threaders to process the given virtual points, a
+   * line of the virtual image or a range of the virtual point set, whose
+   * first point is the sample firstSample of the domain: its identifier in
+   * the virtual sampled point set, or its offset in the virtual region. The
+   * points are mapped into moving space and evaluated at once by \c
+   * TransformAndEvaluateMovingPoints, then each point is processed as \c
+   * ProcessVirtualPoint does, with the fixed image samples cached by the
+   * metric when its UseFixedSampleCache is on. Derived classes that override
+   * \c ProcessVirtualPoint override this method to call it on each point. */
+  virtual void
+  ProcessVirtualPoints(const VirtualIndexType * virtualIndices,
+                       const VirtualPointType * virtualPoints,
+                       SizeValueType            numberOfPoints,
+                       SizeValueType            firstSample,
+                       const ThreadIdType       threadId);
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -199,6 +215,21 @@ protected:
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType m_CachedNumberOfParameters{};
   mutable NumberOfParametersType m_CachedNumberOfLocalParameters{};
+
+private:
+  /** Processes the given virtual point as \c ProcessVirtualPoint does, with
+   * its mapped fixed point, fixed pixel value and fixed image gradient, and
+   * with its mapped moving point and moving pixel value, when they are not
+   * null, which are then valid. */
+  bool
+  ProcessVirtualPoint(const VirtualIndexType &       virtualIndex,
+                      const VirtualPointType &       virtualPoint,
+                      const FixedImagePointType *    mappedFixedPoint,
+                      const FixedImagePixelType *    mappedFixedPixelValue,
+                      const FixedImageGradientType * mappedFixedImageGradient,
+                      const MovingImagePointType *   mappedMovingPoint,
+                      const MovingImagePixelType *   mappedMovingPixelValue,
+                      const ThreadIdType             threadId);
 };
 
 } // end namespace itk
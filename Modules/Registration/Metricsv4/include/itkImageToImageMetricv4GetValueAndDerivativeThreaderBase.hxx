@@ -177,6 +177,83 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   const VirtualIndexType & virtualIndex,
   const VirtualPointType & virtualPoint,
   const ThreadIdType       threadId)
+{
+  return this->ProcessVirtualPoint(virtualIndex, virtualPoint, nullptr, nullptr, nullptr, nullptr, nullptr, threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessVirtualPoints(
+  const VirtualIndexType * virtualIndices,
+  const VirtualPointType * virtualPoints,
+  SizeValueType            numberOfPoints,
+  SizeValueType            firstSample,
+  const ThreadIdType       threadId)
+{
+  std::vector<MovingImagePointType> mappedMovingPoints(numberOfPoints);
+  std::vector<MovingImagePixelType> mappedMovingPixelValues(numberOfPoints);
+  const auto                        pointsAreValid = make_unique_for_overwrite<bool[]>(numberOfPoints);
+
+  try
+  {
+    this->m_Associate->TransformAndEvaluateMovingPoints(
+      virtualPoints, numberOfPoints, mappedMovingPoints.data(), mappedMovingPixelValues.data(), pointsAreValid.get());
+  }
+  catch (const ExceptionObject & exc)
+  {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+  }
+
+  if (!this->m_Associate->m_UseFixedSampleCache)
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      if (pointsAreValid[i])
+      {
+        this->ProcessVirtualPoint(virtualIndices[i],
+                                  virtualPoints[i],
+                                  nullptr,
+                                  nullptr,
+                                  nullptr,
+                                  &mappedMovingPoints[i],
+                                  &mappedMovingPixelValues[i],
+                                  threadId);
+      }
+    }
+    return;
+  }
+
+  const auto & cache = this->m_Associate->m_FixedSampleCache;
+  for (SizeValueType i = 0, sample = firstSample; i < numberOfPoints; ++i, ++sample)
+  {
+    if (pointsAreValid[i] && cache.IsValid[sample])
+    {
+      this->ProcessVirtualPoint(virtualIndices[i],
+                                virtualPoints[i],
+                                &cache.Points[sample],
+                                &cache.PixelValues[sample],
+                                cache.Gradients.empty() ? nullptr : &cache.Gradients[sample],
+                                &mappedMovingPoints[i],
+                                &mappedMovingPixelValues[i],
+                                threadId);
+    }
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessVirtualPoint(
+  const VirtualIndexType &       virtualIndex,
+  const VirtualPointType &       virtualPoint,
+  const FixedImagePointType *    precomputedFixedPoint,
+  const FixedImagePixelType *    precomputedFixedPixelValue,
+  const FixedImageGradientType * precomputedFixedImageGradient,
+  const MovingImagePointType *   precomputedMovingPoint,
+  const MovingImagePixelType *   precomputedMovingPixelValue,
+  const ThreadIdType             threadId)
 {
   FixedImagePointType     mappedFixedPoint;
   FixedImagePixelType     mappedFixedPixelValue;
@@ -192,12 +269,28 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
    * then we otherwise get when exceptions are caught in MultiThreaderBase. */
   try
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
+    if (precomputedFixedPoint)
+    {
+      mappedFixedPoint = *precomputedFixedPoint;
+      mappedFixedPixelValue = *precomputedFixedPixelValue;
+      pointIsValid = true;
+    }
+    else
+    {
+      pointIsValid =
+        this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
+    }
     if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
         this->m_Associate->GetGradientSourceIncludesFixed())
     {
-      this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
+      if (precomputedFixedImageGradient)
+      {
+        mappedFixedImageGradient = *precomputedFixedImageGradient;
+      }
+      else
+      {
+        this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
+      }
     }
   }
   catch (const ExceptionObject & exc)
@@ -215,8 +308,16 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
 
   try
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+    if (precomputedMovingPoint)
+    {
+      mappedMovingPoint = *precomputedMovingPoint;
+      mappedMovingPixelValue = *precomputedMovingPixelValue;
+    }
+    else
+    {
+      pointIsValid =
+        this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+    }
     if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
         this->m_Associate->GetGradientSourceIncludesMoving())
     {
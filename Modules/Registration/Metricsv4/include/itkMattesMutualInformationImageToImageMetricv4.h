@@ -60,6 +60,18 @@ namespace itk
 *
 * Once the PDF's have been constructed, the mutual information
 * is obtained by double summing over the discrete PDF values.
+ *
+ * With a transform that does not have local support, the derivatives of
+ * the joint PDF with respect to the transform parameters are accumulated in
+ * an image of NumberOfParameters x NumberOfHistogramBins^2 values, from
+ * which the metric derivative is computed, as in [1]. When
+ * UseExplicitPDFDerivatives is off, the metric derivative is instead
+ * accumulated directly, as in [3], from a second pass over the samples once
+ * the joint PDF is known, per work unit in a buffer of NumberOfParameters
+ * values. This takes an order of magnitude less memory when the transform
+ * has many parameters, such as a BSplineTransform, whose Jacobian is then
+ * only computed at the parameters of the support region of each sample.
+ * The metric value is the same.
  *
  * \warning Local-support transforms are not yet supported. If used,
  * an exception is thrown during Initialize().
@@ -157,6 +169,14 @@ public:
   itkSetClampMacro(NumberOfHistogramBins, SizeValueType, 5, NumericTraits<SizeValueType>::max());
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
 
+  /** Whether to compute the derivatives of the joint PDF with respect to the
+   * parameters of a transform that does not have local support, explicitly
+   * (the default), or to accumulate the metric derivative directly in a
+   * second pass over the samples. See the class documentation. */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+
   void
   Initialize() override;
 
@@ -223,6 +243,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Computes the joint PDF, then the derivative, in two passes over the
+   * samples, when UseExplicitPDFDerivatives is off. */
+  void
+  GetValueAndDerivativeExecute() const override;
+
   using JointPDFIndexType = typename JointPDFType::IndexType;
   using JointPDFValueType = typename JointPDFType::PixelType;
   using JointPDFRegionType = typename JointPDFType::RegionType;
@@ -255,7 +280,16 @@ protected:
   PDFValueType  m_FixedImageBinSize{};
   PDFValueType  m_MovingImageBinSize{};
 
-  /** Helper array for storing the values of the JointPDF ratios. */
+  bool m_UseExplicitPDFDerivatives{ true };
+
+  /** Whether GetValueAndDerivativeExecute() is making the two passes over
+   * the samples of UseExplicitPDFDerivatives off: the first one computes the
+   * joint PDF and m_PRatioArray, the second one the derivative. */
+  mutable bool m_ComputingImplicitPDFDerivatives{ false };
+
+  /** Helper array for storing the values of the JointPDF ratios, scaled for
+   * the derivative, with a local-support transform or when
+   * UseExplicitPDFDerivatives is off. */
   using PRatioType = PDFValueType;
   using PRatioArrayType = std::vector<PRatioType>;
 
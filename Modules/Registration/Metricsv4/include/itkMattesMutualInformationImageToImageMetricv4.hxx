@@ -271,6 +271,45 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
    * is now performed in the threader BeforeThreadedExecution method */
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivativeExecute() const
+{
+  if (!this->GetComputeDerivative() || this->HasLocalSupport() || this->m_UseExplicitPDFDerivatives)
+  {
+    this->Superclass::GetValueAndDerivativeExecute();
+    return;
+  }
+
+  // The first pass computes the joint PDF, the value and the ratios of the
+  // joint PDF to the marginal PDFs, from which the second pass computes the
+  // derivative.
+  this->m_ComputingImplicitPDFDerivatives = true;
+  try
+  {
+    this->SetComputeDerivative(false);
+    this->Superclass::GetValueAndDerivativeExecute();
+    this->SetComputeDerivative(true);
+    this->Superclass::GetValueAndDerivativeExecute();
+  }
+  catch (...)
+  {
+    this->SetComputeDerivative(true);
+    this->m_ComputingImplicitPDFDerivatives = false;
+    throw;
+  }
+  this->m_ComputingImplicitPDFDerivatives = false;
+}
+
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -283,7 +322,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && !this->m_ComputingImplicitPDFDerivatives)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -389,7 +428,12 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
           const PDFValueType pRatio = std::log(jointPDFValue / movingImageMarginalPDF);
           sum += jointPDFValue * (pRatio - logfixedImageMarginalPDFValue);
 
-          if (this->GetComputeDerivative())
+          if (this->m_ComputingImplicitPDFDerivatives)
+          {
+            // Collect the pRatio per pdf indices, for the second pass.
+            this->m_PRatioArray[movingIndex + (fixedIndex * this->m_NumberOfHistogramBins)] = pRatio * nFactor;
+          }
+          else if (this->GetComputeDerivative())
           {
             if (!this->HasLocalSupport())
             {
@@ -501,6 +545,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseExplicitPDFDerivatives);
 }
 
 template <typename TFixedImage,
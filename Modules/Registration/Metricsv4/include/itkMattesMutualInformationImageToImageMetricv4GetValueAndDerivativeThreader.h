@@ -19,6 +19,7 @@
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_h
 
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
+#include "itkBSplineBaseTransform.h"
 
 #include <mutex>
 
@@ -86,6 +87,12 @@ public:
 
   using JacobianType = typename TMattesMutualInformationMetric::JacobianType;
 
+  /** The B-spline transforms whose sparse Jacobian is used when
+   * UseExplicitPDFDerivatives is off. */
+  using BSplineTransformType = BSplineBaseTransform<typename MovingTransformType::ScalarType,
+                                                    TMattesMutualInformationMetric::MovingImageDimension,
+                                                    3>;
+
 protected:
   MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_MattesAssociate(nullptr)
@@ -120,10 +127,23 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Add derivativeFactor times the contribution of a sample to the metric
+   * derivative, its moving image gradient times the Jacobian of the moving
+   * transform, to the local derivatives of the work unit, when
+   * UseExplicitPDFDerivatives is off. */
+  void
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType              derivativeFactor,
+                                const ThreadIdType              threadId) const;
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate{};
+
+  /** The moving transform, when it is a B-spline transform. */
+  const BSplineTransformType * m_MovingBSplineTransform{};
 };
 
 } // end namespace itk
@@ -18,6 +18,7 @@
 #ifndef itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -44,6 +45,19 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionMacro("Dynamic casting of associate pointer failed.");
   }
 
+  if (this->m_MattesAssociate->m_ComputingImplicitPDFDerivatives && this->m_MattesAssociate->GetComputeDerivative())
+  {
+    /* The second pass of UseExplicitPDFDerivatives off only accumulates the
+     * derivative, in the local derivatives of each work unit. */
+    this->m_MovingBSplineTransform =
+      dynamic_cast<const BSplineTransformType *>(this->m_MattesAssociate->GetMovingTransform());
+    for (ThreadIdType workUnitID = 0; workUnitID < this->GetNumberOfWorkUnitsUsed(); ++workUnitID)
+    {
+      this->m_GetValueAndDerivativePerThreadVariables[workUnitID].LocalDerivatives.Fill(DerivativeValueType{});
+    }
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -134,6 +148,14 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+    if (this->m_MattesAssociate->m_ComputingImplicitPDFDerivatives)
+    {
+      // Except the pRatio of the first pass of UseExplicitPDFDerivatives off,
+      // which stays zero at the bins that do not contribute.
+      this->m_MattesAssociate->m_PRatioArray.assign(
+        this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+      this->m_MattesAssociate->m_ThreaderDerivativeManager.clear();
+    }
   }
 
   if (this->m_MattesAssociate->GetComputeDerivative() && this->m_MattesAssociate->HasLocalSupport())
@@ -269,6 +291,28 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
+  if (this->m_MattesAssociate->m_ComputingImplicitPDFDerivatives && doComputeDerivative)
+  {
+    // The second pass of UseExplicitPDFDerivatives off: the derivative of the
+    // Parzen window of the sample, weighted by the pRatio of its bins.
+    const PDFValueType * pRatioPtr = this->m_MattesAssociate->m_PRatioArray.data() +
+                                     (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) +
+                                     pdfMovingIndex;
+    PDFValueType movingImageParzenWindowArg =
+      static_cast<PDFValueType>(pdfMovingIndex) - static_cast<PDFValueType>(movingImageParzenWindowTerm);
+    PDFValueType derivativeFactor = 0.0;
+    for (; pdfMovingIndex <= pdfMovingIndexMax; ++pdfMovingIndex, ++pRatioPtr)
+    {
+      derivativeFactor += *pRatioPtr * CubicBSplineDerivativeFunctionType::FastEvaluate(movingImageParzenWindowArg);
+      movingImageParzenWindowArg += 1.0;
+    }
+    if (derivativeFactor != 0.0)
+    {
+      this->ComputeImplicitPDFDerivatives(virtualPoint, movingImageGradient, derivativeFactor, threadId);
+    }
+    return false;
+  }
+
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -410,6 +454,63 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType              derivativeFactor,
+                                const ThreadIdType              threadId) const
+{
+  DerivativeValueType * const localDerivatives =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives.data_block();
+
+  if (this->m_MovingBSplineTransform)
+  {
+    // The Jacobian is only nonzero at the parameters of the support region,
+    // where it is the B-spline weights.
+    typename BSplineTransformType::InputPointType          point;
+    typename BSplineTransformType::OutputPointType         mappedPoint;
+    typename BSplineTransformType::WeightsType             weights;
+    typename BSplineTransformType::ParameterIndexArrayType indices;
+    bool                                                   inside;
+    point.CastFrom(virtualPoint);
+    this->m_MovingBSplineTransform->TransformPoint(point, mappedPoint, weights, indices, inside);
+    if (inside)
+    {
+      const SizeValueType numberOfParametersPerDimension =
+        this->m_MovingBSplineTransform->GetNumberOfParametersPerDimension();
+      for (SizeValueType dim = 0; dim < TMattesMutualInformationMetric::MovingImageDimension; ++dim)
+      {
+        const PDFValueType    factor = derivativeFactor * movingImageGradient[dim];
+        DerivativeValueType * dimensionDerivatives = localDerivatives + dim * numberOfParametersPerDimension;
+        for (unsigned int k = 0; k < BSplineTransformType::NumberOfWeights; ++k)
+        {
+          dimensionDerivatives[indices[k]] += factor * weights[k];
+        }
+      }
+    }
+    return;
+  }
+
+  JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  JacobianType & jacobianPositional =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+    virtualPoint, jacobian, jacobianPositional);
+  for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement; ++mu)
+  {
+    PDFValueType innerProduct = 0.0;
+    for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+    {
+      innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+    }
+    localDerivatives[mu] += derivativeFactor * innerProduct;
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -418,6 +519,33 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   TMattesMutualInformationMetric>::AfterThreadedExecution()
 {
   const ThreadIdType localNumberOfWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
+
+  if (this->m_MattesAssociate->m_ComputingImplicitPDFDerivatives && this->m_MattesAssociate->GetComputeDerivative())
+  {
+    /* The second pass of UseExplicitPDFDerivatives off: sum the local
+     * derivatives of the work units, in parallel over blocks of parameters.
+     * The pRatio are scaled so that the derivative is their opposite. */
+    constexpr NumberOfParametersType blockSize = 4096;
+    const NumberOfParametersType     numberOfParameters = this->GetCachedNumberOfLocalParameters();
+    DerivativeValueType * const      derivative = this->m_MattesAssociate->m_DerivativeResult->data_block();
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      (numberOfParameters + blockSize - 1) / blockSize,
+      [this, derivative, numberOfParameters, localNumberOfWorkUnitsUsed](SizeValueType block) {
+        const NumberOfParametersType end = std::min<NumberOfParametersType>(numberOfParameters, (block + 1) * blockSize);
+        for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+        {
+          const DerivativeValueType * const localDerivatives =
+            this->m_GetValueAndDerivativePerThreadVariables[workUnitID].LocalDerivatives.data_block();
+          for (NumberOfParametersType p = block * blockSize; p < end; ++p)
+          {
+            derivative[p] -= localDerivatives[p];
+          }
+        }
+      },
+      nullptr);
+    return;
+  }
   /* Store the number of valid points in the enclosing class
    * m_NumberOfValidPoints by collecting the valid points per thread.
    * We do this here because we're skipping Superclass::AfterThreadedExecution*/
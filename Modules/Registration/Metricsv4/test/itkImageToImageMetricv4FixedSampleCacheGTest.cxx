@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkTranslationTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkGTest.h"
+
+#include <cmath>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+ImageType::Pointer
+MakeImage(double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 50, 40 } });
+  image->SetOrigin(itk::MakePoint(-3.0, 2.0));
+  image->SetSpacing(itk::MakeVector(1.5, 2.0));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 24.0 - shift;
+    const double y = it.GetIndex()[1] - 18.0 + 0.5 * shift;
+    it.Set(static_cast<float>(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0) + 0.5 * it.GetIndex()[1]));
+  }
+  return image;
+}
+
+MetricType::Pointer
+MakeMetric(bool useSampledPointSet, bool useFixedSampleCache)
+{
+  auto metric = MetricType::New();
+  metric->SetFixedImage(MakeImage(0.0));
+  metric->SetMovingImage(MakeImage(2.0));
+  metric->SetGradientSource(itk::ObjectToObjectMetricBaseTemplateEnums::GradientSource::GRADIENT_SOURCE_BOTH);
+
+  auto movingTransform = itk::AffineTransform<double, 2>::New();
+  movingTransform->SetCenter(itk::MakePoint(30.0, 40.0));
+  movingTransform->Rotate2D(0.05);
+  metric->SetMovingTransform(movingTransform);
+  metric->SetFixedTransform(itk::TranslationTransform<double, 2>::New());
+
+  if (useSampledPointSet)
+  {
+    auto points = MetricType::FixedSampledPointSetType::New();
+    for (unsigned int i = 0; i < 700; ++i)
+    {
+      points->SetPoint(i, itk::MakePoint(-4.0 + 0.11 * ((i * 61) % 700), 1.0 + 0.12 * ((i * 17) % 700)));
+    }
+    metric->SetFixedSampledPointSet(points);
+    metric->SetUseSampledPointSet(true);
+  }
+  metric->SetUseFixedSampleCache(useFixedSampleCache);
+  metric->Initialize();
+  return metric;
+}
+
+// Checks that the metric evaluates as without the cache, as the moving and
+// the fixed transforms change.
+void
+ExpectSameEvaluationWithFixedSampleCache(bool useSampledPointSet)
+{
+  const auto metric = MakeMetric(useSampledPointSet, false);
+  const auto cachingMetric = MakeMetric(useSampledPointSet, true);
+  EXPECT_TRUE(cachingMetric->GetUseFixedSampleCache());
+
+  const auto expectSameEvaluation = [&metric, &cachingMetric](const char * message) {
+    SCOPED_TRACE(message);
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+    MetricType::MeasureType    cachingValue;
+    MetricType::DerivativeType cachingDerivative;
+    cachingMetric->GetValueAndDerivative(cachingValue, cachingDerivative);
+    EXPECT_EQ(cachingValue, value);
+    EXPECT_EQ(cachingDerivative, derivative);
+    EXPECT_EQ(cachingMetric->GetNumberOfValidPoints(), metric->GetNumberOfValidPoints());
+    EXPECT_EQ(cachingMetric->GetValue(), metric->GetValue());
+  };
+  expectSameEvaluation("initial transforms");
+
+  MetricType::ParametersType parameters = metric->GetParameters();
+  parameters[4] += 1.5;
+  parameters[5] -= 0.5;
+  metric->SetParameters(parameters);
+  cachingMetric->SetParameters(parameters);
+  expectSameEvaluation("moving transform modified");
+
+  const auto fixedTranslation = itk::MakeVector(0.7, -1.2);
+  dynamic_cast<itk::TranslationTransform<double, 2> *>(metric->GetModifiableFixedTransform())
+    ->Translate(fixedTranslation);
+  dynamic_cast<itk::TranslationTransform<double, 2> *>(cachingMetric->GetModifiableFixedTransform())
+    ->Translate(fixedTranslation);
+  expectSameEvaluation("fixed transform modified");
+}
+} // namespace
+
+
+TEST(ImageToImageMetricv4, FixedSampleCacheOfDenseSampling)
+{
+  ExpectSameEvaluationWithFixedSampleCache(false);
+}
+
+
+TEST(ImageToImageMetricv4, FixedSampleCacheOfSparseSampling)
+{
+  ExpectSameEvaluationWithFixedSampleCache(true);
+}
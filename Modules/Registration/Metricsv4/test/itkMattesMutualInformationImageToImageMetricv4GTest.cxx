@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkGTest.h"
+
+#include <cmath>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+// A blob, and a ramp that is not symmetric around it.
+ImageType::Pointer
+MakeImage(double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48 } });
+  image->SetSpacing(itk::MakeVector(1.5, 2.0));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 30.0 - shift;
+    const double y = it.GetIndex()[1] - 22.0 + 0.5 * shift;
+    it.Set(static_cast<float>(200.0 * std::exp(-(x * x + 2.0 * y * y) / 300.0) + 0.3 * it.GetIndex()[0]));
+  }
+  return image;
+}
+
+// Checks that the value and the derivative are those of the explicit PDF
+// derivatives when UseExplicitPDFDerivatives is off.
+void
+ExpectImplicitAsExplicitPDFDerivatives(MetricType & metric)
+{
+  metric.SetFixedImage(MakeImage(0.0));
+  metric.SetMovingImage(MakeImage(3.0));
+  metric.SetNumberOfHistogramBins(32);
+  metric.Initialize();
+
+  MetricType::MeasureType    explicitValue;
+  MetricType::DerivativeType explicitDerivative;
+  EXPECT_TRUE(metric.GetUseExplicitPDFDerivatives());
+  metric.GetValueAndDerivative(explicitValue, explicitDerivative);
+
+  MetricType::MeasureType    implicitValue;
+  MetricType::DerivativeType implicitDerivative;
+  metric.UseExplicitPDFDerivativesOff();
+  metric.GetValueAndDerivative(implicitValue, implicitDerivative);
+
+  EXPECT_EQ(implicitValue, explicitValue);
+  EXPECT_EQ(metric.GetValue(), explicitValue);
+  ASSERT_EQ(implicitDerivative.size(), explicitDerivative.size());
+  double derivativeMagnitude = 0.0;
+  for (const double value : explicitDerivative)
+  {
+    derivativeMagnitude = std::max(derivativeMagnitude, std::abs(value));
+  }
+  EXPECT_GT(derivativeMagnitude, 0.0);
+  for (unsigned int i = 0; i < explicitDerivative.size(); ++i)
+  {
+    EXPECT_NEAR(implicitDerivative[i], explicitDerivative[i], 1e-10 * derivativeMagnitude) << "parameter " << i;
+  }
+
+  // The explicit PDF derivatives are computed again when switched back on.
+  metric.UseExplicitPDFDerivativesOn();
+  MetricType::DerivativeType derivative;
+  metric.GetDerivative(derivative);
+  ITK_EXPECT_VECTOR_NEAR(derivative, explicitDerivative, 1e-12 * derivativeMagnitude);
+}
+
+itk::AffineTransform<double, 2>::Pointer
+MakeAffineTransform()
+{
+  auto transform = itk::AffineTransform<double, 2>::New();
+  transform->SetCenter(itk::MakePoint(45.0, 44.0));
+  transform->Rotate2D(0.05);
+  transform->Translate(itk::MakeVector(2.0, -1.0));
+  return transform;
+}
+} // namespace
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ImplicitPDFDerivativesOfAffineTransform)
+{
+  auto metric = MetricType::New();
+  metric->SetMovingTransform(MakeAffineTransform());
+  ExpectImplicitAsExplicitPDFDerivatives(*metric);
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ImplicitPDFDerivativesOfBSplineTransform)
+{
+  using TransformType = itk::BSplineTransform<double, 2, 3>;
+  auto transform = TransformType::New();
+  transform->SetTransformDomainOrigin(itk::MakePoint(-1.0, -1.0));
+  transform->SetTransformDomainPhysicalDimensions(itk::MakeVector(98.0, 98.0));
+  transform->SetTransformDomainMeshSize(itk::MakeFilled<TransformType::MeshSizeType>(6));
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.05 * ((i * 37) % 41) - 1.0;
+  }
+  transform->SetParametersByValue(parameters);
+
+  auto metric = MetricType::New();
+  metric->SetMovingTransform(transform);
+  ExpectImplicitAsExplicitPDFDerivatives(*metric);
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ImplicitPDFDerivativesOfSampledPoints)
+{
+  auto points = MetricType::FixedSampledPointSetType::New();
+  for (unsigned int i = 0; i < 1000; ++i)
+  {
+    points->SetPoint(i, itk::MakePoint(0.09 * ((i * 61) % 1000), 0.09 * ((i * 17) % 1000)));
+  }
+
+  auto metric = MetricType::New();
+  metric->SetMovingTransform(MakeAffineTransform());
+  metric->SetFixedSampledPointSet(points);
+  metric->SetUseSampledPointSet(true);
+  ExpectImplicitAsExplicitPDFDerivatives(*metric);
+}